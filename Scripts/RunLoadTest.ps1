@@ -0,0 +1,72 @@
+# Local load test: one SlashServer plus N headless bot clients on this machine.
+# The server writes Saved/LoadTest/SlashLoadTest_<time>.csv (tick time, bandwidth, memory per interval) and exits.
+#
+#   .\Scripts\RunLoadTest.ps1 -Bots 16 -Seconds 600
+#   .\Scripts\RunLoadTest.ps1 -Bots 4 -PktLag 100 -PktLoss 5   (bots log "Prediction - ..." rollback and confirm times)
+#   .\Scripts\RunLoadTest.ps1 -Bots 8 -ServerExecCmds "Slash.Bench.SpawnEnemies 300 /Game/Blueprints/Enemy/Paladin/BP_Paladin.BP_Paladin_C 600"
+#       (server log "Enemy net - ..." gives movement bytes per enemy per second, the report the server time)
+#   .\Scripts\RunLoadTest.ps1 -Bots 4 -DebugDump   (server also writes Saved/DebugDraw/SlashDebugDraw_<time>.csv with the last recorded traces and AI decisions)
+#
+# Build the SlashServer and Slash (Development) targets first, or point -ServerExe/-ClientExe at a packaged build.
+
+param(
+	[int]$Bots = 16,
+	[int]$Seconds = 300,
+	[int]$Port = 7777,
+	[int]$ReportInterval = 5,
+	[int]$PktLag = 0,
+	[int]$PktLoss = 0,
+	[string]$ServerExecCmds = "",
+	[switch]$DebugDump,
+	[string]$Map = "/Game/Maps/SlashOpenWorld",
+	[string]$ServerExe = "$PSScriptRoot\..\Binaries\Win64\SlashServer.exe",
+	[string]$ClientExe = "$PSScriptRoot\..\Binaries\Win64\Slash.exe"
+)
+
+$ErrorActionPreference = "Stop"
+$Project = (Resolve-Path "$PSScriptRoot\..\Slash.uproject").Path
+$LogDir = "$PSScriptRoot\..\Saved\LoadTest"
+New-Item -ItemType Directory -Force -Path $LogDir | Out-Null
+
+Write-Host "Starting server on port $Port for $Seconds s"
+$ServerArgs = @(
+	"`"$Project`"", $Map, "-port=$Port", "-log", "-unattended",
+	"-SlashLoadReport", "-SlashLoadTestSeconds=$Seconds",
+	"-ini:Engine:[SystemSettings]:Slash.Net.ReportInterval=$ReportInterval",
+	"-abslog=`"$LogDir\Server.log`""
+)
+if ($DebugDump) { $ServerArgs += "-ini:Engine:[SystemSettings]:Slash.Debug.DumpOnExit=1" }
+if ($ServerExecCmds -ne "") { $ServerArgs += "-ExecCmds=`"$ServerExecCmds`"" }
+$Server = Start-Process -FilePath $ServerExe -PassThru -ArgumentList $ServerArgs
+
+# Give the server time to load the map before the bots connect
+Start-Sleep -Seconds 15
+
+$Clients = @()
+for ($i = 0; $i -lt $Bots; $i++)
+{
+	$Clients += Start-Process -FilePath $ClientExe -PassThru -ArgumentList @(
+		"`"$Project`"", "127.0.0.1:$Port", "-game", "-nullrhi", "-nosound", "-unattended",
+		"-SlashBot", "-SlashBotSeed=$i", "-PktLag=$PktLag", "-PktLoss=$PktLoss", "-abslog=`"$LogDir\Bot$i.log`""
+	)
+}
+Write-Host "Started $Bots bots"
+
+$Server.WaitForExit()
+foreach ($Client in $Clients)
+{
+	if (-not $Client.HasExited) { Stop-Process -Id $Client.Id -Force }
+}
+
+$Report = Get-ChildItem "$LogDir\SlashLoadTest_*.csv" -ErrorAction SilentlyContinue | Sort-Object LastWriteTime | Select-Object -Last 1
+if ($Report -eq $null)
+{
+	Write-Error "No report was written, see $LogDir\Server.log"
+}
+
+$Rows = Import-Csv $Report.FullName
+Write-Host "Report: $($Report.FullName)"
+Write-Host ("Clients peak {0}" -f ($Rows | Measure-Object Clients -Maximum).Maximum)
+Write-Host ("Server busy avg {0:N2} ms, max {1:N2} ms" -f ($Rows | Measure-Object BusyAvgMs -Average).Average, ($Rows | Measure-Object BusyMaxMs -Maximum).Maximum)
+Write-Host ("Out {0:N1} KB/s avg, {1:N2} KB/s per client" -f ($Rows | Measure-Object OutKBps -Average).Average, ($Rows | Measure-Object OutKBpsPerClient -Average).Average)
+Write-Host ("Memory peak {0:N1} MB" -f ($Rows | Measure-Object MemoryMB -Maximum).Maximum)
@@ -11,5 +11,8 @@ public class SlashTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 
 		ExtraModuleNames.AddRange( new string[] { "Slash" } );
+
+		// Gameplay replication is push based (see MARK_PROPERTY_DIRTY_FROM_NAME)
+		bWithPushModel = true;
 	}
 }
@@ -0,0 +1,1127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+/**
+ * Console commands used to set up headless benchmark scenes (e.g. -nullrhi with -ExecCmds).
+ * Measure with 'stat Slash' together with the relevant engine stat group, or a csvprofile capture.
+ */
+
+#include "EngineUtils.h"
+#include "Animation/AnimInstance.h"
+#include "Breakable/BreakableActor.h"
+#include "Breakable/FracturedBreakable.h"
+#include "Characters/BaseCharacter.h"
+#include "Enemy/Enemy.h"
+#include "Enemy/EnemyAttackDirectorSubsystem.h"
+#include "Enemy/EnemySpatialIndexSubsystem.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GeometryCollection/GeometryCollectionComponent.h"
+#include "HUD/EnemyHealthBarLayer.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Items/Item.h"
+#include "Items/Weapons/Weapon.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Sound/SoundBase.h"
+#include "Components/AudioComponent.h"
+#include "Containers/Ticker.h"
+#include "UObject/StrongObjectPtr.h"
+#include "Items/PickupProximitySubsystem.h"
+#include "Items/PickupSubsystem.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Components/Widget.h"
+#include "Slash/Slash.h"
+#include "Components/AttributeComponent.h"
+#include "Components/LockOnComponent.h"
+#include "Components/SlashAttributeSet.h"
+#include "Components/StatusEffectSubsystem.h"
+#include "Components/SphereComponent.h"
+#include "Net/SlashRewindSubsystem.h"
+#include "World/SlashAssetPreloadSubsystem.h"
+#include "World/SlashCheckpointSubsystem.h"
+#include "World/SlashFeedbackSubsystem.h"
+#include "World/SlashSaveSubsystem.h"
+#include "World/SlashWorldStateSubsystem.h"
+
+#if !UE_BUILD_SHIPPING
+
+namespace SlashBenchmark
+{
+	/** Records a CSV profile (frame time, Chaos solver timings, Slash custom stats) for the given duration. */
+	static void CaptureCsvFor(UWorld* World, float Seconds)
+	{
+#if CSV_PROFILER
+		FCsvProfiler::Get()->BeginCapture();
+		FTimerHandle StopHandle;
+		World->GetTimerManager().SetTimer(StopHandle, FTimerDelegate::CreateLambda([]()
+		{
+			FCsvProfiler::Get()->EndCapture();
+			UE_LOG(LogSlash, Log, TEXT("Slash.Bench - CSV capture finished (Saved/Profiling/CSV)"));
+		}), Seconds, false);
+#else
+		UE_LOG(LogSlash, Warning, TEXT("Slash.Bench - CSV profiler not compiled in, no capture recorded"));
+#endif
+	}
+
+	static FVector GetOrigin(UWorld* World)
+	{
+		if (APlayerController* PlayerController = World->GetFirstPlayerController())
+		{
+			if (APawn* Pawn = PlayerController->GetPawn())
+			{
+				return Pawn->GetActorLocation();
+			}
+		}
+		return FVector::ZeroVector;
+	}
+
+	/** Location of the Index-th cell of a square grid centered on Origin. */
+	static FVector GetGridLocation(const FVector& Origin, int32 Index, int32 Count, float Spacing)
+	{
+		const int32 Side = FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(static_cast<float>(Count))));
+		const float HalfExtent = (Side - 1) * Spacing * 0.5f;
+		return Origin + FVector((Index % Side) * Spacing - HalfExtent, (Index / Side) * Spacing - HalfExtent, 0.f);
+	}
+
+	/** Spawns Count actors of ActorClass on a grid and logs spawn time and physical memory delta. */
+	static void SpawnGrid(UWorld* World, UClass* ActorClass, int32 Count, float Spacing, TFunctionRef<void(AActor*)> OnSpawned)
+	{
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		const FVector Origin = GetOrigin(World);
+		const uint64  StartMemory = FPlatformMemory::GetStats().UsedPhysical;
+		const double  StartTime = FPlatformTime::Seconds();
+		int32         Spawned = 0;
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FVector Location = GetGridLocation(Origin, Index, Count, Spacing);
+			if (AActor* Actor = World->SpawnActor<AActor>(ActorClass, Location, FRotator::ZeroRotator, Params))
+			{
+				OnSpawned(Actor);
+				++Spawned;
+			}
+		}
+
+		const double  ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		const int64   MemoryDelta = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(StartMemory);
+		UE_LOG(LogSlash, Log, TEXT("Slash.Bench - spawned %d x %s in %.2f ms (%.3f ms each), physical memory %+.2f MB (%+.1f KB each)"),
+			Spawned, *ActorClass->GetName(), ElapsedMs, Spawned > 0 ? ElapsedMs / Spawned : 0.0,
+			MemoryDelta / (1024.0 * 1024.0), Spawned > 0 ? MemoryDelta / 1024.0 / Spawned : 0.0);
+	}
+
+	static void SpawnEnemies(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || Args.Num() < 2)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.SpawnEnemies <Count> <EnemyClassPath> [Spacing]"));
+			return;
+		}
+
+		UClass* EnemyClass = LoadClass<AEnemy>(nullptr, *Args[1]);
+		if (EnemyClass == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Slash.Bench.SpawnEnemies - could not load class %s"), *Args[1]);
+			return;
+		}
+
+		const float Spacing = Args.IsValidIndex(2) ? FCString::Atof(*Args[2]) : 300.f;
+		SpawnGrid(World, EnemyClass, FCString::Atoi(*Args[0]), Spacing, [](AActor* Actor)
+		{
+			CastChecked<APawn>(Actor)->SpawnDefaultController();
+		});
+	}
+
+	static void SpawnBreakables(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || Args.Num() < 2)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.SpawnBreakables <Count> <BreakableClassPath> [Spacing]"));
+			return;
+		}
+
+		UClass* BreakableClass = LoadClass<ABreakableActor>(nullptr, *Args[1]);
+		if (BreakableClass == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Slash.Bench.SpawnBreakables - could not load class %s"), *Args[1]);
+			return;
+		}
+
+		const float Spacing = Args.IsValidIndex(2) ? FCString::Atof(*Args[2]) : 150.f;
+		SpawnGrid(World, BreakableClass, FCString::Atoi(*Args[0]), Spacing, [](AActor* Actor) {});
+	}
+
+	/**
+	 * Server: drops Count pickups around the player, as entries of UPickupSubsystem or, with "actors", as one
+	 * replicated actor each like before, then logs open actor channels and outgoing bandwidth 5 seconds later.
+	 */
+	static void PickupDrops(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || Args.Num() < 2)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.PickupDrops <Count> <ItemClassPath> [actors]"));
+			return;
+		}
+
+		UClass* ItemClass = LoadClass<AItem>(nullptr, *Args[1]);
+		UPickupSubsystem* Pickups = World->GetSubsystem<UPickupSubsystem>();
+		if (ItemClass == nullptr || Pickups == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Slash.Bench.PickupDrops - could not load class %s"), *Args[1]);
+			return;
+		}
+
+		const int32 Count = FCString::Atoi(*Args[0]);
+		const bool  bAsActors = Args.IsValidIndex(2) && Args[2] == TEXT("actors");
+		if (bAsActors)
+		{
+			SpawnGrid(World, ItemClass, Count, 100.f, [](AActor* Actor) {});
+		}
+		else
+		{
+			const FVector Origin = GetOrigin(World);
+			for (int32 Index = 0; Index < Count; ++Index)
+			{
+				Pickups->SpawnPickup(ItemClass, GetGridLocation(Origin, Index, Count, 100.f), 1);
+			}
+		}
+
+		FTimerHandle ReportHandle;
+		World->GetTimerManager().SetTimer(ReportHandle, FTimerDelegate::CreateWeakLambda(Pickups, [Pickups, Count, bAsActors]()
+		{
+			const UNetDriver* NetDriver = Pickups->GetWorld()->GetNetDriver();
+			int32 NumChannels = 0;
+			int32 NumConnections = 0;
+			if (NetDriver)
+			{
+				for (const UNetConnection* Connection : NetDriver->ClientConnections)
+				{
+					NumChannels += Connection->OpenChannels.Num();
+					++NumConnections;
+				}
+			}
+			UE_LOG(LogSlash, Log, TEXT("Slash.Bench.PickupDrops - %d drops as %s: %d cells, %d visuals, %d open channels over %d connections, out %.1f KB/s"),
+				Count, bAsActors ? TEXT("actors") : TEXT("entries"), Pickups->GetNumCells(), Pickups->GetNumVisuals(), NumChannels, NumConnections,
+				NetDriver ? NetDriver->OutBytesPerSecond / 1024.f : 0.f);
+		}), 5.f, false);
+	}
+
+	static void BreakPots(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || Args.Num() < 2)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.BreakPots <Count> <BreakableClassPath> [Seconds]"));
+			return;
+		}
+
+		UClass* BreakableClass = LoadClass<ABreakableActor>(nullptr, *Args[1]);
+		if (BreakableClass == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Slash.Bench.BreakPots - could not load class %s"), *Args[1]);
+			return;
+		}
+
+		TArray<AActor*> Breakables;
+		SpawnGrid(World, BreakableClass, FCString::Atoi(*Args[0]), 150.f, [&Breakables](AActor* Actor)
+		{
+			Breakables.Add(Actor);
+		});
+
+		for (AActor* Breakable : Breakables)
+		{
+			IHitInterface::Execute_GetHit(Breakable, Breakable->GetActorLocation(), nullptr);
+		}
+
+		// No weapon fields here, so crumble every activated collection directly
+		for (TActorIterator<AFracturedBreakable> It(World); It; ++It)
+		{
+			if (!It->IsHidden())
+			{
+				It->GetGeometryCollection()->CrumbleActiveClusters();
+			}
+		}
+
+		CaptureCsvFor(World, Args.IsValidIndex(2) ? FCString::Atof(*Args[2]) : 60.f);
+	}
+
+	static double ElapsedMs(double StartTime)
+	{
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+
+	/** Synchronous save -> load -> save of the current state; passes if both snapshots are byte identical. */
+	static void SaveRoundTrip(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World == nullptr || World->GetGameInstance() == nullptr)
+			return;
+
+		USlashSaveSubsystem*       Save = World->GetGameInstance()->GetSubsystem<USlashSaveSubsystem>();
+		USlashWorldStateSubsystem* WorldState = World->GetSubsystem<USlashWorldStateSubsystem>();
+		const int32                NumCells = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 0;
+		const int32                ActorsPerCell = Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 64;
+		WorldState->SetBenchmarkCells(NumCells, ActorsPerCell);
+
+		double        StartTime = FPlatformTime::Seconds();
+		TArray<uint8> Payload;
+		const bool    bSnapshot = Save->BuildSnapshot(Payload);
+		const double  SnapshotMs = ElapsedMs(StartTime);
+
+		StartTime = FPlatformTime::Seconds();
+		TArray<uint8> FileData;
+		const bool    bCompressed = bSnapshot && USlashSaveSubsystem::CompressPayload(Payload, FileData);
+		const double  CompressMs = ElapsedMs(StartTime);
+
+		StartTime = FPlatformTime::Seconds();
+		const FString Path = USlashSaveSubsystem::GetSlotPath(TEXT("BenchRoundTrip"));
+		const bool    bWritten = bCompressed && FFileHelper::SaveArrayToFile(FileData, *Path);
+		const double  WriteMs = ElapsedMs(StartTime);
+
+		StartTime = FPlatformTime::Seconds();
+		TArray<uint8> ReadData;
+		TArray<uint8> LoadedPayload;
+		int32         Version = 0;
+		const bool    bRead = bWritten && FFileHelper::LoadFileToArray(ReadData, *Path) && USlashSaveSubsystem::DecompressPayload(ReadData, LoadedPayload, Version);
+		const double  ReadMs = ElapsedMs(StartTime);
+
+		StartTime = FPlatformTime::Seconds();
+		const bool   bApplied = bRead && Save->ApplySnapshot(LoadedPayload, Version);
+		const double ApplyMs = ElapsedMs(StartTime);
+
+		TArray<uint8> RoundTripPayload;
+		const bool    bPassed = bApplied && Save->BuildSnapshot(RoundTripPayload) && RoundTripPayload == Payload;
+
+		UE_LOG(LogSlash, Log, TEXT("Slash.Bench.SaveRoundTrip %s - %d cells x %d actors, %d -> %d bytes, snapshot %.3f ms, compress %.3f ms, write %.3f ms, read %.3f ms, apply %.3f ms"),
+			bPassed ? TEXT("PASSED") : TEXT("FAILED"), NumCells, ActorsPerCell, Payload.Num(), FileData.Num(),
+			SnapshotMs, CompressMs, WriteMs, ReadMs, ApplyMs);
+
+		WorldState->SetBenchmarkCells(0, 0);
+		IFileManager::Get().Delete(*Path);
+	}
+
+	/** Capture, kill enemies / break breakables / move the player, restore, capture again and compare. */
+	static void CheckpointRoundTrip(const TArray<FString>& Args, UWorld* World)
+	{
+		USlashCheckpointSubsystem* Checkpoint = World ? World->GetSubsystem<USlashCheckpointSubsystem>() : nullptr;
+		if (Checkpoint == nullptr)
+			return;
+
+		Checkpoint->CaptureCheckpoint();
+		const FSlashCheckpoint Before = Checkpoint->GetCheckpoint();
+
+		const int32 NumToChange = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 10;
+		int32       NumKilled = 0;
+		for (TActorIterator<AEnemy> It(World); It && NumKilled < NumToChange; ++It)
+		{
+			if (It->GetEnemyState() != EEnemyState::EES_Dead && It->GetAttributes())
+			{
+				It->GetAttributes()->ReceiveDamage(TNumericLimits<float>::Max());
+				IHitInterface::Execute_GetHit(*It, It->GetActorLocation(), nullptr);
+				++NumKilled;
+			}
+		}
+
+		int32 NumBroken = 0;
+		for (TActorIterator<ABreakableActor> It(World); It && NumBroken < NumToChange; ++It)
+		{
+			if (!It->IsBroken())
+			{
+				IHitInterface::Execute_GetHit(*It, It->GetActorLocation(), nullptr);
+				++NumBroken;
+			}
+		}
+
+		if (APlayerController* PlayerController = World->GetFirstPlayerController())
+		{
+			if (APawn* Pawn = PlayerController->GetPawn())
+			{
+				Pawn->AddActorWorldOffset(FVector(500.f, 0.f, 0.f));
+			}
+		}
+
+		const double StartTime = FPlatformTime::Seconds();
+		Checkpoint->RestoreCheckpoint();
+		const double RestoreMs = ElapsedMs(StartTime);
+
+		Checkpoint->CaptureCheckpoint();
+		const FSlashCheckpoint& After = Checkpoint->GetCheckpoint();
+		const bool bPassed = Before.Data == After.Data && Before.Enemies == After.Enemies && Before.Breakables.Num() == After.Breakables.Num() && Before.Items.Num() == After.Items.Num();
+
+		UE_LOG(LogSlash, Log, TEXT("Slash.Bench.CheckpointRoundTrip %s - killed %d, broke %d, restore %.3f ms, %d bytes"),
+			bPassed ? TEXT("PASSED") : TEXT("FAILED"), NumKilled, NumBroken, RestoreMs, Before.Data.Num());
+	}
+
+	/**
+	 * Simulates claims made LatencyMs ago against every registered character: a trace through where the
+	 * character was (must pass) and one a few radii beside it (must fail), with and without rewinding.
+	 * Then a client LatencyMs behind smooths the recorded history like AEnemy::SmoothNetMovement and claims
+	 * through the pose it shows, stamped like ClaimHit does (must pass) and with the current server time.
+	 */
+	static void RewindValidation(const TArray<FString>& Args, UWorld* World)
+	{
+		USlashRewindSubsystem* Rewind = World ? World->GetSubsystem<USlashRewindSubsystem>() : nullptr;
+		if (Rewind == nullptr)
+			return;
+
+		const double LatencySeconds = (Args.IsValidIndex(0) ? FCString::Atof(*Args[0]) : 150.f) / 1000.0;
+		const double Now = World->GetTimeSeconds();
+		const double ClaimTime = Now - LatencySeconds;
+
+		// The client sees the server's history half a round trip late and its claim arrives half a round trip later
+		const float  SmoothingDelay = GetDefault<AEnemy>()->GetNetSmoothingDelay();
+		const double DisplayedTime = Now - LatencySeconds - SmoothingDelay;
+		const double ClientServerTime = Now - LatencySeconds * 0.5;
+		const double FrameSeconds = 1.0 / 60.0;
+
+		int32  NumClaims = 0;
+		int32  NumAccepted = 0;
+		int32  NumFalseAccepts = 0;
+		int32  NumNaiveRejected = 0;
+		int32  NumLagAccepted = 0;
+		int32  NumLagCurrentTimeRejected = 0;
+		double ValidateSeconds = 0.0;
+		for (TActorIterator<ABaseCharacter> It(World); It; ++It)
+		{
+			FVector Center;
+			if (!Rewind->GetHistoricalLocation(*It, ClaimTime, Center))
+				continue;
+
+			float Radius = 0.f;
+			float HalfHeight = 0.f;
+			It->GetSimpleCollisionCylinder(Radius, HalfHeight);
+			const FVector Across(50.f, 0.f, 0.f);
+			const FVector Beside(0.f, Radius * 4.f, 0.f);
+
+			// Each character claims against itself, so the per attacker rate limit is not what gets measured
+			const double StartTime = FPlatformTime::Seconds();
+			NumAccepted += Rewind->ValidateHit(*It, *It, Center + Across, Center - Across, 5.f, ClaimTime);
+			NumFalseAccepts += Rewind->ValidateHit(*It, *It, Center + Across + Beside, Center - Across + Beside, 5.f, ClaimTime);
+			ValidateSeconds += FPlatformTime::Seconds() - StartTime;
+			NumNaiveRejected += !Rewind->ValidateHit(*It, *It, Center + Across, Center - Across, 5.f, Now);
+
+			// Settle the smoothing on the delayed history, then step it up to the moment of the claim
+			FVector Shown;
+			FVector Sample;
+			Rewind->GetHistoricalLocation(*It, ClaimTime - 10.0 * SmoothingDelay, Shown);
+			for (double Time = ClaimTime - 10.0 * SmoothingDelay; Time < ClaimTime; Time += FrameSeconds)
+			{
+				Rewind->GetHistoricalLocation(*It, Time, Sample);
+				Shown = FMath::Lerp(Shown, Sample, 1.0 - FMath::Exp(-FrameSeconds / SmoothingDelay));
+			}
+			NumLagAccepted += Rewind->ValidateHit(*It, *It, Shown + Across, Shown - Across, 5.f, DisplayedTime);
+			NumLagCurrentTimeRejected += !Rewind->ValidateHit(*It, *It, Shown + Across, Shown - Across, 5.f, ClientServerTime);
+			++NumClaims;
+		}
+
+		UE_LOG(LogSlash, Log, TEXT("Slash.Bench.RewindValidation %s - %d characters at %.0f ms latency: accepted %d, false accepts %d, rejected without rewind %d, %.2f us per validation; smoothed client pose accepted %d, rejected at the current server time %d"),
+			NumAccepted == NumClaims && NumFalseAccepts == 0 && NumLagAccepted == NumClaims ? TEXT("PASSED") : TEXT("FAILED"), NumClaims, LatencySeconds * 1000.0,
+			NumAccepted, NumFalseAccepts, NumNaiveRejected, NumClaims > 0 ? ValidateSeconds * 1e6 / (NumClaims * 2) : 0.0, NumLagAccepted, NumLagCurrentTimeRejected);
+	}
+
+	/**
+	 * Spawns Count items around the player and sweeps the player's capsule across them in Steps moves, first with
+	 * the proximity query (item spheres without overlaps), then with every item sphere generating overlaps again.
+	 */
+	static void PickupProximity(const TArray<FString>& Args, UWorld* World)
+	{
+		APlayerController*         PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		APawn*                     Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		UPickupProximitySubsystem* Proximity = World ? World->GetSubsystem<UPickupProximitySubsystem>() : nullptr;
+		if (Pawn == nullptr || Proximity == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.PickupProximity [Count] [Spacing] [Steps] - needs a player pawn"));
+			return;
+		}
+
+		const int32 Count = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 10000;
+		const float Spacing = Args.IsValidIndex(1) ? FCString::Atof(*Args[1]) : 100.f;
+		const int32 Steps = FMath::Max(1, Args.IsValidIndex(2) ? FCString::Atoi(*Args[2]) : 200);
+
+		TArray<AItem*> Items;
+		SpawnGrid(World, AItem::StaticClass(), Count, Spacing, [&Items](AActor* Actor)
+		{
+			Items.Add(CastChecked<AItem>(Actor));
+		});
+
+		USceneComponent* Root = Pawn->GetRootComponent();
+		const FVector    Start = Pawn->GetActorLocation();
+		const float      HalfExtent = FMath::Sqrt(static_cast<float>(Count)) * Spacing * 0.5f;
+		const FVector    Step(2.f * HalfExtent / Steps, 0.f, 0.f);
+
+		double MoveSeconds = 0.0;
+		double QuerySeconds = 0.0;
+		int32  NumTested = 0;
+		auto SweepAcross = [&](bool bQuery)
+		{
+			MoveSeconds = QuerySeconds = 0.0;
+			Root->SetWorldLocation(Start - FVector(HalfExtent, 0.f, 0.f));
+			for (int32 Index = 0; Index < Steps; ++Index)
+			{
+				double StartTime = FPlatformTime::Seconds();
+				Root->MoveComponent(Step, Root->GetComponentQuat(), true);
+				MoveSeconds += FPlatformTime::Seconds() - StartTime;
+
+				if (bQuery)
+				{
+					StartTime = FPlatformTime::Seconds();
+					NumTested += Proximity->UpdatePlayers();
+					QuerySeconds += FPlatformTime::Seconds() - StartTime;
+				}
+			}
+		};
+
+		SweepAcross(true);
+		const double ProximityMoveMs = MoveSeconds * 1000.0 / Steps;
+		const double ProximityQueryMs = QuerySeconds * 1000.0 / Steps;
+
+		for (AItem* Item : Items)
+		{
+			USphereComponent* Sphere = Item->FindComponentByClass<USphereComponent>();
+			Sphere->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+			Sphere->SetCollisionResponseToAllChannels(ECR_Overlap);
+			Sphere->SetGenerateOverlapEvents(true);
+		}
+		SweepAcross(false);
+		const double OverlapMoveMs = MoveSeconds * 1000.0 / Steps;
+
+		for (AItem* Item : Items)
+		{
+			Item->Destroy();
+		}
+		Root->SetWorldLocation(Start);
+
+		UE_LOG(LogSlash, Log, TEXT("Slash.Bench.PickupProximity - %d items, %d moves: sphere overlaps %.3f ms per move, proximity %.3f ms per move + %.3f ms per query (%.1f items tested per query)"),
+			Items.Num(), Steps, OverlapMoveMs, ProximityMoveMs, ProximityQueryMs, static_cast<double>(NumTested) / Steps);
+	}
+
+	/**
+	 * Damages Count enemies (spawn them with Slash.Bench.SpawnEnemies) and shows their health bars, then logs the
+	 * live widget count and records a CSV profile; compare 'stat Slate' and 'stat Slash' before and after.
+	 */
+	static void HealthBars(const TArray<FString>& Args, UWorld* World)
+	{
+		UEnemyHealthBarLayer* Layer = World ? UEnemyHealthBarLayer::Get(World) : nullptr;
+		if (Layer == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Slash.Bench.HealthBars - no health bar layer, needs a rendering client"));
+			return;
+		}
+
+		const int32 Count = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 200;
+		const float Seconds = Args.IsValidIndex(1) ? FCString::Atof(*Args[1]) : 10.f;
+
+		int32 NumDamaged = 0;
+		for (TActorIterator<AEnemy> It(World); It && NumDamaged < Count; ++It)
+		{
+			if (UAttributeComponent* Attributes = It->GetAttributes())
+			{
+				Attributes->ReceiveDamage(10.f);
+				Layer->ShowEnemy(*It, Attributes->GetHealthPercent());
+				++NumDamaged;
+			}
+		}
+
+		int32 NumWidgets = 0;
+		for (TObjectIterator<UWidget> It; It; ++It)
+		{
+			if (It->GetWorld() == World && !It->IsTemplate())
+			{
+				++NumWidgets;
+			}
+		}
+
+		UE_LOG(LogSlash, Log, TEXT("Slash.Bench.HealthBars - %d enemies showing a health bar, %d bars in the pool, %d UMG widgets alive"),
+			NumDamaged, Layer->GetPoolSize(), NumWidgets);
+		CaptureCsvFor(World, Seconds);
+	}
+
+	/** Lists the streamed archetype bundles; the startup numbers are logged once the first wave has loaded. */
+	static void AssetPreload(const TArray<FString>& Args, UWorld* World)
+	{
+		if (USlashAssetPreloadSubsystem* Preload = World ? World->GetSubsystem<USlashAssetPreloadSubsystem>() : nullptr)
+		{
+			Preload->Report();
+		}
+	}
+
+	/**
+	 * Plays HitsPerFrame hit sounds and effects around the player for Frames frames, through
+	 * USlashFeedbackSubsystem or with 'direct' through UGameplayStatics as before, then logs the game thread
+	 * cost and the number of components created. Run headless with -nullrhi -nosound for the stress test.
+	 */
+	static void Feedback(const TArray<FString>& Args, UWorld* World)
+	{
+		USlashFeedbackSubsystem* FeedbackSubsystem = World ? World->GetSubsystem<USlashFeedbackSubsystem>() : nullptr;
+		USoundBase*              Sound = Args.IsValidIndex(0) ? LoadObject<USoundBase>(nullptr, *Args[0]) : nullptr;
+		UParticleSystem*         Particles = Args.IsValidIndex(1) ? LoadObject<UParticleSystem>(nullptr, *Args[1]) : nullptr;
+		if (FeedbackSubsystem == nullptr || Sound == nullptr || Particles == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.Feedback <SoundPath> <ParticleSystemPath> [HitsPerFrame] [Frames] [direct]"));
+			return;
+		}
+
+		const int32 HitsPerFrame = Args.IsValidIndex(2) ? FCString::Atoi(*Args[2]) : 50;
+		const int32 NumFrames = FMath::Max(1, Args.IsValidIndex(3) ? FCString::Atoi(*Args[3]) : 300);
+		const bool  bDirect = Args.Contains(TEXT("direct"));
+
+		int32 StartComponents = 0;
+		for (TObjectIterator<USceneComponent> It; It; ++It)
+		{
+			StartComponents += It->GetWorld() == World && (It->IsA<UAudioComponent>() || It->IsA<UFXSystemComponent>());
+		}
+
+		// Kept alive for the whole run, nothing else may reference them
+		const TStrongObjectPtr<USoundBase>      SoundRef(Sound);
+		const TStrongObjectPtr<UParticleSystem> ParticlesRef(Particles);
+
+		const FVector                Origin = GetOrigin(World);
+		const TWeakObjectPtr<UWorld> WeakWorld = World;
+		TSharedRef<int32>            Frame = MakeShared<int32>(0);
+		TSharedRef<double>           Seconds = MakeShared<double>(0.0);
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=](float DeltaTime)
+		{
+			UWorld* TickWorld = WeakWorld.Get();
+			if (TickWorld == nullptr)
+				return false;
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (int32 Index = 0; Index < HitsPerFrame; ++Index)
+			{
+				const FVector Location = Origin + FVector(FMath::FRandRange(-2000.f, 2000.f), FMath::FRandRange(-2000.f, 2000.f), 0.f);
+				if (bDirect)
+				{
+					UGameplayStatics::PlaySoundAtLocation(TickWorld, SoundRef.Get(), Location);
+					UGameplayStatics::SpawnEmitterAtLocation(TickWorld, ParticlesRef.Get(), Location);
+				}
+				else
+				{
+					FeedbackSubsystem->PlaySound(SoundRef.Get(), Location);
+					FeedbackSubsystem->SpawnParticles(ParticlesRef.Get(), Location);
+				}
+			}
+			if (!bDirect)
+			{
+				FeedbackSubsystem->Dispatch();
+			}
+			*Seconds += FPlatformTime::Seconds() - StartTime;
+
+			if (++*Frame < NumFrames)
+				return true;
+
+			int32 NumComponents = 0;
+			for (TObjectIterator<USceneComponent> It; It; ++It)
+			{
+				NumComponents += It->GetWorld() == TickWorld && (It->IsA<UAudioComponent>() || It->IsA<UFXSystemComponent>());
+			}
+			UE_LOG(LogSlash, Log, TEXT("Slash.Bench.Feedback %s - %d frames x %d hits: %.3f ms game thread per frame, %d audio/effect components alive (%+d), %d created by the dispatcher"),
+				bDirect ? TEXT("direct") : TEXT("dispatcher"), NumFrames, HitsPerFrame, *Seconds * 1000.0 / NumFrames,
+				NumComponents, NumComponents - StartComponents, FeedbackSubsystem->GetNumComponents());
+			return false;
+		}));
+	}
+
+	/**
+	 * Attribute sets of Count characters: applies and removes Modifiers equipment style modifiers per character and
+	 * reads the HUD and combat values Rounds times, both from the cached values and right after a modifier change.
+	 */
+	static void Attributes(const TArray<FString>& Args, UWorld* World)
+	{
+		const int32 Count = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 1000);
+		const int32 NumModifiers = FMath::Max(1, Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 4);
+		const int32 Rounds = FMath::Max(1, Args.IsValidIndex(2) ? FCString::Atoi(*Args[2]) : 100);
+
+		TArray<FSlashAttributeSet> Sets;
+		Sets.SetNum(Count);
+		for (FSlashAttributeSet& Set : Sets)
+		{
+			Set.SetBase(ESlashAttribute::ESA_Health, 100.f);
+			Set.SetBase(ESlashAttribute::ESA_MaxHealth, 100.f);
+			Set.SetBase(ESlashAttribute::ESA_Stamina, 100.f);
+			Set.SetBase(ESlashAttribute::ESA_MaxStamina, 100.f);
+			Set.SetBase(ESlashAttribute::ESA_DodgeCost, 14.f);
+			Set.SetBase(ESlashAttribute::ESA_DamageScale, 1.f);
+			Set.ConsumeChanges();
+		}
+
+		TArray<FSlashAttributeModifierSpec> Specs;
+		for (int32 Index = 0; Index < NumModifiers; ++Index)
+		{
+			FSlashAttributeModifierSpec& Spec = Specs.AddDefaulted_GetRef();
+			Spec.Attribute = Index % 2 ? ESlashAttribute::ESA_DamageScale : ESlashAttribute::ESA_MaxHealth;
+			Spec.Op = Index % 3 ? EAttributeModifierOp::EAMO_Add : EAttributeModifierOp::EAMO_Multiply;
+			Spec.Magnitude = Spec.Op == EAttributeModifierOp::EAMO_Add ? 5.f : 1.1f;
+		}
+
+		float Checksum = 0.f;
+		auto Query = [&Sets, &Checksum]()
+		{
+			for (const FSlashAttributeSet& Set : Sets)
+			{
+				Checksum += Set.Get(ESlashAttribute::ESA_Health) / Set.Get(ESlashAttribute::ESA_MaxHealth);
+				Checksum += Set.Get(ESlashAttribute::ESA_Stamina) / Set.Get(ESlashAttribute::ESA_MaxStamina);
+				Checksum += Set.Get(ESlashAttribute::ESA_DodgeCost) + Set.Get(ESlashAttribute::ESA_DamageScale);
+			}
+		};
+		static constexpr int32 ReadsPerQuery = 6;
+
+		double ApplySeconds = 0.0;
+		double RemoveSeconds = 0.0;
+		double DirtyQuerySeconds = 0.0;
+		double CachedQuerySeconds = 0.0;
+		uint32 ChangedMask = 0;
+		for (int32 Round = 0; Round < Rounds; ++Round)
+		{
+			double StartTime = FPlatformTime::Seconds();
+			for (FSlashAttributeSet& Set : Sets)
+			{
+				Set.AddModifiers(Specs, World);
+			}
+			ApplySeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			Query();
+			DirtyQuerySeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			Query();
+			CachedQuerySeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			for (FSlashAttributeSet& Set : Sets)
+			{
+				Set.RemoveModifiers(World);
+				ChangedMask |= Set.ConsumeChanges();
+			}
+			RemoveSeconds += FPlatformTime::Seconds() - StartTime;
+		}
+
+		const double Operations = static_cast<double>(Count) * Rounds;
+		UE_LOG(LogSlash, Log, TEXT("Slash.Bench.Attributes - %d characters x %d modifiers x %d rounds: apply %.1f ns, remove %.1f ns per character; read %.2f ns cached, %.2f ns after a change (checksum %.1f, changed mask 0x%x)"),
+			Count, NumModifiers, Rounds, ApplySeconds * 1e9 / Operations, RemoveSeconds * 1e9 / Operations,
+			CachedQuerySeconds * 1e9 / (Operations * ReadsPerQuery), DirtyQuerySeconds * 1e9 / (Operations * ReadsPerQuery), Checksum, ChangedMask);
+	}
+
+	/**
+	 * Count status effects spread over every living character (spawn some with Slash.Bench.SpawnEnemies), advanced
+	 * Passes times. Logs the cost per pass against one damage event per effect, which per effect timers would cause.
+	 */
+	static void StatusEffects(const TArray<FString>& Args, UWorld* World)
+	{
+		UStatusEffectSubsystem* Effects = World ? World->GetSubsystem<UStatusEffectSubsystem>() : nullptr;
+		TArray<ABaseCharacter*> Targets;
+		if (Effects)
+		{
+			for (TActorIterator<ABaseCharacter> It(World); It; ++It)
+			{
+				if (It->HasAuthority() && It->GetAttributes() && It->GetAttributes()->IsAlive())
+				{
+					Targets.Add(*It);
+				}
+			}
+		}
+		if (Targets.Num() == 0)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.StatusEffects [Count] [Passes] - needs living characters on the server"));
+			return;
+		}
+
+		const int32 Count = Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 10000;
+		const int32 Passes = FMath::Max(1, Args.IsValidIndex(1) ? FCString::Atoi(*Args[1]) : 100);
+
+		// Stack freely for the run; rates small enough that nobody dies
+		IConsoleVariable* MaxStacks = IConsoleManager::Get().FindConsoleVariable(TEXT("Slash.StatusEffects.MaxStacks"));
+		const int32       PreviousMaxStacks = MaxStacks->GetInt();
+		MaxStacks->Set(Count, ECVF_SetByConsole);
+
+		Effects->RemoveAll();
+		FStatusEffectSpec Spec;
+		Spec.AmountPerSecond = 0.0001f;
+		Spec.Duration = 1000000.f;
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Spec.Type = static_cast<EStatusEffectType>(Index % static_cast<int32>(EStatusEffectType::ESE_MAX));
+			Effects->ApplyEffect(Targets[Index % Targets.Num()], Spec);
+		}
+		const double ApplyMs = ElapsedMs(StartTime);
+		const int32  NumEffects = Effects->GetNumEffects();
+
+		int32 NumChanged = 0;
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Pass = 0; Pass < Passes; ++Pass)
+		{
+			NumChanged = Effects->Advance(0.25f);
+		}
+		const double PassMs = ElapsedMs(StartTime) / Passes;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumEffects; ++Index)
+		{
+			Targets[Index % Targets.Num()]->ApplyEffectDamage(Spec.AmountPerSecond * 0.25f);
+		}
+		const double PerEffectMs = ElapsedMs(StartTime);
+
+		Effects->RemoveAll();
+		MaxStacks->Set(PreviousMaxStacks, ECVF_SetByConsole);
+
+		UE_LOG(LogSlash, Log, TEXT("Slash.Bench.StatusEffects - %d effects on %d characters: apply %.3f ms, batched pass %.3f ms (%.1f ns per effect, %d characters changed), one damage event per effect %.3f ms"),
+			NumEffects, Targets.Num(), ApplyMs, PassMs, PassMs * 1e6 / FMath::Max(NumEffects, 1), NumChanged, PerEffectMs);
+	}
+
+	/**
+	 * Lock-on candidate queries over the enemies in the level (spawn them with Slash.Bench.SpawnEnemies 2000), turning
+	 * the player's view a little every query. Each query is checked against scoring every enemy, and the log ends with
+	 * PASSED if the best candidate of the spatial index query always matched the brute force one.
+	 */
+	static void LockOn(const TArray<FString>& Args, UWorld* World)
+	{
+		APlayerController*           PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		APawn*                       Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		ULockOnComponent*            LockOnComponent = Pawn ? Pawn->FindComponentByClass<ULockOnComponent>() : nullptr;
+		UEnemySpatialIndexSubsystem* SpatialIndex = World ? World->GetSubsystem<UEnemySpatialIndexSubsystem>() : nullptr;
+		if (LockOnComponent == nullptr || SpatialIndex == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.LockOn [Queries] - needs a player pawn with a lock-on component"));
+			return;
+		}
+
+		const int32 Queries = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 1000);
+		LockOnComponent->ClearTarget();
+
+		double StartTime = FPlatformTime::Seconds();
+		SpatialIndex->Refresh();
+		const double RefreshMs = ElapsedMs(StartTime);
+
+		const FRotator StartRotation = PlayerController->GetControlRotation();
+		double         IndexSeconds = 0.0;
+		double         BruteForceSeconds = 0.0;
+		int64          NumTested = 0;
+		int32          NumFound = 0;
+		int32          NumMismatched = 0;
+		for (int32 Query = 0; Query < Queries; ++Query)
+		{
+			PlayerController->SetControlRotation(StartRotation + FRotator(0.f, 360.f * Query / Queries, 0.f));
+
+			StartTime = FPlatformTime::Seconds();
+			NumTested += LockOnComponent->RefreshCandidates();
+			IndexSeconds += FPlatformTime::Seconds() - StartTime;
+
+			StartTime = FPlatformTime::Seconds();
+			FVector ViewLocation, ViewDirection;
+			LockOnComponent->GetViewPoint(ViewLocation, ViewDirection);
+			float BestScore = 0.f;
+			for (TActorIterator<AEnemy> It(World); It; ++It)
+			{
+				if (!It->ActorHasTag(FName("Dead")))
+				{
+					BestScore = FMath::Max(BestScore, LockOnComponent->ScoreCandidate(ViewLocation, ViewDirection, It->GetActorLocation()));
+				}
+			}
+			BruteForceSeconds += FPlatformTime::Seconds() - StartTime;
+
+			const TArray<AEnemy*>& Candidates = LockOnComponent->GetCandidates();
+			const float            IndexScore = Candidates.Num() > 0 ? LockOnComponent->ScoreCandidate(ViewLocation, ViewDirection, Candidates[0]->GetActorLocation()) : 0.f;
+			NumFound += Candidates.Num() > 0 ? 1 : 0;
+			if (!FMath::IsNearlyEqual(IndexScore, BestScore, KINDA_SMALL_NUMBER))
+			{
+				++NumMismatched;
+			}
+		}
+		PlayerController->SetControlRotation(StartRotation);
+
+		UE_LOG(LogSlash, Log, TEXT("Slash.Bench.LockOn - %d enemies, %d queries (%d with a candidate): index refresh %.3f ms, query %.4f ms (%.1f enemies tested), scoring every enemy %.4f ms - %s (%d mismatched)"),
+			SpatialIndex->GetNumEnemies(), Queries, NumFound, RefreshMs, IndexSeconds * 1000.0 / Queries, static_cast<double>(NumTested) / Queries,
+			BruteForceSeconds * 1000.0 / Queries, NumMismatched == 0 ? TEXT("PASSED") : TEXT("FAILED"), NumMismatched);
+	}
+
+	/**
+	 * Sets every living enemy on the player (spawn 30 around it with Slash.Bench.SpawnEnemies 30 <Class> 150) and
+	 * samples the brawl every frame for Seconds: attack montages, holding enemies and weapon box traces. Compare a run
+	 * with the default token budget to one with Slash.AttackTokens.PerTarget 0.
+	 */
+	static void Brawl(const TArray<FString>& Args, UWorld* World)
+	{
+		APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		APawn*             Pawn = PlayerController ? PlayerController->GetPawn() : nullptr;
+		if (Pawn == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.Brawl [Seconds] - needs a player pawn and spawned enemies"));
+			return;
+		}
+
+		const float Seconds = Args.IsValidIndex(0) ? FCString::Atof(*Args[0]) : 10.f;
+
+		int32 NumEngaged = 0;
+		for (TActorIterator<AEnemy> It(World); It; ++It)
+		{
+			if (It->GetEnemyState() != EEnemyState::EES_Dead)
+			{
+				UGameplayStatics::ApplyDamage(*It, 1.f, PlayerController, Pawn, UDamageType::StaticClass());
+				++NumEngaged;
+			}
+		}
+
+		struct FBrawlSamples
+		{
+			int32 Frames = 0;
+			int64 Montages = 0;
+			int32 PeakMontages = 0;
+			int64 Attacking = 0;
+			int32 PeakAttacking = 0;
+			int64 Holding = 0;
+		};
+
+		const TWeakObjectPtr<UWorld> WeakWorld = World;
+		const uint32                 StartTraces = AWeapon::GetNumBoxTraces();
+		const double                 EndTime = FPlatformTime::Seconds() + Seconds;
+		const bool                   bTokens = UEnemyAttackDirectorSubsystem::IsEnabled();
+		TSharedRef<FBrawlSamples>    Samples = MakeShared<FBrawlSamples>();
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=](float DeltaTime)
+		{
+			UWorld* TickWorld = WeakWorld.Get();
+			if (TickWorld == nullptr)
+				return false;
+
+			int32 Montages = 0;
+			int32 Attacking = 0;
+			for (TActorIterator<AEnemy> It(TickWorld); It; ++It)
+			{
+				const UAnimInstance* AnimInstance = It->GetMesh()->GetAnimInstance();
+				Montages += AnimInstance && AnimInstance->IsAnyMontagePlaying() ? 1 : 0;
+				Attacking += It->GetEnemyState() == EEnemyState::EES_Attacking || It->GetEnemyState() == EEnemyState::EES_Engaged ? 1 : 0;
+				Samples->Holding += It->GetEnemyState() == EEnemyState::EES_Holding ? 1 : 0;
+			}
+			++Samples->Frames;
+			Samples->Montages += Montages;
+			Samples->PeakMontages = FMath::Max(Samples->PeakMontages, Montages);
+			Samples->Attacking += Attacking;
+			Samples->PeakAttacking = FMath::Max(Samples->PeakAttacking, Attacking);
+
+			if (FPlatformTime::Seconds() < EndTime)
+				return true;
+
+			const double Frames = FMath::Max(Samples->Frames, 1);
+			const uint32 NumTraces = AWeapon::GetNumBoxTraces() - StartTraces;
+			UE_LOG(LogSlash, Log, TEXT("Slash.Bench.Brawl %s - %d enemies, %d frames: montages %.1f avg / %d peak, attacking %.1f avg / %d peak, holding %.1f avg, %u box traces (%.2f per frame)"),
+				bTokens ? TEXT("attack tokens") : TEXT("no tokens"), NumEngaged, Samples->Frames, Samples->Montages / Frames, Samples->PeakMontages,
+				Samples->Attacking / Frames, Samples->PeakAttacking, Samples->Holding / Frames, NumTraces, NumTraces / Frames);
+			return false;
+		}));
+		CaptureCsvFor(World, Seconds);
+	}
+
+	/**
+	 * Flies the player Legs times between its location and Distance along X, SecondsPerLeg each so the cells finish
+	 * streaming, and logs per leg the levels and actors that streamed in, the actors spawned at runtime and the
+	 * placed breakables and pickups the world state initialized or dropped, and the actors destroyed in the leg that
+	 * created them (spawned, or streamed in and never begun play). Break pots and collect pickups near both ends
+	 * first: from the second visit on, dropped actors grow by those and nothing consumed is initialized again.
+	 */
+	static void Streaming(const TArray<FString>& Args, UWorld* World)
+	{
+		APlayerController*         PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+		ACharacter*                Character = PlayerController ? Cast<ACharacter>(PlayerController->GetPawn()) : nullptr;
+		USlashWorldStateSubsystem* WorldState = World ? World->GetSubsystem<USlashWorldStateSubsystem>() : nullptr;
+		if (Character == nullptr || WorldState == nullptr)
+		{
+			UE_LOG(LogSlash, Warning, TEXT("Usage: Slash.Bench.Streaming [Legs] [Distance] [SecondsPerLeg] - needs a player character"));
+			return;
+		}
+
+		const int32 Legs = FMath::Max(1, Args.IsValidIndex(0) ? FCString::Atoi(*Args[0]) : 10);
+		const float Distance = Args.IsValidIndex(1) ? FCString::Atof(*Args[1]) : 51200.f;
+		const float SecondsPerLeg = Args.IsValidIndex(2) ? FCString::Atof(*Args[2]) : 5.f;
+
+		struct FStreamingSamples
+		{
+			int32           Leg = 0;
+			double          NextLegTime = 0.0;
+			int32           Levels = 0;
+			int32           LevelActors = 0;
+			int32           Spawned = 0;
+			int32           Discarded = 0;
+			int32           StartLoaded = 0;
+			int32           StartSkipped = 0;
+			int32           TotalLevels = 0;
+			int32           TotalLevelActors = 0;
+			int32           TotalSpawned = 0;
+			int32           TotalDiscarded = 0;
+			FDelegateHandle LevelAddedHandle;
+			FDelegateHandle SpawnedHandle;
+			FDelegateHandle DestroyedHandle;
+
+			TSet<TObjectKey<AActor>> SpawnedThisLeg;
+		};
+
+		const TWeakObjectPtr<UWorld>     WeakWorld = World;
+		const TWeakObjectPtr<ACharacter> WeakCharacter = Character;
+		const FVector                    Start = Character->GetActorLocation();
+		const FVector                    Far = Start + FVector(Distance, 0.f, 0.f);
+		TSharedRef<FStreamingSamples>    Samples = MakeShared<FStreamingSamples>();
+		const int32                      InitialLoaded = WorldState->GetNumActorsLoaded();
+		const int32                      InitialSkipped = WorldState->GetNumActorsSkipped();
+		Samples->StartLoaded = InitialLoaded;
+		Samples->StartSkipped = InitialSkipped;
+
+		Samples->LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddLambda([WeakWorld, Samples](ULevel* Level, UWorld* InWorld)
+		{
+			if (Level && InWorld == WeakWorld.Get())
+			{
+				++Samples->Levels;
+				Samples->LevelActors += Level->Actors.Num();
+			}
+		});
+		Samples->SpawnedHandle = World->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateLambda([Samples](AActor* Actor)
+		{
+			++Samples->Spawned;
+			Samples->SpawnedThisLeg.Add(Actor);
+		}));
+		Samples->DestroyedHandle = World->AddOnActorDestroyedHandler(FOnActorDestroyed::FDelegate::CreateLambda([Samples](AActor* Actor)
+		{
+			if (!Actor->HasActorBegunPlay() || Samples->SpawnedThisLeg.Contains(Actor))
+			{
+				++Samples->Discarded;
+			}
+		}));
+
+		// Nothing to stand on while the far cells are still loading
+		Character->GetCharacterMovement()->SetMovementMode(MOVE_Flying);
+
+		FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([=](float DeltaTime)
+		{
+			UWorld*                    TickWorld = WeakWorld.Get();
+			ACharacter*                TickCharacter = WeakCharacter.Get();
+			USlashWorldStateSubsystem* TickWorldState = TickWorld ? TickWorld->GetSubsystem<USlashWorldStateSubsystem>() : nullptr;
+			if (TickCharacter == nullptr || TickWorldState == nullptr)
+			{
+				FWorldDelegates::LevelAddedToWorld.Remove(Samples->LevelAddedHandle);
+				if (TickWorld)
+				{
+					TickWorld->RemoveOnActorSpawnedHandler(Samples->SpawnedHandle);
+					TickWorld->RemoveOnActorDestroyededHandler(Samples->DestroyedHandle);
+				}
+				return false;
+			}
+			if (FPlatformTime::Seconds() < Samples->NextLegTime)
+				return true;
+
+			const int32 Loaded = TickWorldState->GetNumActorsLoaded();
+			const int32 Skipped = TickWorldState->GetNumActorsSkipped();
+			if (Samples->Leg > 0)
+			{
+				UE_LOG(LogSlash, Log, TEXT("Slash.Bench.Streaming - leg %d/%d: %d levels streamed in (%d actors), %d actors spawned, %d created then destroyed, placed actors %d initialized / %d dropped"),
+					Samples->Leg, Legs, Samples->Levels, Samples->LevelActors, Samples->Spawned, Samples->Discarded, Loaded - Samples->StartLoaded, Skipped - Samples->StartSkipped);
+				Samples->TotalLevels += Samples->Levels;
+				Samples->TotalLevelActors += Samples->LevelActors;
+				Samples->TotalSpawned += Samples->Spawned;
+				Samples->TotalDiscarded += Samples->Discarded;
+			}
+
+			if (Samples->Leg == Legs)
+			{
+				UE_LOG(LogSlash, Log, TEXT("Slash.Bench.Streaming - %d legs of %.0f: %d levels streamed in (%d actors), %d actors spawned, %d created then destroyed, placed actors %d initialized / %d dropped"),
+					Legs, Distance, Samples->TotalLevels, Samples->TotalLevelActors, Samples->TotalSpawned, Samples->TotalDiscarded, Loaded - InitialLoaded, Skipped - InitialSkipped);
+				FWorldDelegates::LevelAddedToWorld.Remove(Samples->LevelAddedHandle);
+				TickWorld->RemoveOnActorSpawnedHandler(Samples->SpawnedHandle);
+				TickWorld->RemoveOnActorDestroyededHandler(Samples->DestroyedHandle);
+				TickCharacter->GetCharacterMovement()->SetMovementMode(MOVE_Falling);
+				return false;
+			}
+
+			Samples->Levels = Samples->LevelActors = Samples->Spawned = Samples->Discarded = 0;
+			Samples->SpawnedThisLeg.Reset();
+			Samples->StartLoaded = Loaded;
+			Samples->StartSkipped = Skipped;
+			TickCharacter->TeleportTo(Samples->Leg % 2 == 0 ? Far : Start, TickCharacter->GetActorRotation(), false, true);
+			++Samples->Leg;
+			Samples->NextLegTime = FPlatformTime::Seconds() + SecondsPerLeg;
+			return true;
+		}));
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchSpawnEnemiesCommand(
+	TEXT("Slash.Bench.SpawnEnemies"),
+	TEXT("Slash.Bench.SpawnEnemies <Count> <EnemyClassPath> [Spacing] - spawns enemies in a grid around the player. Compare 'stat anim' / 'stat Slash' with native vs Blueprint anim instances."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::SpawnEnemies));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchSpawnBreakablesCommand(
+	TEXT("Slash.Bench.SpawnBreakables"),
+	TEXT("Slash.Bench.SpawnBreakables <Count> <BreakableClassPath> [Spacing] - spawns breakables in a grid around the player and logs spawn time and memory."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::SpawnBreakables));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchPickupDropsCommand(
+	TEXT("Slash.Bench.PickupDrops"),
+	TEXT("Slash.Bench.PickupDrops <Count> <ItemClassPath> [actors] - drops pickups around the player on a listen or dedicated server and reports channels and bandwidth; run with and without 'actors' for the comparison."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::PickupDrops));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchBreakPotsCommand(
+	TEXT("Slash.Bench.BreakPots"),
+	TEXT("Slash.Bench.BreakPots <Count> <BreakableClassPath> [Seconds] - spawns and breaks breakables, then records a CSV profile (Chaos solver time, active debris pieces) for the given duration (default 60)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::BreakPots));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchSaveRoundTripCommand(
+	TEXT("Slash.Bench.SaveRoundTrip"),
+	TEXT("Slash.Bench.SaveRoundTrip [Cells] [ActorsPerCell] - round trips the save game through disk with optional synthetic world state cells and logs snapshot/compress/write/read/apply times."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::SaveRoundTrip));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchCheckpointRoundTripCommand(
+	TEXT("Slash.Bench.CheckpointRoundTrip"),
+	TEXT("Slash.Bench.CheckpointRoundTrip [Count] - kills Count enemies and breaks Count breakables after a capture, restores and checks the state matches the capture."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::CheckpointRoundTrip));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchRewindValidationCommand(
+	TEXT("Slash.Bench.RewindValidation"),
+	TEXT("Slash.Bench.RewindValidation [LatencyMs] - validates simulated late hit claims against every character; combine with Slash.Bench.SpawnEnemies, or run on a listen server with NetEmulation.PktLag for real claims."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::RewindValidation));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchPickupProximityCommand(
+	TEXT("Slash.Bench.PickupProximity"),
+	TEXT("Slash.Bench.PickupProximity [Count] [Spacing] [Steps] - sweeps the player across Count items (default 10000) and logs the per move cost with item sphere overlaps vs the proximity query."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::PickupProximity));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchHealthBarsCommand(
+	TEXT("Slash.Bench.HealthBars"),
+	TEXT("Slash.Bench.HealthBars [Count] [Seconds] - damages Count enemies (default 200) so they show health bars, logs the widget count and records a CSV profile (SlashHUD category)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::HealthBars));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchAssetPreloadCommand(
+	TEXT("Slash.Bench.AssetPreload"),
+	TEXT("Slash.Bench.AssetPreload - logs every preloaded archetype with its users, asset count and load time. Compare the startup log line with -dpcvars=Slash.Preload.Enabled=0."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::AssetPreload));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchFeedbackCommand(
+	TEXT("Slash.Bench.Feedback"),
+	TEXT("Slash.Bench.Feedback <SoundPath> <ParticleSystemPath> [HitsPerFrame] [Frames] [direct] - hit audio/VFX stress test through the feedback dispatcher, or 'direct' through UGameplayStatics; logs game thread cost and component counts."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::Feedback));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchAttributesCommand(
+	TEXT("Slash.Bench.Attributes"),
+	TEXT("Slash.Bench.Attributes [Characters] [ModifiersPerCharacter] [Rounds] - modifier application/removal and cached attribute reads for 1000 characters by default; logs ns per operation."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::Attributes));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchStatusEffectsCommand(
+	TEXT("Slash.Bench.StatusEffects"),
+	TEXT("Slash.Bench.StatusEffects [Count] [Passes] - 10000 status effects by default over the living characters, advanced in batched passes; logs ms per pass against one damage event per effect."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::StatusEffects));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchLockOnCommand(
+	TEXT("Slash.Bench.LockOn"),
+	TEXT("Slash.Bench.LockOn [Queries] - lock-on candidate queries through the enemy spatial index (default 1000, spawn 2000 enemies first), checked against and timed next to scoring every enemy; logs PASSED or FAILED."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::LockOn));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchBrawlCommand(
+	TEXT("Slash.Bench.Brawl"),
+	TEXT("Slash.Bench.Brawl [Seconds] - sets every enemy on the player and logs attack montages, holding enemies and weapon box traces per frame over Seconds (default 10); run once more with Slash.AttackTokens.PerTarget 0."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::Brawl));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashBenchStreamingCommand(
+	TEXT("Slash.Bench.Streaming"),
+	TEXT("Slash.Bench.Streaming [Legs] [Distance] [SecondsPerLeg] - moves the player back and forth across streaming cells (default 10 legs of 51200, 5 s each) and logs levels and actors streamed in, actors spawned, actors created then destroyed and placed actors initialized or dropped per leg."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashBenchmark::Streaming));
+
+#endif
@@ -3,9 +3,18 @@
 
 #include "Breakable/BreakableActor.h"
 
+#include "Breakable/FractureDebrisSubsystem.h"
+#include "Breakable/FracturedBreakable.h"
 #include "Components/CapsuleComponent.h"
 #include "GeometryCollection/GeometryCollectionComponent.h"
+#include "GeometryCollection/GeometryCollectionObject.h"
+#include "Items/PickupSubsystem.h"
 #include "Items/Treasure.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Slash/Slash.h"
+#include "World/SlashAssetPreloadSubsystem.h"
+#include "World/SlashWorldStateSubsystem.h"
 
 // Sets default values
 ABreakableActor::ABreakableActor()
@@ -13,16 +22,68 @@ ABreakableActor::ABreakableActor()
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = false;
 
-	GeometryCollection = CreateDefaultSubobject<UGeometryCollectionComponent>(TEXT("GeometryCollection"));
-	SetRootComponent(GeometryCollection);
-	GeometryCollection->SetGenerateOverlapEvents(true);
-	GeometryCollection->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
+	bReplicates = true;
+	NetDormancy = DORM_Initial;
 
-	// GeometryCollection->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Ignore);
-	// Capsule = CreateDefaultSubobject<UCapsuleComponent>(TEXT("Capsule"));
-	// Capsule->SetupAttachment(GetRootComponent());
-	// Capsule->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
-	// Capsule->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Block);
+	Capsule = CreateDefaultSubobject<UCapsuleComponent>(TEXT("Capsule"));
+	SetRootComponent(Capsule);
+	Capsule->InitCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+	Capsule->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	Capsule->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic);
+	Capsule->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+	Capsule->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Block);
+	Capsule->SetCollisionResponseToChannel(ECollisionChannel::ECC_Visibility, ECollisionResponse::ECR_Block);
+	Capsule->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldDynamic, ECollisionResponse::ECR_Overlap);
+	Capsule->SetGenerateOverlapEvents(true);
+}
+
+void ABreakableActor::PostLoad()
+{
+	Super::PostLoad();
+
+#if WITH_EDITORONLY_DATA
+	if (GeometryCollection_DEPRECATED)
+	{
+		if (GeometryCollectionAsset == nullptr)
+		{
+			GeometryCollectionAsset = const_cast<UGeometryCollection*>(GeometryCollection_DEPRECATED->GetRestCollection());
+		}
+		GeometryCollection_DEPRECATED->DestroyComponent();
+		GeometryCollection_DEPRECATED = nullptr;
+	}
+#endif
+}
+
+void ABreakableActor::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	// Blueprint defaults are only known after the native constructor
+	Capsule->SetCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+}
+
+void ABreakableActor::PreRegisterAllComponents()
+{
+	Super::PreRegisterAllComponents();
+
+	// Already broken in an earlier visit of this cell: nothing registers and the actor is dropped once initialized
+	const UWorld* World = GetWorld();
+	if (World && !IsActorInitialized())
+	{
+		USlashWorldStateSubsystem* WorldState = World->GetSubsystem<USlashWorldStateSubsystem>();
+		bSkippedOnLoad = WorldState && WorldState->ShouldSkipOnLoad(this);
+	}
+}
+
+void ABreakableActor::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Before BeginPlay adds a stand-in
+	if (bSkippedOnLoad)
+	{
+		Destroy();
+	}
 }
 
 // Called when the game starts or when spawned
@@ -30,6 +91,65 @@ void ABreakableActor::BeginPlay()
 {
 	Super::BeginPlay();
 
+	if (GeometryCollectionAsset == nullptr)
+	{
+		UE_LOG(LogSlash, Warning, TEXT("Breakable %s has no GeometryCollectionAsset, it breaks without pieces"), *GetPathName());
+	}
+
+	ShowUnbroken();
+
+	if (USlashAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<USlashAssetPreloadSubsystem>())
+	{
+		Preload->AddUser(this);
+	}
+}
+
+void ABreakableActor::ShowUnbroken()
+{
+	UBreakableStandInSubsystem* StandIns = GetWorld()->GetSubsystem<UBreakableStandInSubsystem>();
+	if (StandIns == nullptr)
+		return;
+
+	if (StandInMesh)
+	{
+		StandInHandle = StandIns->AddStandIn(StandInMesh, GetActorTransform());
+	}
+	else if (GeometryCollectionAsset)
+	{
+		// No stand-in configured: show the geometry collection from the start, as before
+		FracturedActor = StandIns->AcquireFracturedActor(GeometryCollectionAsset, GetActorTransform());
+	}
+}
+
+void ABreakableActor::ResetBreakable()
+{
+	if (!bBroken)
+		return;
+
+	FlushNetDormancy();
+	bBroken = false;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ABreakableActor, bBroken, this);
+
+	// The old pieces are owned by the debris manager, which drops them on its own
+	Capsule->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	ShowUnbroken();
+}
+
+void ABreakableActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UBreakableStandInSubsystem* StandIns = GetWorld()->GetSubsystem<UBreakableStandInSubsystem>())
+	{
+		StandIns->RemoveStandIn(StandInHandle);
+		StandIns->ReleaseFracturedActor(FracturedActor);
+		FracturedActor = nullptr;
+	}
+
+	if (USlashAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<USlashAssetPreloadSubsystem>())
+	{
+		Preload->RemoveUser(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Called every frame
@@ -41,19 +161,87 @@ void ABreakableActor::Tick(float DeltaTime)
 
 void ABreakableActor::GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter)
 {
-	if (bBroken)
+	if (bBroken || !HasAuthority())
 	{
 		return;
 	}
+
+	FlushNetDormancy();
 	bBroken = true;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ABreakableActor, bBroken, this);
+
+	if (USlashWorldStateSubsystem* WorldState = GetWorld()->GetSubsystem<USlashWorldStateSubsystem>())
+	{
+		WorldState->MarkConsumed(this);
+	}
 
-	UWorld* World = GetWorld();
-	if (World && TreasureClasses.Num() > 0)
+	ShowBroken();
+
+	if (TreasureClasses.Num() > 0)
 	{
 		FVector Location = GetActorLocation();
 		Location.Z += 75.f;
 
-		const int32 Selection = FMath::RandRange(0, TreasureClasses.Num() - 1);
-		World->SpawnActor<ATreasure>(TreasureClasses[Selection], Location, GetActorRotation());
+		const int32                  Selection = FMath::RandRange(0, TreasureClasses.Num() - 1);
+		const TWeakObjectPtr<UWorld> WeakWorld = GetWorld();
+		USlashAssetPreloadSubsystem::LoadClass(TreasureClasses[Selection], [WeakWorld, Location](UClass* Class)
+		{
+			UPickupSubsystem* Pickups = WeakWorld.IsValid() ? WeakWorld->GetSubsystem<UPickupSubsystem>() : nullptr;
+			if (Pickups)
+			{
+				Pickups->SpawnPickup(Class, Location, GetDefault<ATreasure>(Class)->GetGold());
+			}
+		});
 	}
-}
\ No newline at end of file
+}
+
+void ABreakableActor::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ABreakableActor, bBroken, Params);
+}
+
+void ABreakableActor::ShowBroken()
+{
+	Capsule->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	// A dedicated server has nobody to show the pieces to
+	if (GetNetMode() == NM_DedicatedServer)
+		return;
+
+	// Swap the stand-in instance for a simulated geometry collection; the hitter's fields break it
+	if (UBreakableStandInSubsystem* StandIns = GetWorld()->GetSubsystem<UBreakableStandInSubsystem>())
+	{
+		if (StandInHandle.IsValid())
+		{
+			StandIns->RemoveStandIn(StandInHandle);
+			if (GeometryCollectionAsset)
+			{
+				FracturedActor = StandIns->AcquireFracturedActor(GeometryCollectionAsset, GetActorTransform());
+			}
+		}
+	}
+
+	// From here on the debris manager decides when the pieces go back to the pool
+	if (UFractureDebrisSubsystem* Debris = GetWorld()->GetSubsystem<UFractureDebrisSubsystem>())
+	{
+		Debris->TrackFracture(FracturedActor);
+		FracturedActor = nullptr;
+	}
+}
+
+void ABreakableActor::OnRep_Broken()
+{
+	if (bBroken)
+	{
+		ShowBroken();
+	}
+	else
+	{
+		Capsule->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		ShowUnbroken();
+	}
+}
@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Breakable/BreakableStandInSubsystem.h"
+
+#include "Breakable/FracturedBreakable.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Slash/Slash.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Breakable Stand-ins"), STAT_BreakableStandIns, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Fractured Breakables"), STAT_ActiveFracturedBreakables, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pooled Fractured Breakables"), STAT_PooledFracturedBreakables, STATGROUP_Slash);
+
+bool UBreakableStandInSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+FBreakableStandInHandle UBreakableStandInSubsystem::AddStandIn(UStaticMesh* Mesh, const FTransform& Transform)
+{
+	FBreakableStandInHandle Handle;
+	UInstancedStaticMeshComponent* Component = GetOrCreateStandInComponent(Mesh);
+	if (Component == nullptr)
+		return Handle;
+
+	Handle.Component = Component;
+	TArray<int32>& Free = FreeInstances.FindOrAdd(Component);
+	if (Free.Num() > 0)
+	{
+		Handle.InstanceIndex = Free.Pop(EAllowShrinking::No);
+		Component->UpdateInstanceTransform(Handle.InstanceIndex, Transform, true, true, true);
+	}
+	else
+	{
+		Handle.InstanceIndex = Component->AddInstance(Transform, true);
+	}
+
+	SET_DWORD_STAT(STAT_BreakableStandIns, ++NumStandIns);
+	return Handle;
+}
+
+void UBreakableStandInSubsystem::RemoveStandIn(FBreakableStandInHandle& Handle)
+{
+	if (!Handle.IsValid())
+		return;
+
+	UInstancedStaticMeshComponent* Component = Handle.Component.Get();
+	FTransform Collapsed;
+	Component->GetInstanceTransform(Handle.InstanceIndex, Collapsed, true);
+	Collapsed.SetScale3D(FVector::ZeroVector);
+	Component->UpdateInstanceTransform(Handle.InstanceIndex, Collapsed, true, true, true);
+
+	FreeInstances.FindOrAdd(Component).Add(Handle.InstanceIndex);
+	Handle = FBreakableStandInHandle();
+
+	SET_DWORD_STAT(STAT_BreakableStandIns, --NumStandIns);
+}
+
+AFracturedBreakable* UBreakableStandInSubsystem::AcquireFracturedActor(const UGeometryCollection* Collection, const FTransform& Transform)
+{
+	AFracturedBreakable* FracturedActor = nullptr;
+	while (FracturedActor == nullptr && FracturedPool.Num() > 0)
+	{
+		FracturedActor = FracturedPool.Pop(EAllowShrinking::No);
+	}
+
+	if (FracturedActor == nullptr)
+	{
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		Params.ObjectFlags |= RF_Transient;
+		FracturedActor = GetWorld()->SpawnActor<AFracturedBreakable>(AFracturedBreakable::StaticClass(), Transform, Params);
+	}
+
+	if (FracturedActor)
+	{
+		FracturedActor->Activate(Collection, Transform);
+		SET_DWORD_STAT(STAT_ActiveFracturedBreakables, ++NumActiveFractured);
+		SET_DWORD_STAT(STAT_PooledFracturedBreakables, FracturedPool.Num());
+	}
+	return FracturedActor;
+}
+
+void UBreakableStandInSubsystem::ReleaseFracturedActor(AFracturedBreakable* FracturedActor)
+{
+	if (FracturedActor == nullptr)
+		return;
+
+	FracturedActor->Deactivate();
+	FracturedPool.Add(FracturedActor);
+
+	SET_DWORD_STAT(STAT_ActiveFracturedBreakables, --NumActiveFractured);
+	SET_DWORD_STAT(STAT_PooledFracturedBreakables, FracturedPool.Num());
+}
+
+UInstancedStaticMeshComponent* UBreakableStandInSubsystem::GetOrCreateStandInComponent(UStaticMesh* Mesh)
+{
+	if (Mesh == nullptr)
+		return nullptr;
+
+	if (UInstancedStaticMeshComponent** Found = StandInComponents.Find(Mesh))
+	{
+		return *Found;
+	}
+
+	if (StandInHost == nullptr)
+	{
+		FActorSpawnParameters Params;
+		Params.Name = TEXT("BreakableStandInHost");
+		Params.ObjectFlags |= RF_Transient;
+		StandInHost = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+		StandInHost->SetRootComponent(NewObject<USceneComponent>(StandInHost, TEXT("Root")));
+		StandInHost->GetRootComponent()->RegisterComponent();
+	}
+
+	// Rendering only; each breakable keeps its own query collider
+	UInstancedStaticMeshComponent* Component = NewObject<UInstancedStaticMeshComponent>(StandInHost);
+	Component->SetStaticMesh(Mesh);
+	Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Component->SetCanEverAffectNavigation(false);
+	Component->SetupAttachment(StandInHost->GetRootComponent());
+	Component->RegisterComponent();
+
+	StandInComponents.Add(Mesh, Component);
+	return Component;
+}
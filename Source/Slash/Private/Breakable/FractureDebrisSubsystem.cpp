@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Breakable/FractureDebrisSubsystem.h"
+
+#include "Breakable/BreakableStandInSubsystem.h"
+#include "Breakable/FracturedBreakable.h"
+#include "GeometryCollection/GeometryCollection.h"
+#include "GeometryCollection/GeometryCollectionComponent.h"
+#include "GeometryCollection/GeometryCollectionSimulationTypes.h"
+#include "GeometryCollection/GeometryDynamicCollection.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Slash/Slash.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Debris Pieces"), STAT_ActiveDebrisPieces, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Tracked Fractures"), STAT_TrackedFractures, STATGROUP_Slash);
+CSV_DEFINE_CATEGORY(SlashDebris, true);
+
+namespace SlashDebris
+{
+	static int32 PieceBudget = 1500;
+	static FAutoConsoleVariableRef CVarPieceBudget(TEXT("Slash.Debris.PieceBudget"), PieceBudget,
+		TEXT("Maximum number of rigid fracture pieces alive at once; the oldest fractures are released beyond it."));
+
+	static float MaxLifetime = 30.f;
+	static FAutoConsoleVariableRef CVarMaxLifetime(TEXT("Slash.Debris.MaxLifetime"), MaxLifetime,
+		TEXT("Seconds after which a fracture is released even if it is still in view."));
+
+	static float SleepLinearThreshold = 15.f;
+	static FAutoConsoleVariableRef CVarSleepLinear(TEXT("Slash.Debris.SleepLinearThreshold"), SleepLinearThreshold,
+		TEXT("Linear velocity (cm/s) under which debris pieces may go to sleep. Applies to fractures activated afterwards."));
+
+	static float SleepAngularThreshold = 1.f;
+	static FAutoConsoleVariableRef CVarSleepAngular(TEXT("Slash.Debris.SleepAngularThreshold"), SleepAngularThreshold,
+		TEXT("Angular velocity (rad/s) under which debris pieces may go to sleep. Applies to fractures activated afterwards."));
+
+	static constexpr float UpdateInterval = 0.25f;
+	static constexpr float OutOfViewTime = 0.5f;
+}
+
+void UFractureDebrisSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	GetDebrisMaterial();
+}
+
+bool UFractureDebrisSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UFractureDebrisSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate >= SlashDebris::UpdateInterval)
+	{
+		TimeSinceUpdate = 0.f;
+		UpdateFractures();
+	}
+
+	SET_DWORD_STAT(STAT_ActiveDebrisPieces, NumActivePieces);
+	SET_DWORD_STAT(STAT_TrackedFractures, Fractures.Num());
+	CSV_CUSTOM_STAT(SlashDebris, ActivePieces, NumActivePieces, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SlashDebris, TrackedFractures, Fractures.Num(), ECsvCustomStatOp::Set);
+}
+
+TStatId UFractureDebrisSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFractureDebrisSubsystem, STATGROUP_Tickables);
+}
+
+void UFractureDebrisSubsystem::ConfigureFracture(UGeometryCollectionComponent* GeometryCollection)
+{
+	if (GeometryCollection == nullptr)
+		return;
+
+	GeometryCollection->SetPhysMaterialOverride(GetDebrisMaterial());
+	// Small pieces are removed by the asset's remove-on-sleep settings; don't let instances opt out
+	GeometryCollection->bAllowRemovalOnSleep = true;
+	GeometryCollection->bAllowRemovalOnBreak = true;
+	GeometryCollection->SetNotifyBreaks(true);
+	GeometryCollection->SetNotifyRemovals(true);
+}
+
+void UFractureDebrisSubsystem::TrackFracture(AFracturedBreakable* FracturedActor)
+{
+	if (FracturedActor == nullptr)
+		return;
+
+	UGeometryCollectionComponent* GeometryCollection = FracturedActor->GetGeometryCollection();
+	GeometryCollection->OnChaosBreakEvent.AddUniqueDynamic(this, &UFractureDebrisSubsystem::OnPiecesBroken);
+	GeometryCollection->OnChaosRemovalEvent.AddUniqueDynamic(this, &UFractureDebrisSubsystem::OnPiecesRemoved);
+
+	FTrackedFracture& Fracture = Fractures.AddDefaulted_GetRef();
+	Fracture.Actor = FracturedActor;
+	Fracture.StartTime = GetWorld()->GetTimeSeconds();
+}
+
+void UFractureDebrisSubsystem::OnPiecesBroken(const FChaosBreakEvent& BreakEvent)
+{
+	if (FTrackedFracture* Fracture = FindFracture(BreakEvent.Component))
+	{
+		++Fracture->NumPieces;
+		++NumActivePieces;
+	}
+}
+
+void UFractureDebrisSubsystem::OnPiecesRemoved(const FChaosRemovalEvent& RemovalEvent)
+{
+	if (FTrackedFracture* Fracture = FindFracture(RemovalEvent.Component))
+	{
+		if (Fracture->NumPieces > 0)
+		{
+			--Fracture->NumPieces;
+			--NumActivePieces;
+		}
+	}
+}
+
+UFractureDebrisSubsystem::FTrackedFracture* UFractureDebrisSubsystem::FindFracture(const UPrimitiveComponent* Component)
+{
+	const AActor* Owner = Component ? Component->GetOwner() : nullptr;
+	return Fractures.FindByPredicate([Owner](const FTrackedFracture& Fracture)
+	{
+		return Fracture.Actor.Get() == Owner;
+	});
+}
+
+void UFractureDebrisSubsystem::ReleaseAll()
+{
+	for (int32 Index = Fractures.Num() - 1; Index >= 0; --Index)
+	{
+		ReleaseFracture(Index);
+	}
+}
+
+void UFractureDebrisSubsystem::ReleaseFracture(int32 Index)
+{
+	FTrackedFracture Fracture = Fractures[Index];
+	Fractures.RemoveAt(Index);
+	NumActivePieces -= Fracture.NumPieces;
+
+	AFracturedBreakable* FracturedActor = Fracture.Actor.Get();
+	if (FracturedActor == nullptr)
+		return;
+
+	UGeometryCollectionComponent* GeometryCollection = FracturedActor->GetGeometryCollection();
+	GeometryCollection->OnChaosBreakEvent.RemoveDynamic(this, &UFractureDebrisSubsystem::OnPiecesBroken);
+	GeometryCollection->OnChaosRemovalEvent.RemoveDynamic(this, &UFractureDebrisSubsystem::OnPiecesRemoved);
+
+	if (UBreakableStandInSubsystem* StandIns = GetWorld()->GetSubsystem<UBreakableStandInSubsystem>())
+	{
+		StandIns->ReleaseFracturedActor(FracturedActor);
+	}
+}
+
+void UFractureDebrisSubsystem::UpdateFractures()
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// Release fractures that are at rest and no longer seen, or simply too old
+	for (int32 Index = Fractures.Num() - 1; Index >= 0; --Index)
+	{
+		const FTrackedFracture& Fracture = Fractures[Index];
+		const AFracturedBreakable* FracturedActor = Fracture.Actor.Get();
+		if (FracturedActor == nullptr)
+		{
+			ReleaseFracture(Index);
+			continue;
+		}
+
+		const bool bAtRest = IsAtRest(FracturedActor->GetGeometryCollection());
+		const bool bOutOfView = !FracturedActor->WasRecentlyRendered(SlashDebris::OutOfViewTime);
+		const bool bExpired = Now - Fracture.StartTime >= SlashDebris::MaxLifetime;
+		if ((bAtRest && bOutOfView) || bExpired)
+		{
+			ReleaseFracture(Index);
+		}
+	}
+
+	// Over budget: drop the oldest fractures first
+	while (NumActivePieces > SlashDebris::PieceBudget && Fractures.Num() > 0)
+	{
+		ReleaseFracture(0);
+	}
+}
+
+bool UFractureDebrisSubsystem::IsAtRest(const UGeometryCollectionComponent* GeometryCollection)
+{
+	// The game thread copy of the proxy's particle states, synced every physics frame
+	const FGeometryDynamicCollection* DynamicCollection = GeometryCollection->GetDynamicCollection();
+	if (DynamicCollection == nullptr)
+		return true;
+
+	for (int32 Index = 0; Index < DynamicCollection->NumElements(FGeometryCollection::TransformGroup); ++Index)
+	{
+		if (DynamicCollection->Active[Index] && DynamicCollection->DynamicState[Index] == static_cast<int32>(EObjectStateTypeEnum::Chaos_Object_Dynamic))
+			return false;
+	}
+	return true;
+}
+
+UPhysicalMaterial* UFractureDebrisSubsystem::GetDebrisMaterial()
+{
+	if (DebrisMaterial == nullptr
+		|| DebrisMaterial->SleepLinearVelocityThreshold != SlashDebris::SleepLinearThreshold
+		|| DebrisMaterial->SleepAngularVelocityThreshold != SlashDebris::SleepAngularThreshold)
+	{
+		DebrisMaterial = NewObject<UPhysicalMaterial>(this);
+		DebrisMaterial->SleepCounterThreshold = 4;
+		DebrisMaterial->SleepLinearVelocityThreshold = SlashDebris::SleepLinearThreshold;
+		DebrisMaterial->SleepAngularVelocityThreshold = SlashDebris::SleepAngularThreshold;
+	}
+	return DebrisMaterial;
+}
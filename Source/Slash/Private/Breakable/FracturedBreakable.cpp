@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Breakable/FracturedBreakable.h"
+
+#include "Breakable/FractureDebrisSubsystem.h"
+#include "GeometryCollection/GeometryCollectionComponent.h"
+#include "GeometryCollection/GeometryCollectionObject.h"
+
+AFracturedBreakable::AFracturedBreakable()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	GeometryCollection = CreateDefaultSubobject<UGeometryCollectionComponent>(TEXT("GeometryCollection"));
+	SetRootComponent(GeometryCollection);
+	GeometryCollection->SetGenerateOverlapEvents(true);
+	GeometryCollection->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
+	GeometryCollection->bAutoRegister = false;
+
+	SetActorHiddenInGame(true);
+}
+
+void AFracturedBreakable::Activate(const UGeometryCollection* Collection, const FTransform& Transform)
+{
+	SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	// Registering builds a fresh physics proxy from the rest collection
+	GeometryCollection->SetRestCollection(Collection);
+	if (const UFractureDebrisSubsystem* Debris = GetWorld()->GetSubsystem<UFractureDebrisSubsystem>())
+	{
+		Debris->ConfigureFracture(GeometryCollection);
+	}
+	GeometryCollection->RegisterComponent();
+	GeometryCollection->SetSimulatePhysics(true);
+
+	SetActorHiddenInGame(false);
+}
+
+void AFracturedBreakable::Deactivate()
+{
+	SetActorHiddenInGame(true);
+
+	if (GeometryCollection->IsRegistered())
+	{
+		GeometryCollection->UnregisterComponent();
+	}
+}
@@ -7,10 +7,14 @@
 #include "Items/Weapons/Weapon.h"
 #include "Components/AttributeComponent.h"
 #include "Components/CapsuleComponent.h"
-#include "Kismet/GameplayStatics.h"
-#include "Slash/DebugMacros.h"
-
-ABaseCharacter::ABaseCharacter()
+#include "Components/StatusEffectSubsystem.h"
+#include "Net/SlashRewindSubsystem.h"
+#include "World/SlashAssetPreloadSubsystem.h"
+#include "World/SlashFeedbackSubsystem.h"
+#include "Slash/SlashDebugDraw.h"
+
+ABaseCharacter::ABaseCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = true;
 
@@ -21,7 +25,40 @@ ABaseCharacter::ABaseCharacter()
 void ABaseCharacter::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	// Server keeps a position history of every character to validate client hit claims
+	if (HasAuthority())
+	{
+		if (USlashRewindSubsystem* Rewind = GetWorld()->GetSubsystem<USlashRewindSubsystem>())
+		{
+			Rewind->RegisterCharacter(this);
+		}
+	}
+
+	if (USlashAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<USlashAssetPreloadSubsystem>())
+	{
+		Preload->AddUser(this);
+	}
+}
+
+void ABaseCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USlashRewindSubsystem* Rewind = GetWorld()->GetSubsystem<USlashRewindSubsystem>())
+	{
+		Rewind->UnregisterCharacter(this);
+	}
+
+	if (USlashAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<USlashAssetPreloadSubsystem>())
+	{
+		Preload->RemoveUser(this);
+	}
+
+	if (UStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UStatusEffectSubsystem>())
+	{
+		StatusEffects->RemoveTarget(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ABaseCharacter::GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter)
@@ -39,6 +76,18 @@ void ABaseCharacter::GetHit_Implementation(const FVector& ImpactPoint, AActor* H
 	SpawnHitParticles(ImpactPoint);
 }
 
+void ABaseCharacter::ApplyEffectDamage(float DamageAmount)
+{
+	if (!IsAlive())
+		return;
+
+	HandleDamage(DamageAmount);
+	if (!IsAlive())
+	{
+		Die();
+	}
+}
+
 void ABaseCharacter::Attack()
 {
 	if (CombatTarget && CombatTarget->ActorHasTag(FName("Dead")))
@@ -53,14 +102,24 @@ void ABaseCharacter::Die_Implementation()
 	PlayDeathMontage();	
 }
 
-void ABaseCharacter::PlayHitReactMontage(const FName& SectionName)
+void ABaseCharacter::Revive()
 {
-	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-	if (AnimInstance && HitReactMontage)
+	Tags.Remove(FName("Dead"));
+
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		AnimInstance->Montage_Play(HitReactMontage);
-		AnimInstance->Montage_JumpToSection(SectionName, HitReactMontage);
+		AnimInstance->StopAllMontages(0.f);
 	}
+
+	// Die() turns collision off, put back whatever the class had
+	const ABaseCharacter* Defaults = GetClass()->GetDefaultObject<ABaseCharacter>();
+	GetCapsuleComponent()->SetCollisionEnabled(Defaults->GetCapsuleComponent()->GetCollisionEnabled());
+	GetMesh()->SetCollisionEnabled(Defaults->GetMesh()->GetCollisionEnabled());
+}
+
+void ABaseCharacter::PlayHitReactMontage(const FName& SectionName)
+{
+	PlayMontageSection(USlashAssetPreloadSubsystem::GetOrLoad(HitReactMontage), SectionName);
 }
 
 void ABaseCharacter::DirectionalHitReact(const FVector& ImpactPoint)
@@ -100,22 +159,25 @@ void ABaseCharacter::DirectionalHitReact(const FVector& ImpactPoint)
 		Section = FName("FromRight");
 	}
 
+	SLASH_DEBUG_ARROW(this, Combat, GetActorLocation(), GetActorLocation() + Forward * 60.f, FColor::Red);
+	SLASH_DEBUG_ARROW(this, Combat, GetActorLocation(), GetActorLocation() + ToHit * 60.f, FColor::Green);
+
 	PlayHitReactMontage(Section);
 }
 
 void ABaseCharacter::PlayHitSound(const FVector& ImpactPoint)
 {
-	if (HitSound)
+	if (USlashFeedbackSubsystem* Feedback = GetWorld()->GetSubsystem<USlashFeedbackSubsystem>())
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, HitSound, ImpactPoint);
+		Feedback->PlaySound(USlashAssetPreloadSubsystem::GetIfResident(HitSound), ImpactPoint);
 	}
 }
 
 void ABaseCharacter::SpawnHitParticles(const FVector& ImpactPoint)
 {
-	if (HitParticles)
+	if (USlashFeedbackSubsystem* Feedback = GetWorld()->GetSubsystem<USlashFeedbackSubsystem>())
 	{
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), HitParticles, ImpactPoint);
+		Feedback->SpawnParticles(USlashAssetPreloadSubsystem::GetIfResident(HitParticles), ImpactPoint);
 	}
 }
 
@@ -149,25 +211,42 @@ int32 ABaseCharacter::PlayRandomMontageSection(UAnimMontage* Montage, const TArr
 
 int32 ABaseCharacter::PlayAttackMontage()
 {
-	return PlayRandomMontageSection(AttackMontage, AttackMontageSections);
+	return PlayRandomMontageSection(USlashAssetPreloadSubsystem::GetOrLoad(AttackMontage), AttackMontageSections);
+}
+
+void ABaseCharacter::PlayAttackMontageSection(int32 Selection)
+{
+	if (AttackMontageSections.IsValidIndex(Selection))
+	{
+		PlayMontageSection(USlashAssetPreloadSubsystem::GetOrLoad(AttackMontage), AttackMontageSections[Selection]);
+	}
 }
 
 int32 ABaseCharacter::PlayDeathMontage()
 {
-	return PlayRandomMontageSection(DeathMontage, DeathMontageSections);
+	return PlayRandomMontageSection(USlashAssetPreloadSubsystem::GetOrLoad(DeathMontage), DeathMontageSections);
+}
+
+void ABaseCharacter::PlayDeathMontageSection(int32 Selection)
+{
+	if (DeathMontageSections.IsValidIndex(Selection))
+	{
+		PlayMontageSection(USlashAssetPreloadSubsystem::GetOrLoad(DeathMontage), DeathMontageSections[Selection]);
+	}
 }
 
 void ABaseCharacter::PlayDodgeMontage()
 {
-	PlayMontageSection(DodgeMontage, FName("Default"));
+	PlayMontageSection(USlashAssetPreloadSubsystem::GetOrLoad(DodgeMontage), FName("Default"));
 }
 
 void ABaseCharacter::StopAttackMontage()
 {
+	// Not resident means not playing; a null montage would stop every montage
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-	if (AnimInstance)
+	if (AnimInstance && AttackMontage.Get())
 	{
-		AnimInstance->Montage_Stop(0.25f, AttackMontage);
+		AnimInstance->Montage_Stop(0.25f, AttackMontage.Get());
 	}
 }
 
@@ -231,9 +310,17 @@ void ABaseCharacter::Tick(float DeltaTime)
 
 void ABaseCharacter::SetWeaponCollisionEnabled(ECollisionEnabled::Type CollisionEnabled)
 {
+	// Simulated proxies replay swings for the animation only, their hits come from the server or the owner
+	if (GetLocalRole() == ROLE_SimulatedProxy && CollisionEnabled != ECollisionEnabled::NoCollision)
+		return;
+
 	if (EquippedWeapon && EquippedWeapon->GetWeaponBox())
 	{
 		EquippedWeapon->GetWeaponBox()->SetCollisionEnabled(CollisionEnabled);
-		EquippedWeapon->IgnoreActors.Empty();
+		// Kept after the window closes, so a late hit claim for this swing is still rejected
+		if (CollisionEnabled != ECollisionEnabled::NoCollision)
+		{
+			EquippedWeapon->IgnoreActors.Empty();
+		}
 	}
 }
@@ -7,15 +7,75 @@
 #include "EnhancedInputSubsystems.h"
 #include "GroomComponent.h"
 #include "Camera/CameraComponent.h"
+#include "Engine/AssetManager.h"
 #include "Components/AttributeComponent.h"
 #include "Components/BoxComponent.h"
+#include "Components/LockOnComponent.h"
+#include "Components/SlashBotComponent.h"
+#include "Enemy/Enemy.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "HUD/SlashHUD.h"
 #include "HUD/SlashOverlay.h"
+#include "Items/PickupSubsystem.h"
 #include "Items/Soul.h"
 #include "Items/Treasure.h"
 #include "Items/Weapons/Weapon.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/SlashRewindSubsystem.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Slash/Slash.h"
+#include "World/SlashAssetPreloadSubsystem.h"
+#include "World/SlashCheckpointSubsystem.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Predicted Actions Confirmed"), STAT_PredictionConfirmed, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Predicted Actions Rolled Back"), STAT_PredictionRolledBack, STATGROUP_Slash);
+
+CSV_DEFINE_CATEGORY(SlashPrediction, true);
+
+namespace SlashPrediction
+{
+	static float EndTolerance = 0.15f;
+	static FAutoConsoleVariableRef CVarEndTolerance(
+		TEXT("Slash.Prediction.EndTolerance"),
+		EndTolerance,
+		TEXT("Seconds before the end of its attack or dodge montage at which the server already accepts the owner's next action."));
+
+	/** Sections of an EPA_Interact multicast */
+	static constexpr int8 InteractPickUp = 0;
+	static constexpr int8 InteractDisarm = 1;
+	static constexpr int8 InteractArm = 2;
+
+	static int32 NumConfirmed = 0;
+	static int32 NumRolledBack = 0;
+	static double TotalConfirmSeconds = 0.0;
+
+	/** Owning client: logs a running summary, so -SlashBot runs under NetEmulation show rollbacks and confirm latency */
+	static void RecordAck(bool bAccepted, double ConfirmSeconds)
+	{
+		if (bAccepted)
+		{
+			++NumConfirmed;
+			INC_DWORD_STAT(STAT_PredictionConfirmed);
+		}
+		else
+		{
+			++NumRolledBack;
+			INC_DWORD_STAT(STAT_PredictionRolledBack);
+		}
+		TotalConfirmSeconds += ConfirmSeconds;
+		CSV_CUSTOM_STAT(SlashPrediction, ConfirmMs, ConfirmSeconds * 1000.0, ECsvCustomStatOp::Set);
+
+		const int32 NumAcks = NumConfirmed + NumRolledBack;
+		if (NumAcks % 50 == 0)
+		{
+			UE_LOG(LogSlash, Log, TEXT("Prediction - %d confirmed, %d rolled back, confirm avg %.1f ms"),
+			       NumConfirmed, NumRolledBack, TotalConfirmSeconds * 1000.0 / NumAcks);
+		}
+	}
+}
 
 // Sets default values
 ASlashCharacter::ASlashCharacter()
@@ -52,16 +112,78 @@ ASlashCharacter::ASlashCharacter()
 	Eyebrows = CreateDefaultSubobject<UGroomComponent>(TEXT("Eyebrows"));
 	Eyebrows->SetupAttachment(GetMesh());
 	Eyebrows->AttachmentName = FString("head");
+
+	LockOn = CreateDefaultSubobject<ULockOnComponent>(TEXT("LockOn"));
+}
+
+void ASlashCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	Params.Condition = COND_SkipOwner;
+	DOREPLIFETIME_WITH_PARAMS_FAST(ASlashCharacter, CharacterState, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ASlashCharacter, ActionState, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(ASlashCharacter, EquippedWeaponClass, Params);
+}
+
+void ASlashCharacter::SetCharacterState(ECharacterState NewState)
+{
+	if (CharacterState == NewState)
+		return;
+
+	CharacterState = NewState;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ASlashCharacter, CharacterState, this);
+}
+
+void ASlashCharacter::SetEquippedWeaponClass(TSubclassOf<AWeapon> NewClass)
+{
+	if (!HasAuthority() || EquippedWeaponClass == NewClass)
+		return;
+
+	EquippedWeaponClass = NewClass;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ASlashCharacter, EquippedWeaponClass, this);
+}
+
+void ASlashCharacter::OnRep_EquippedWeaponClass()
+{
+	if (EquippedWeapon)
+	{
+		EquippedWeapon->Destroy();
+		EquippedWeapon = nullptr;
+	}
+	if (EquippedWeaponClass == nullptr)
+		return;
+
+	EquippedWeapon = AWeapon::SpawnEquipped(EquippedWeaponClass, GetMesh(), FName("RightHandSocket"), this, this);
+	if (EquippedWeapon)
+	{
+		AttachWeaponForState();
+	}
+}
+
+void ASlashCharacter::SetActionState(EActionState NewState)
+{
+	if (ActionState == NewState)
+		return;
+
+	ActionState = NewState;
+	MARK_PROPERTY_DIRTY_FROM_NAME(ASlashCharacter, ActionState, this);
 }
 
 void ASlashCharacter::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	if (Attributes && SlashOverlay)
+	// The server checks stamina for every player, the owner predicts it; neither needs a HUD for that
+	if (Attributes && (HasAuthority() || IsLocallyControlled()))
 	{
 		Attributes->RegenStamina(DeltaTime);
-		SlashOverlay->SetStaminaBarPercent(Attributes->GetStaminaPercent());
+		if (SlashOverlay)
+		{
+			SlashOverlay->SetStaminaBarPercent(Attributes->GetStaminaPercent());
+		}
 	}
 }
 
@@ -84,7 +206,32 @@ void ASlashCharacter::BeginPlay()
 
 	Tags.Add(FName("EngageableTarget"));
 
+	// Dedicated servers and -nullrhi bots never draw the hair
+	if (!FApp::CanEverRender())
+	{
+		Hair->DestroyComponent();
+		Eyebrows->DestroyComponent();
+	}
+
+	if (IsLocallyControlled() && USlashBotComponent::IsBotClient())
+	{
+		NewObject<USlashBotComponent>(this, TEXT("Bot"))->RegisterComponent();
+	}
+
 	InitializeSlashOverlay();
+
+	LockOn->OnTargetChanged.AddUObject(this, &ASlashCharacter::OnLockOnTargetChanged);
+
+	if (Attributes)
+	{
+		Attributes->OnAttributesChanged.AddUObject(this, &ASlashCharacter::OnAttributesChanged);
+	}
+
+	// Remote clients get their attributes from the server
+	if (Attributes && !HasAuthority())
+	{
+		Attributes->OnAttributesReplicated.AddUObject(this, &ASlashCharacter::RefreshSlashOverlay);
+	}
 }
 
 void ASlashCharacter::Move(const FInputActionValue& Value)
@@ -107,8 +254,8 @@ void ASlashCharacter::Move(const FInputActionValue& Value)
 	// Stop AttackMontage
 	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
 	{
-		if (AnimInstance->Montage_IsPlaying(AttackMontage))
-			AnimInstance->Montage_Stop(0.2f, AttackMontage);
+		if (AttackMontage.Get() && AnimInstance->Montage_IsPlaying(AttackMontage.Get()))
+			AnimInstance->Montage_Stop(0.2f, AttackMontage.Get());
 	}
 }
 
@@ -128,15 +275,34 @@ void ASlashCharacter::Look(const FInputActionValue& Value)
 }
 
 void ASlashCharacter::EKeyPressed()
+{
+	if (CanPerformAction(EPredictedAction::EPA_Interact))
+	{
+		RunAction(EPredictedAction::EPA_Interact, INDEX_NONE, GetActorRotation().Yaw);
+	}
+}
+
+void ASlashCharacter::Interact()
 {
 	if (AWeapon* OverlappingWeapon = Cast<AWeapon>(OverlappingItem))
 	{
-		if (EquippedWeapon)
+		if (HasAuthority())
 		{
-			EquippedWeapon->Destroy();
+			if (EquippedWeapon)
+			{
+				EquippedWeapon->Destroy();
+			}
+			EquipWeapon(OverlappingWeapon);
+			return;
 		}
 
-		EquipWeapon(OverlappingWeapon);
+		// Predicted: the old weapon and the pickup are only put aside until the server acks, see ClientAckAction
+		if (EquippedWeapon)
+		{
+			SetWeaponSuspended(EquippedWeapon, true);
+		}
+		OverlappingWeapon->SetItemActive(false);
+		EquipWeapon(OverlappingWeapon, false);
 	}
 	else
 	{
@@ -156,8 +322,10 @@ void ASlashCharacter::Attack()
 	Super::Attack();
 	if (CanAttack())
 	{
-		PlayAttackMontage();
-		ActionState = EActionState::EAS_Attacking;
+		// 섹션은 여기서 골라야 서버와 다른 클라이언트도 같은 공격을 재생합니다
+		const int32 Section = AttackMontageSections.Num() > 0 ? FMath::RandRange(0, AttackMontageSections.Num() - 1) : INDEX_NONE;
+		const float Yaw = CombatTarget ? (CombatTarget->GetActorLocation() - GetActorLocation()).Rotation().Yaw : GetActorRotation().Yaw;
+		RunAction(EPredictedAction::EPA_Attack, Section, Yaw);
 	}
 }
 
@@ -166,9 +334,22 @@ bool ASlashCharacter::HasEnoughStamina(float StaminaCost)
 	return Attributes && Attributes->GetStamina() >= StaminaCost;
 }
 
+void ASlashCharacter::ToggleLockOn()
+{
+	LockOn->ToggleLockOn();
+}
+
+/**
+ * 락온 대상이 공격의 CombatTarget이 되어 모션 워핑 타겟으로 쓰입니다.
+ */
+void ASlashCharacter::OnLockOnTargetChanged(AActor* NewTarget)
+{
+	CombatTarget = NewTarget;
+}
+
 void ASlashCharacter::Dodge()
 {
-	if (!IsUnoccupied() || Attributes == nullptr || !HasEnoughStamina(Attributes->GetDodgeCost()))
+	if (!CanPerformAction(EPredictedAction::EPA_Dodge))
 		return;
 
 	// 마지막 방향 입력 방향으로 캐릭터를 회전시킴
@@ -177,37 +358,316 @@ void ASlashCharacter::Dodge()
 	{
 		LastInputVector = GetActorForwardVector();
 	}
-	FRotator DodgeRotation = FRotator(0, LastInputVector.Rotation().Yaw, 0);
-	SetActorRotation(DodgeRotation);
+	RunAction(EPredictedAction::EPA_Dodge, INDEX_NONE, LastInputVector.Rotation().Yaw);
+}
 
-	PlayDodgeMontage();
-	ActionState = EActionState::EAS_Dodge;
+void ASlashCharacter::RunAction(EPredictedAction Action, int32 Section, float Yaw)
+{
+	if (HasAuthority())
+	{
+		const int8 PlayedSection = Action == EPredictedAction::EPA_Interact ? GetInteractSection() : Section;
+		PerformAction(Action, Section, Yaw);
+		MulticastPlayAction(Action, PlayedSection);
+		return;
+	}
 
-	Attributes->UseStamina(Attributes->GetDodgeCost());
-	if (SlashOverlay)
+	// Owning client: play it now, ClientAckAction confirms or rolls it back a round trip later
+	FPendingAction Pending;
+	Pending.Id = ++LastPredictionId;
+	Pending.Action = Action;
+	Pending.StaminaCost = Action == EPredictedAction::EPA_Dodge && Attributes ? Attributes->GetDodgeCost() : 0.f;
+	Pending.SentTime = FPlatformTime::Seconds();
+	if (Action == EPredictedAction::EPA_Interact)
 	{
-		SlashOverlay->SetStaminaBarPercent(Attributes->GetStaminaPercent());
+		Pending.PreviousWeapon = EquippedWeapon;
+		Pending.PickedUpWeapon = Cast<AWeapon>(OverlappingItem);
+	}
+	PendingActions.Add(Pending);
+
+	PerformAction(Action, Section, Yaw);
+	if (Attributes)
+	{
+		Attributes->SetPredictedStaminaCost(GetPendingStaminaCost());
+	}
+
+	ServerRunAction(Action, Pending.Id, static_cast<int8>(Section), Yaw);
+}
+
+bool ASlashCharacter::CanPerformAction(EPredictedAction Action)
+{
+	switch (Action)
+	{
+	case EPredictedAction::EPA_Attack:
+		return CanAttack();
+	case EPredictedAction::EPA_Dodge:
+		return IsUnoccupied() && Attributes && HasEnoughStamina(Attributes->GetDodgeCost());
+	case EPredictedAction::EPA_Interact:
+		return Cast<AWeapon>(OverlappingItem) || CanDisArm() || CanArm();
+	}
+	return false;
+}
+
+void ASlashCharacter::PerformAction(EPredictedAction Action, int32 Section, float Yaw)
+{
+	switch (Action)
+	{
+	case EPredictedAction::EPA_Attack:
+		SetActorRotation(FRotator(0, Yaw, 0));
+		PlayAttackMontageSection(Section);
+		SetActionState(EActionState::EAS_Attacking);
+		break;
+
+	case EPredictedAction::EPA_Dodge:
+		SetActorRotation(FRotator(0, Yaw, 0));
+		PlayDodgeMontage();
+		SetActionState(EActionState::EAS_Dodge);
+
+		Attributes->UseStamina(Attributes->GetDodgeCost());
+		if (SlashOverlay)
+		{
+			SlashOverlay->SetStaminaBarPercent(Attributes->GetStaminaPercent());
+		}
+		break;
+
+	case EPredictedAction::EPA_Interact:
+		Interact();
+		break;
+	}
+}
+
+void ASlashCharacter::FinishEndingAction()
+{
+	// The owner ends its montages locally, so its next action can arrive just before our own AttackEnd/DodgeEnd notify
+	if (ActionState != EActionState::EAS_Attacking && ActionState != EActionState::EAS_Dodge)
+		return;
+
+	UAnimMontage*         Montage = ActionState == EActionState::EAS_Attacking ? AttackMontage.Get() : DodgeMontage.Get();
+	UAnimInstance*        AnimInstance = GetMesh()->GetAnimInstance();
+	FAnimMontageInstance* Instance = AnimInstance && Montage ? AnimInstance->GetActiveInstanceForMontage(Montage) : nullptr;
+	if (Instance)
+	{
+		float       SectionStart = 0.f;
+		float       SectionEnd = 0.f;
+		const float Position = Instance->GetPosition();
+		Montage->GetSectionStartAndEndTime(Montage->GetSectionIndexFromPosition(Position), SectionStart, SectionEnd);
+		if (Instance->IsPlaying() && SectionEnd - Position > SlashPrediction::EndTolerance)
+			return;
+	}
+
+	if (ActionState == EActionState::EAS_Attacking)
+	{
+		AttackEnd();
+	}
+	else
+	{
+		DodgeEnd();
+	}
+}
+
+void ASlashCharacter::ServerRunAction_Implementation(EPredictedAction Action, uint16 PredictionId, int8 Section, float Yaw)
+{
+	FinishEndingAction();
+
+	const bool bAccepted = CanPerformAction(Action);
+	if (bAccepted)
+	{
+		const int8 PlayedSection = Action == EPredictedAction::EPA_Interact ? GetInteractSection() : Section;
+		PerformAction(Action, Section, Yaw);
+		MulticastPlayAction(Action, PlayedSection);
+	}
+
+	ClientAckAction(PredictionId, bAccepted, ActionState, CharacterState, Attributes ? Attributes->GetStamina() : 0.f);
+}
+
+void ASlashCharacter::ClientAckAction_Implementation(uint16 PredictionId, bool bAccepted, EActionState ServerActionState, ECharacterState ServerCharacterState, float ServerStamina)
+{
+	const int32 Index = PendingActions.IndexOfByPredicate([PredictionId](const FPendingAction& Pending) { return Pending.Id == PredictionId; });
+	if (Index == INDEX_NONE)
+		return;
+
+	const FPendingAction Acked = PendingActions[Index];
+	PendingActions.RemoveAt(Index);
+	SlashPrediction::RecordAck(bAccepted, FPlatformTime::Seconds() - Acked.SentTime);
+
+	if (Acked.Action == EPredictedAction::EPA_Interact)
+	{
+		if (bAccepted)
+		{
+			ConfirmInteract(Acked);
+		}
+		else
+		{
+			RollBackInteract(Acked);
+		}
+	}
+
+	// Later predictions are still in flight and get their own ack, only the newest one may decide the current state
+	if (!bAccepted && PendingActions.Num() == Index)
+	{
+		if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+		{
+			if (Acked.Action == EPredictedAction::EPA_Attack && AttackMontage.Get())
+			{
+				AnimInstance->Montage_Stop(0.1f, AttackMontage.Get());
+			}
+			else if (Acked.Action == EPredictedAction::EPA_Dodge && DodgeMontage.Get())
+			{
+				AnimInstance->Montage_Stop(0.1f, DodgeMontage.Get());
+			}
+			else if (Acked.Action == EPredictedAction::EPA_Interact && EquipMontage.Get())
+			{
+				AnimInstance->Montage_Stop(0.1f, EquipMontage.Get());
+			}
+		}
+		SetActionState(ServerActionState);
+		SetCharacterState(ServerCharacterState);
+		if (Acked.Action == EPredictedAction::EPA_Interact)
+		{
+			AttachWeaponForState();
+		}
+	}
+
+	if (Attributes)
+	{
+		Attributes->SetPredictedStaminaCost(GetPendingStaminaCost());
+		Attributes->ReconcileStamina(ServerStamina);
+		RefreshSlashOverlay();
 	}
 }
 
-void ASlashCharacter::EquipWeapon(AWeapon* Weapon)
+float ASlashCharacter::GetPendingStaminaCost() const
 {
-	AWeapon* NewWeapon = Weapon->Equip(GetMesh(), FName("RightHandSocket"), this, this);
-	CharacterState = ECharacterState::ECS_EquippedOneHandedWeapon;
+	float PendingCost = 0.f;
+	for (const FPendingAction& Pending : PendingActions)
+	{
+		PendingCost += Pending.StaminaCost;
+	}
+	return PendingCost;
+}
+
+void ASlashCharacter::MulticastPlayAction_Implementation(EPredictedAction Action, int8 Section)
+{
+	// Server and owner already played it, the state itself arrives through ActionState
+	if (HasAuthority() || IsLocallyControlled())
+		return;
+
+	if (Action == EPredictedAction::EPA_Attack)
+	{
+		PlayAttackMontageSection(Section);
+	}
+	else if (Action == EPredictedAction::EPA_Dodge)
+	{
+		PlayDodgeMontage();
+	}
+	else if (Action == EPredictedAction::EPA_Interact)
+	{
+		// A picked up weapon arrives through EquippedWeaponClass, the montage notifies move it between back and hand
+		if (Section == SlashPrediction::InteractDisarm)
+		{
+			PlayEquipMontage(FName("Unequip"));
+		}
+		else if (Section == SlashPrediction::InteractArm)
+		{
+			PlayEquipMontage(FName("Equip"));
+		}
+	}
+}
+
+int8 ASlashCharacter::GetInteractSection()
+{
+	if (Cast<AWeapon>(OverlappingItem))
+		return SlashPrediction::InteractPickUp;
+	if (CanDisArm())
+		return SlashPrediction::InteractDisarm;
+	if (CanArm())
+		return SlashPrediction::InteractArm;
+	return INDEX_NONE;
+}
+
+void ASlashCharacter::ConfirmInteract(const FPendingAction& Acked)
+{
+	if (Acked.PickedUpWeapon.IsValid())
+	{
+		Acked.PickedUpWeapon->Consume();
+	}
+	if (Acked.PreviousWeapon.IsValid() && Acked.PreviousWeapon.Get() != EquippedWeapon)
+	{
+		Acked.PreviousWeapon->Destroy();
+	}
+}
+
+void ASlashCharacter::RollBackInteract(const FPendingAction& Acked)
+{
+	// Only a pickup swapped weapons, arming and disarming just move the same one
+	if (!Acked.PickedUpWeapon.IsValid())
+		return;
+
+	// The predicted instance takes its modifiers with it in EndPlay
+	if (EquippedWeapon && EquippedWeapon != Acked.PreviousWeapon.Get())
+	{
+		EquippedWeapon->Destroy();
+	}
+	EquippedWeapon = Acked.PreviousWeapon.Get();
+	if (EquippedWeapon)
+	{
+		SetWeaponSuspended(EquippedWeapon, false);
+	}
+
+	// Someone else may have taken it meanwhile
+	Acked.PickedUpWeapon->RevertItemActive();
+	if (Acked.PickedUpWeapon->IsItemActive())
+	{
+		OverlappingItem = Acked.PickedUpWeapon.Get();
+	}
+}
+
+void ASlashCharacter::SetWeaponSuspended(AWeapon* Weapon, bool bSuspended)
+{
+	Weapon->SetActorHiddenInGame(bSuspended);
+	if (Attributes == nullptr)
+		return;
+
+	if (bSuspended)
+	{
+		Attributes->RemoveModifiers(Weapon);
+	}
+	else
+	{
+		Attributes->AddModifiers(Weapon->GetAttributeModifiers(), Weapon);
+	}
+}
+
+void ASlashCharacter::AttachWeaponForState()
+{
+	if (CharacterState == ECharacterState::ECS_Unequipped)
+	{
+		AttachWeaponToBack();
+	}
+	else
+	{
+		AttachWeaponToHand();
+	}
+}
+
+void ASlashCharacter::EquipWeapon(AWeapon* Weapon, bool bConsume)
+{
+	AWeapon* NewWeapon = Weapon->Equip(GetMesh(), FName("RightHandSocket"), this, this, bConsume);
+	SetEquippedWeaponClass(NewWeapon ? NewWeapon->GetClass() : nullptr);
+	SetCharacterState(ECharacterState::ECS_EquippedOneHandedWeapon);
 	OverlappingItem = nullptr;
 	EquippedWeapon = NewWeapon;
 }
 
 void ASlashCharacter::AttackEnd()
 {
-	ActionState = EActionState::EAS_Unoccupied;
+	SetActionState(EActionState::EAS_Unoccupied);
 }
 
 void ASlashCharacter::DodgeEnd()
 {
 	Super::DodgeEnd();
 
-	ActionState = EActionState::EAS_Unoccupied;
+	SetActionState(EActionState::EAS_Unoccupied);
 }
 
 bool ASlashCharacter::CanAttack()
@@ -228,23 +688,24 @@ bool ASlashCharacter::CanArm()
 void ASlashCharacter::DisArm()
 {
 	PlayEquipMontage(FName("Unequip"));
-	CharacterState = ECharacterState::ECS_Unequipped;
-	ActionState = EActionState::EAS_EquippingWeapon;
+	SetCharacterState(ECharacterState::ECS_Unequipped);
+	SetActionState(EActionState::EAS_EquippingWeapon);
 }
 
 void ASlashCharacter::Arm()
 {
 	PlayEquipMontage(FName("Equip"));
-	CharacterState = ECharacterState::ECS_EquippedOneHandedWeapon;
-	ActionState = EActionState::EAS_EquippingWeapon;
+	SetCharacterState(ECharacterState::ECS_EquippedOneHandedWeapon);
+	SetActionState(EActionState::EAS_EquippingWeapon);
 }
 
 void ASlashCharacter::PlayEquipMontage(const FName& SectionName)
 {
-	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance(); AnimInstance && EquipMontage)
+	UAnimMontage* Montage = USlashAssetPreloadSubsystem::GetOrLoad(EquipMontage);
+	if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance(); AnimInstance && Montage)
 	{
-		AnimInstance->Montage_Play(EquipMontage);
-		AnimInstance->Montage_JumpToSection(SectionName, EquipMontage);
+		AnimInstance->Montage_Play(Montage);
+		AnimInstance->Montage_JumpToSection(SectionName, Montage);
 	}
 }
 
@@ -252,8 +713,27 @@ void ASlashCharacter::Die_Implementation()
 {
 	Super::Die_Implementation();
 
-	ActionState = EActionState::EAS_Dead;
+	SetActionState(EActionState::EAS_Dead);
 	DisableMeshCollision();
+
+	GetWorldTimerManager().SetTimer(RespawnTimer, this, &ASlashCharacter::RespawnAtCheckpoint, RespawnDelay);
+}
+
+void ASlashCharacter::Revive()
+{
+	Super::Revive();
+
+	GetWorldTimerManager().ClearTimer(RespawnTimer);
+	SetActionState(EActionState::EAS_Unoccupied);
+}
+
+void ASlashCharacter::RespawnAtCheckpoint()
+{
+	USlashCheckpointSubsystem* Checkpoint = GetWorld()->GetSubsystem<USlashCheckpointSubsystem>();
+	if (Checkpoint && Checkpoint->HasCheckpoint())
+	{
+		Checkpoint->RestoreCheckpoint();
+	}
 }
 
 void ASlashCharacter::AttachWeaponToBack()
@@ -274,12 +754,12 @@ void ASlashCharacter::AttachWeaponToHand()
 
 void ASlashCharacter::FinishEquipping()
 {
-	ActionState = EActionState::EAS_Unoccupied;
+	SetActionState(EActionState::EAS_Unoccupied);
 }
 
 void ASlashCharacter::HitReactEnd()
 {
-	ActionState = EActionState::EAS_Unoccupied;
+	SetActionState(EActionState::EAS_Unoccupied);
 }
 
 bool ASlashCharacter::IsUnoccupied()
@@ -305,6 +785,26 @@ void ASlashCharacter::InitializeSlashOverlay()
 	}
 }
 
+void ASlashCharacter::RefreshSlashOverlay()
+{
+	if (SlashOverlay && Attributes)
+	{
+		SlashOverlay->SetHealthBarPercent(Attributes->GetHealthPercent());
+		SlashOverlay->SetStaminaBarPercent(Attributes->GetStaminaPercent());
+		SlashOverlay->SetGold(Attributes->GetGold());
+		SlashOverlay->SetSouls(Attributes->GetSouls());
+	}
+}
+
+void ASlashCharacter::OnAttributesChanged(uint32 ChangedMask)
+{
+	// Stamina alone changes every frame while regenerating, Tick keeps that bar current
+	if (ChangedMask & ~FSlashAttributeSet::Bit(ESlashAttribute::ESA_Stamina))
+	{
+		RefreshSlashOverlay();
+	}
+}
+
 void ASlashCharacter::SetHUDHealth()
 {
 	if (SlashOverlay && Attributes)
@@ -327,6 +827,7 @@ void ASlashCharacter::SetupPlayerInputComponent(
 		EnhancedInputComponent->BindAction(EKeyAction, ETriggerEvent::Triggered, this, &ASlashCharacter::EKeyPressed);
 		EnhancedInputComponent->BindAction(AttackAction, ETriggerEvent::Triggered, this, &ASlashCharacter::Attack);
 		EnhancedInputComponent->BindAction(DodgeAction, ETriggerEvent::Triggered, this, &ASlashCharacter::Dodge);
+		EnhancedInputComponent->BindAction(LockOnAction, ETriggerEvent::Started, this, &ASlashCharacter::ToggleLockOn);
 	}
 }
 
@@ -351,7 +852,7 @@ void ASlashCharacter::GetHit_Implementation(const FVector& ImpactPoint, AActor*
 
 	if (Attributes && Attributes->GetHealthPercent() > 0.f)
 	{
-		ActionState = EActionState::EAS_HitReaction;
+		SetActionState(EActionState::EAS_HitReaction);
 	}
 }
 
@@ -360,21 +861,133 @@ void ASlashCharacter::SetOverlappingItem(AItem* Item)
 	OverlappingItem = Item;
 }
 
-void ASlashCharacter::AddSouls(ASoul* Soul)
+void ASlashCharacter::AddSouls(int32 NumberOfSouls)
 {
-	if (Attributes && SlashOverlay)
+	// Also granted on the server for remote players, who have no overlay there
+	if (Attributes)
 	{
-		Attributes->AddSouls(Soul->GetSouls());
-		SlashOverlay->SetSouls(Attributes->GetSouls());
+		Attributes->AddSouls(NumberOfSouls);
+		RefreshSlashOverlay();
+	}
+}
+
+void ASlashCharacter::AddGold(int32 AmountOfGold)
+{
+	if (Attributes)
+	{
+		Attributes->AddGold(AmountOfGold);
+		RefreshSlashOverlay();
 	}
+}
 
+void ASlashCharacter::ServerCollectPickup_Implementation(uint32 PickupId)
+{
+	if (UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>())
+	{
+		Pickups->Collect(PickupId, this);
+	}
 }
 
-void ASlashCharacter::AddGold(ATreasure* Treasure)
+void ASlashCharacter::SerializeSaveData(FArchive& Ar)
 {
-	if (Attributes && SlashOverlay)
+	if (Attributes)
 	{
-		Attributes->AddGold(Treasure->GetGold());
-		SlashOverlay->SetGold(Attributes->GetGold());
+		Attributes->SerializeSaveData(Ar);
+	}
+
+	uint8          SavedCharacterState = static_cast<uint8>(CharacterState);
+	FSoftClassPath WeaponClassPath = EquippedWeapon ? FSoftClassPath(EquippedWeapon->GetClass()) : FSoftClassPath();
+	Ar << SavedCharacterState;
+	Ar << WeaponClassPath;
+
+	if (Ar.IsLoading() && !Ar.IsError())
+	{
+		RestoreEquippedWeapon(WeaponClassPath, static_cast<ECharacterState>(SavedCharacterState));
+		RefreshSlashOverlay();
+	}
+}
+
+void ASlashCharacter::RestoreEquippedWeapon(const FSoftClassPath& WeaponClassPath, ECharacterState SavedCharacterState)
+{
+	if (WeaponClassPath.IsNull())
+	{
+		if (EquippedWeapon)
+		{
+			EquippedWeapon->Destroy();
+			EquippedWeapon = nullptr;
+		}
+		SetEquippedWeaponClass(nullptr);
+		SetCharacterState(ECharacterState::ECS_Unequipped);
+		return;
+	}
+
+	// 같은 무기를 들고 있으면 다시 스폰하지 않음
+	if (EquippedWeapon && FSoftClassPath(EquippedWeapon->GetClass()) == WeaponClassPath)
+	{
+		SetCharacterState(SavedCharacterState);
+		AttachWeaponForState();
+		return;
+	}
+
+	// 무기 클래스는 비동기로 로드해서 로딩 중 프레임이 멈추지 않도록 함
+	UAssetManager::GetStreamableManager().RequestAsyncLoad(WeaponClassPath, FStreamableDelegate::CreateWeakLambda(this, [this, WeaponClassPath, SavedCharacterState]()
+	{
+		UClass* WeaponClass = WeaponClassPath.ResolveClass();
+		if (WeaponClass == nullptr || !WeaponClass->IsChildOf(AWeapon::StaticClass()))
+			return;
+
+		AWeapon* Weapon = AWeapon::SpawnEquipped(WeaponClass, GetMesh(), FName("RightHandSocket"), this, this);
+		if (Weapon == nullptr)
+			return;
+
+		if (EquippedWeapon)
+		{
+			EquippedWeapon->Destroy();
+		}
+		EquippedWeapon = Weapon;
+		SetEquippedWeaponClass(WeaponClass);
+		OverlappingItem = nullptr;
+
+		SetCharacterState(SavedCharacterState);
+		if (CharacterState == ECharacterState::ECS_Unequipped)
+		{
+			AttachWeaponToBack();
+		}
+	}));
+}
+
+void ASlashCharacter::ClaimHit(AActor* HitActor, const FVector& TraceStart, const FVector& TraceEnd, const FVector& ImpactPoint)
+{
+	// The server time of what this client was looking at when it swung, i.e. the moment the server should rewind to
+	double ClientTime;
+	if (const AEnemy* Enemy = Cast<AEnemy>(HitActor))
+	{
+		ClientTime = Enemy->GetDisplayedServerTime();
+	}
+	else
+	{
+		const AGameStateBase* GameState = GetWorld()->GetGameState();
+		ClientTime = GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+	}
+
+	ServerClaimHit(HitActor, TraceStart, TraceEnd, ImpactPoint, ClientTime);
+}
+
+void ASlashCharacter::ServerClaimHit_Implementation(AActor* HitActor, FVector_NetQuantize TraceStart, FVector_NetQuantize TraceEnd, FVector_NetQuantize ImpactPoint, double ClientTime)
+{
+	USlashRewindSubsystem* Rewind = GetWorld()->GetSubsystem<USlashRewindSubsystem>();
+	if (EquippedWeapon == nullptr || HitActor == nullptr || HitActor == this || Rewind == nullptr || ActionState == EActionState::EAS_Dead)
+		return;
+
+	// Only during a swing, and each actor once per swing like a locally traced hit
+	const bool bHitWindowActive = ActionState == EActionState::EAS_Attacking
+		|| EquippedWeapon->GetWeaponBox()->GetCollisionEnabled() != ECollisionEnabled::NoCollision;
+	if (!bHitWindowActive || EquippedWeapon->ActorIsSameType(HitActor) || EquippedWeapon->IgnoreActors.Contains(HitActor))
+		return;
+
+	if (Rewind->ValidateHit(this, HitActor, TraceStart, TraceEnd, EquippedWeapon->GetTraceRadius(), ClientTime))
+	{
+		EquippedWeapon->ApplyHit(HitActor, ImpactPoint);
+		EquippedWeapon->IgnoreActors.AddUnique(HitActor);
 	}
-}
\ No newline at end of file
+}
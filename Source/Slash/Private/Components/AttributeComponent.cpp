@@ -3,54 +3,241 @@
 
 #include "Components/AttributeComponent.h"
 
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+bool FReplicatedAttributes::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint16 QuantizedHealth = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Health * 10.f), 0, MAX_uint16));
+	uint16 QuantizedStamina = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt(Stamina * 10.f), 0, MAX_uint16));
+	uint32 PackedGold = static_cast<uint32>(FMath::Max(Gold, 0));
+	uint32 PackedSouls = static_cast<uint32>(FMath::Max(Souls, 0));
+
+	Ar << QuantizedHealth;
+	Ar << QuantizedStamina;
+	Ar.SerializeIntPacked(PackedGold);
+	Ar.SerializeIntPacked(PackedSouls);
+
+	if (Ar.IsLoading())
+	{
+		Health = QuantizedHealth / 10.f;
+		Stamina = QuantizedStamina / 10.f;
+		Gold = static_cast<int32>(PackedGold);
+		Souls = static_cast<int32>(PackedSouls);
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
 UAttributeComponent::UAttributeComponent()
 {
 	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = false;
+	bWantsInitializeComponent = true;
 
-	// ...
+	SetIsReplicatedByDefault(true);
+}
+
+void UAttributeComponent::InitializeComponent()
+{
+	Super::InitializeComponent();
+
+	AttributeSet.SetBase(ESlashAttribute::ESA_Health, Health);
+	AttributeSet.SetBase(ESlashAttribute::ESA_MaxHealth, MaxHealth);
+	AttributeSet.SetBase(ESlashAttribute::ESA_Stamina, Stamina);
+	AttributeSet.SetBase(ESlashAttribute::ESA_MaxStamina, MaxStamina);
+	AttributeSet.SetBase(ESlashAttribute::ESA_StaminaRegenRate, StaminaRegenRate);
+	AttributeSet.SetBase(ESlashAttribute::ESA_DodgeCost, DodgeCost);
+	AttributeSet.SetBase(ESlashAttribute::ESA_DamageScale, DamageScale);
+	AttributeSet.SetBase(ESlashAttribute::ESA_Gold, Gold);
+	AttributeSet.SetBase(ESlashAttribute::ESA_Souls, Souls);
+
+	// Nobody is listening yet
+	AttributeSet.ConsumeChanges();
 }
 
 void UAttributeComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	MarkAttributesDirty();
+}
+
+void UAttributeComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(UAttributeComponent, ReplicatedAttributes, Params);
+}
+
+void UAttributeComponent::MarkAttributesDirty()
+{
+	if (GetOwnerRole() != ROLE_Authority)
+		return;
+
+	FReplicatedAttributes NewAttributes;
+	NewAttributes.Health = FReplicatedAttributes::Quantize(AttributeSet.Get(ESlashAttribute::ESA_Health));
+	NewAttributes.Stamina = FReplicatedAttributes::Quantize(AttributeSet.Get(ESlashAttribute::ESA_Stamina));
+	NewAttributes.Gold = GetGold();
+	NewAttributes.Souls = GetSouls();
+
+	// Regen changes stamina every frame, but only quantization steps are worth sending
+	if (NewAttributes == ReplicatedAttributes)
+		return;
+
+	ReplicatedAttributes = NewAttributes;
+	MARK_PROPERTY_DIRTY_FROM_NAME(UAttributeComponent, ReplicatedAttributes, this);
+}
+
+void UAttributeComponent::OnRep_ReplicatedAttributes()
+{
+	AttributeSet.SetBase(ESlashAttribute::ESA_Health, ReplicatedAttributes.Health);
+	AttributeSet.SetBase(ESlashAttribute::ESA_Stamina, FMath::Max(ReplicatedAttributes.Stamina - PredictedStaminaCost, 0.f));
+	AttributeSet.SetBase(ESlashAttribute::ESA_Gold, ReplicatedAttributes.Gold);
+	AttributeSet.SetBase(ESlashAttribute::ESA_Souls, ReplicatedAttributes.Souls);
+	OnValuesChanged();
+
+	OnAttributesReplicated.Broadcast();
+}
+
+void UAttributeComponent::OnValuesChanged()
+{
+	if (!AttributeSet.HasChanges())
+		return;
+
+	// A lower max, e.g. after unequipping, pulls the current value down with it
+	const float MaxHealthValue = AttributeSet.Get(ESlashAttribute::ESA_MaxHealth);
+	if (AttributeSet.GetBase(ESlashAttribute::ESA_Health) > MaxHealthValue)
+	{
+		AttributeSet.SetBase(ESlashAttribute::ESA_Health, MaxHealthValue);
+	}
+	const float MaxStaminaValue = AttributeSet.Get(ESlashAttribute::ESA_MaxStamina);
+	if (AttributeSet.GetBase(ESlashAttribute::ESA_Stamina) > MaxStaminaValue)
+	{
+		AttributeSet.SetBase(ESlashAttribute::ESA_Stamina, MaxStaminaValue);
+	}
+
+	UWorld* World = GetWorld();
+	if (bBroadcastPending || World == nullptr)
+		return;
+
+	bBroadcastPending = true;
+	World->GetTimerManager().SetTimerForNextTick(this, &UAttributeComponent::BroadcastChanges);
+}
+
+void UAttributeComponent::BroadcastChanges()
+{
+	bBroadcastPending = false;
+
+	const uint32 ChangedMask = AttributeSet.ConsumeChanges();
+	if (ChangedMask != 0)
+	{
+		OnAttributesChanged.Broadcast(ChangedMask);
+	}
 }
 
 void UAttributeComponent::ReceiveDamage(float Damage)
 {
-	Health = FMath::Clamp(Health - Damage, 0.f, MaxHealth);
+	const float NewHealth = AttributeSet.GetBase(ESlashAttribute::ESA_Health) - Damage;
+	AttributeSet.SetBase(ESlashAttribute::ESA_Health, FMath::Clamp(NewHealth, 0.f, AttributeSet.Get(ESlashAttribute::ESA_MaxHealth)));
+	OnValuesChanged();
+	MarkAttributesDirty();
 }
 
 void UAttributeComponent::UseStamina(float StaminaCost)
 {
-	Stamina = FMath::Clamp(Stamina - StaminaCost, 0.f, MaxStamina);
-	
+	const float NewStamina = AttributeSet.GetBase(ESlashAttribute::ESA_Stamina) - StaminaCost;
+	AttributeSet.SetBase(ESlashAttribute::ESA_Stamina, FMath::Clamp(NewStamina, 0.f, AttributeSet.Get(ESlashAttribute::ESA_MaxStamina)));
+	OnValuesChanged();
+	MarkAttributesDirty();
 }
 
 float UAttributeComponent::GetHealthPercent()
 {
-	return Health / MaxHealth;
+	return AttributeSet.Get(ESlashAttribute::ESA_Health) / AttributeSet.Get(ESlashAttribute::ESA_MaxHealth);
 }
 
 float UAttributeComponent::GetStaminaPercent()
 {
-	return Stamina / MaxStamina;
+	return AttributeSet.Get(ESlashAttribute::ESA_Stamina) / AttributeSet.Get(ESlashAttribute::ESA_MaxStamina);
 }
 
 bool UAttributeComponent::IsAlive()
 {
-	return Health > 0;
+	return AttributeSet.Get(ESlashAttribute::ESA_Health) > 0;
 }
 
 void UAttributeComponent::AddSouls(int32 NumberOfSouls)
 {
-	Souls += NumberOfSouls;
+	AttributeSet.SetBase(ESlashAttribute::ESA_Souls, AttributeSet.GetBase(ESlashAttribute::ESA_Souls) + NumberOfSouls);
+	OnValuesChanged();
+	MarkAttributesDirty();
 }
 
 void UAttributeComponent::AddGold(int32 AmountOfGold)
 {
-	Gold += AmountOfGold;
+	AttributeSet.SetBase(ESlashAttribute::ESA_Gold, AttributeSet.GetBase(ESlashAttribute::ESA_Gold) + AmountOfGold);
+	OnValuesChanged();
+	MarkAttributesDirty();
+}
+
+void UAttributeComponent::AddModifiers(TConstArrayView<FSlashAttributeModifierSpec> Modifiers, const UObject* Source)
+{
+	if (Modifiers.Num() == 0)
+		return;
+
+	AttributeSet.AddModifiers(Modifiers, Source);
+	OnValuesChanged();
+	MarkAttributesDirty();
+}
+
+void UAttributeComponent::RemoveModifiers(const UObject* Source)
+{
+	if (AttributeSet.RemoveModifiers(Source) == 0)
+		return;
+
+	OnValuesChanged();
+	MarkAttributesDirty();
+}
+
+void UAttributeComponent::SerializeSaveData(FArchive& Ar)
+{
+	// Max values, rates and modifiers come from the class defaults and equipment, only the current values are saved
+	float SavedHealth = AttributeSet.GetBase(ESlashAttribute::ESA_Health);
+	float SavedStamina = AttributeSet.GetBase(ESlashAttribute::ESA_Stamina);
+	int32 SavedGold = GetGold();
+	int32 SavedSouls = GetSouls();
+	Ar << SavedHealth;
+	Ar << SavedStamina;
+	Ar << SavedGold;
+	Ar << SavedSouls;
+
+	if (Ar.IsLoading())
+	{
+		AttributeSet.SetBase(ESlashAttribute::ESA_Health, SavedHealth);
+		AttributeSet.SetBase(ESlashAttribute::ESA_Stamina, SavedStamina);
+		AttributeSet.SetBase(ESlashAttribute::ESA_Gold, SavedGold);
+		AttributeSet.SetBase(ESlashAttribute::ESA_Souls, SavedSouls);
+		OnValuesChanged();
+		MarkAttributesDirty();
+	}
+}
+
+void UAttributeComponent::SetPredictedStaminaCost(float Cost)
+{
+	PredictedStaminaCost = Cost;
+}
+
+void UAttributeComponent::ReconcileStamina(float ServerStamina)
+{
+	AttributeSet.SetBase(ESlashAttribute::ESA_Stamina, FMath::Clamp(ServerStamina - PredictedStaminaCost, 0.f, AttributeSet.Get(ESlashAttribute::ESA_MaxStamina)));
+	OnValuesChanged();
 }
 
 void UAttributeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -61,6 +248,13 @@ void UAttributeComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 
 void UAttributeComponent::RegenStamina(float DeltaTime)
 {
-	Stamina = FMath::Clamp(Stamina + (StaminaRegenRate * DeltaTime), 0.f, MaxStamina);
-}
+	const float MaxStaminaValue = AttributeSet.Get(ESlashAttribute::ESA_MaxStamina);
+	const float CurrentStamina = AttributeSet.GetBase(ESlashAttribute::ESA_Stamina);
+	if (CurrentStamina >= MaxStaminaValue)
+		return;
 
+	const float RegenRate = AttributeSet.Get(ESlashAttribute::ESA_StaminaRegenRate);
+	AttributeSet.SetBase(ESlashAttribute::ESA_Stamina, FMath::Clamp(CurrentStamina + RegenRate * DeltaTime, 0.f, MaxStaminaValue));
+	OnValuesChanged();
+	MarkAttributesDirty();
+}
@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/LockOnComponent.h"
+
+#include "Enemy/Enemy.h"
+#include "Enemy/EnemySpatialIndexSubsystem.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "Slash/Slash.h"
+#include "Slash/SlashDebugDraw.h"
+
+DECLARE_CYCLE_STAT(TEXT("Lock On Refresh"), STAT_LockOnRefresh, STATGROUP_Slash);
+
+namespace SlashLockOn
+{
+	static float RefreshInterval = 0.25f;
+	static FAutoConsoleVariableRef CVarRefreshInterval(TEXT("Slash.LockOn.RefreshInterval"), RefreshInterval,
+		TEXT("Seconds between rebuilds of the cached lock-on candidates while locked."));
+
+	static float Stickiness = 0.15f;
+	static FAutoConsoleVariableRef CVarStickiness(TEXT("Slash.LockOn.Stickiness"), Stickiness,
+		TEXT("Score bonus of the locked target over other candidates."));
+}
+
+ULockOnComponent::ULockOnComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	SetIsReplicatedByDefault(true);
+}
+
+float ULockOnComponent::ScoreCandidate(const FVector& ViewLocation, const FVector& ViewDirection, const FVector& TargetLocation) const
+{
+	const float CosConeHalfAngle = FMath::Cos(FMath::DegreesToRadians(ConeHalfAngle));
+	const FVector ToTarget = (TargetLocation - ViewLocation) * FVector(1.f, 1.f, 0.f);
+	const double  Distance = ToTarget.Size();
+	if (Distance > MaxDistance)
+		return 0.f;
+	if (Distance < KINDA_SMALL_NUMBER)
+		return 1.f;
+
+	const float Cos = FVector::DotProduct(ToTarget / Distance, ViewDirection);
+	if (Cos < CosConeHalfAngle)
+		return 0.f;
+
+	const float AngleScore = (Cos - CosConeHalfAngle) / FMath::Max(1.f - CosConeHalfAngle, KINDA_SMALL_NUMBER);
+	const float DistanceScore = 1.f - Distance / MaxDistance;
+	return FMath::Max(AngleWeight * AngleScore + (1.f - AngleWeight) * DistanceScore, KINDA_SMALL_NUMBER);
+}
+
+void ULockOnComponent::GetViewPoint(FVector& OutLocation, FVector& OutDirection) const
+{
+	OutLocation = GetOwner()->GetActorLocation();
+
+	const APawn*       Pawn = Cast<APawn>(GetOwner());
+	const AController* Controller = Pawn ? Pawn->GetController() : nullptr;
+	const FRotator     ViewRotation = Controller ? Controller->GetControlRotation() : GetOwner()->GetActorRotation();
+	OutDirection = ViewRotation.Vector().GetSafeNormal2D();
+}
+
+int32 ULockOnComponent::RefreshCandidates()
+{
+	SCOPE_CYCLE_COUNTER(STAT_LockOnRefresh);
+
+	Candidates.Reset();
+	UEnemySpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UEnemySpatialIndexSubsystem>();
+	if (SpatialIndex == nullptr)
+		return 0;
+
+	FVector ViewLocation, ViewDirection;
+	GetViewPoint(ViewLocation, ViewDirection);
+
+	Gathered.Reset();
+	const int32 NumTested = SpatialIndex->GatherInRadius(ViewLocation, MaxDistance, Gathered);
+
+	Scored.Reset();
+	for (AEnemy* Enemy : Gathered)
+	{
+		float Score = ScoreCandidate(ViewLocation, ViewDirection, Enemy->GetActorLocation());
+		if (Score <= 0.f)
+			continue;
+
+		if (Enemy == Target)
+		{
+			Score += SlashLockOn::Stickiness;
+		}
+		Scored.Emplace(Score, Enemy);
+	}
+
+	Scored.Sort([](const TPair<float, AEnemy*>& A, const TPair<float, AEnemy*>& B) { return A.Key > B.Key; });
+	for (const TPair<float, AEnemy*>& Pair : Scored)
+	{
+		Candidates.Add(Pair.Value);
+	}
+	return NumTested;
+}
+
+bool ULockOnComponent::IsValidTarget(const AActor* Candidate) const
+{
+	return IsValid(Candidate) && !Candidate->ActorHasTag(FName("Dead")) &&
+		FVector::DistSquared(GetOwner()->GetActorLocation(), Candidate->GetActorLocation()) <= FMath::Square(MaxDistance * BreakDistanceScale);
+}
+
+void ULockOnComponent::ToggleLockOn()
+{
+	if (Target)
+	{
+		ClearTarget();
+		return;
+	}
+
+	RefreshCandidates();
+	TimeSinceRefresh = 0.f;
+	SetTarget(Candidates.Num() > 0 ? Candidates[0] : nullptr);
+}
+
+void ULockOnComponent::ClearTarget()
+{
+	SetTarget(nullptr);
+}
+
+void ULockOnComponent::SetTarget(AActor* NewTarget)
+{
+	if (Target == NewTarget)
+		return;
+
+	Target = NewTarget;
+
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	SetComponentTickEnabled(Target != nullptr && Pawn && Pawn->IsLocallyControlled());
+	OnTargetChanged.Broadcast(Target);
+
+	if (!GetOwner()->HasAuthority())
+	{
+		ServerSetTarget(Target);
+	}
+}
+
+void ULockOnComponent::ServerSetTarget_Implementation(AActor* NewTarget)
+{
+	if (NewTarget && !IsValidTarget(NewTarget))
+		return;
+
+	Target = NewTarget;
+	OnTargetChanged.Broadcast(Target);
+}
+
+void ULockOnComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	TimeSinceRefresh += DeltaTime;
+	if (TimeSinceRefresh >= SlashLockOn::RefreshInterval)
+	{
+		TimeSinceRefresh = 0.f;
+		RefreshCandidates();
+	}
+
+	if (!IsValidTarget(Target))
+	{
+		// The cached list is recent enough to pick the next target from without a query
+		AActor* NextTarget = nullptr;
+		for (AEnemy* Candidate : Candidates)
+		{
+			if (Candidate != Target && IsValidTarget(Candidate))
+			{
+				NextTarget = Candidate;
+				break;
+			}
+		}
+		SetTarget(NextTarget);
+		if (Target == nullptr)
+			return;
+	}
+
+	RotateViewTowardsTarget(DeltaTime);
+	SLASH_DEBUG_LINE(this, Combat, GetOwner()->GetActorLocation(), Target->GetActorLocation(), FColor::Orange);
+}
+
+void ULockOnComponent::RotateViewTowardsTarget(float DeltaTime)
+{
+	const APawn* Pawn = Cast<APawn>(GetOwner());
+	AController* Controller = Pawn ? Pawn->GetController() : nullptr;
+	if (Controller == nullptr)
+		return;
+
+	const FRotator ControlRotation = Controller->GetControlRotation();
+	const float    TargetYaw = (Target->GetActorLocation() - GetOwner()->GetActorLocation()).Rotation().Yaw;
+	const FRotator Desired(ControlRotation.Pitch, TargetYaw, ControlRotation.Roll);
+	Controller->SetControlRotation(FMath::RInterpTo(ControlRotation, Desired, DeltaTime, CameraInterpSpeed));
+}
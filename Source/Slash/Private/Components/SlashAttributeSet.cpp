@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/SlashAttributeSet.h"
+
+void FSlashAttributeSet::SetBase(ESlashAttribute Attribute, float Value)
+{
+	const int32 Index = static_cast<int32>(Attribute);
+	if (Base[Index] == Value)
+		return;
+
+	Base[Index] = Value;
+	MarkDirty(Bit(Attribute));
+}
+
+void FSlashAttributeSet::AddModifier(ESlashAttribute Attribute, EAttributeModifierOp Op, float Magnitude, const UObject* Source)
+{
+	Modifiers.Add({ FObjectKey(Source), Magnitude, Attribute, Op });
+	MarkDirty(Bit(Attribute));
+}
+
+void FSlashAttributeSet::AddModifiers(TConstArrayView<FSlashAttributeModifierSpec> Specs, const UObject* Source)
+{
+	uint32 Mask = 0;
+	Modifiers.Reserve(Modifiers.Num() + Specs.Num());
+	for (const FSlashAttributeModifierSpec& Spec : Specs)
+	{
+		Modifiers.Add({ FObjectKey(Source), Spec.Magnitude, Spec.Attribute, Spec.Op });
+		Mask |= Bit(Spec.Attribute);
+	}
+	MarkDirty(Mask);
+}
+
+int32 FSlashAttributeSet::RemoveModifiers(const UObject* Source)
+{
+	const FObjectKey SourceKey(Source);
+	uint32           Mask = 0;
+	const int32      NumRemoved = Modifiers.RemoveAllSwap([SourceKey, &Mask](const FModifier& Modifier)
+	{
+		if (Modifier.Source != SourceKey)
+			return false;
+
+		Mask |= Bit(Modifier.Attribute);
+		return true;
+	}, EAllowShrinking::No);
+
+	MarkDirty(Mask);
+	return NumRemoved;
+}
+
+uint32 FSlashAttributeSet::ConsumeChanges()
+{
+	const uint32 Changes = ChangedMask;
+	ChangedMask = 0;
+	return Changes;
+}
+
+void FSlashAttributeSet::MarkDirty(uint32 Mask)
+{
+	DirtyMask |= Mask;
+	ChangedMask |= Mask;
+}
+
+void FSlashAttributeSet::Recompute(int32 Index) const
+{
+	float Add = 0.f;
+	float Multiply = 1.f;
+	for (const FModifier& Modifier : Modifiers)
+	{
+		if (static_cast<int32>(Modifier.Attribute) != Index)
+			continue;
+
+		if (Modifier.Op == EAttributeModifierOp::EAMO_Add)
+		{
+			Add += Modifier.Magnitude;
+		}
+		else
+		{
+			Multiply *= Modifier.Magnitude;
+		}
+	}
+
+	Final[Index] = (Base[Index] + Add) * Multiply;
+	DirtyMask &= ~(1u << Index);
+}
@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/SlashBotComponent.h"
+
+#include "EnhancedInputSubsystems.h"
+#include "InputAction.h"
+#include "Characters/SlashCharacter.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "Slash/Slash.h"
+
+USlashBotComponent::USlashBotComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+}
+
+bool USlashBotComponent::IsBotClient()
+{
+	static const bool bIsBot = FParse::Param(FCommandLine::Get(), TEXT("SlashBot"));
+	return bIsBot;
+}
+
+void USlashBotComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Character = Cast<ASlashCharacter>(GetOwner());
+
+	int32 Seed = 0;
+	if (!FParse::Value(FCommandLine::Get(), TEXT("SlashBotSeed="), Seed))
+	{
+		Seed = static_cast<int32>(FPlatformTime::Cycles());
+	}
+	Stream.Initialize(Seed);
+
+	UE_LOG(LogSlash, Log, TEXT("Bot - driving %s, seed %d"), *GetNameSafe(Character), Seed);
+}
+
+UEnhancedInputLocalPlayerSubsystem* USlashBotComponent::GetInputSubsystem() const
+{
+	const APlayerController* PlayerController = Character ? Cast<APlayerController>(Character->GetController()) : nullptr;
+	return PlayerController ? ULocalPlayer::GetSubsystem<UEnhancedInputLocalPlayerSubsystem>(PlayerController->GetLocalPlayer()) : nullptr;
+}
+
+void USlashBotComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	UEnhancedInputLocalPlayerSubsystem* Input = GetInputSubsystem();
+	if (Input == nullptr)
+		return;
+
+	ActionTimeLeft -= DeltaTime;
+	if (ActionTimeLeft <= 0.f)
+	{
+		PickNextAction();
+	}
+
+	// 축 입력은 매 프레임 주입해야 유지됩니다
+	if (Character->GetMoveAction() && !MoveInput.IsNearlyZero())
+	{
+		Input->InjectInputForAction(Character->GetMoveAction(), FInputActionValue(MoveInput));
+	}
+	if (Character->GetLookAction() && !LookInput.IsNearlyZero())
+	{
+		Input->InjectInputForAction(Character->GetLookAction(), FInputActionValue(LookInput * DeltaTime));
+	}
+}
+
+void USlashBotComponent::PickNextAction()
+{
+	UEnhancedInputLocalPlayerSubsystem* Input = GetInputSubsystem();
+	ActionTimeLeft = Stream.FRandRange(MinActionTime, MaxActionTime);
+	MoveInput = FVector2D(Stream.FRandRange(-1.f, 1.f), Stream.FRandRange(-1.f, 1.f)).GetSafeNormal();
+	LookInput = FVector2D(Stream.FRandRange(-60.f, 60.f), 0.f);
+
+	const float Roll = Stream.FRand();
+	const UInputAction* Action = nullptr;
+	if (Roll < AttackChance)
+	{
+		Action = Character->GetAttackAction();
+	}
+	else if (Roll < AttackChance + DodgeChance)
+	{
+		Action = Character->GetDodgeAction();
+	}
+	else if (Roll < AttackChance + DodgeChance + InteractChance)
+	{
+		Action = Character->GetEKeyAction();
+	}
+
+	if (Action)
+	{
+		Input->InjectInputForAction(Action, FInputActionValue(true));
+	}
+}
@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/StatusEffectSubsystem.h"
+
+#include "Characters/BaseCharacter.h"
+#include "Components/AttributeComponent.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Slash/Slash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Status Effects Advance"), STAT_StatusEffectsAdvance, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Status Effects Active"), STAT_StatusEffectsActive, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Status Effects Targets Changed"), STAT_StatusEffectsTargets, STATGROUP_Slash);
+
+CSV_DEFINE_CATEGORY(SlashEffects, true);
+
+namespace SlashStatusEffects
+{
+	static float Interval = 0.25f;
+	static FAutoConsoleVariableRef CVarInterval(TEXT("Slash.StatusEffects.Interval"), Interval,
+		TEXT("Seconds between passes over the active status effects."));
+
+	static int32 MaxStacks = 3;
+	static FAutoConsoleVariableRef CVarMaxStacks(TEXT("Slash.StatusEffects.MaxStacks"), MaxStacks,
+		TEXT("Stacks of one effect type on one character; further applications refresh the shortest stack."));
+}
+
+void UStatusEffectSubsystem::FEffectList::RemoveAtSwap(int32 Index)
+{
+	const ABaseCharacter* Target = Targets[Index];
+	int32&                Stacks = NumStacks.FindChecked(Target);
+	if (--Stacks == 0)
+	{
+		NumStacks.Remove(Target);
+	}
+
+	Targets.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Rates.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Remaining.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+bool UStatusEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UStatusEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStatusEffectSubsystem, STATGROUP_Tickables);
+}
+
+void UStatusEffectSubsystem::ApplyEffects(ABaseCharacter* Target, TConstArrayView<FStatusEffectSpec> Specs)
+{
+	for (const FStatusEffectSpec& Spec : Specs)
+	{
+		ApplyEffect(Target, Spec);
+	}
+}
+
+void UStatusEffectSubsystem::ApplyEffect(ABaseCharacter* Target, const FStatusEffectSpec& Spec)
+{
+	if (Target == nullptr || !Target->HasAuthority() || Spec.Type == EStatusEffectType::ESE_MAX || Spec.AmountPerSecond <= 0.f || Spec.Duration <= 0.f)
+		return;
+
+	UAttributeComponent* Attributes = Target->GetAttributes();
+	if (Attributes == nullptr || !Attributes->IsAlive())
+		return;
+
+	FEffectList& List = Lists[static_cast<int32>(Spec.Type)];
+	int32&       NumStacks = List.NumStacks.FindOrAdd(Target);
+	if (NumStacks < SlashStatusEffects::MaxStacks)
+	{
+		++NumStacks;
+		List.Targets.Add(Target);
+		List.Rates.Add(Spec.AmountPerSecond);
+		List.Remaining.Add(Spec.Duration);
+		INC_DWORD_STAT(STAT_StatusEffectsActive);
+		return;
+	}
+
+	// At the cap, the stack closest to running out is refreshed
+	int32 Shortest = INDEX_NONE;
+	for (int32 Index = 0; Index < List.Targets.Num(); ++Index)
+	{
+		if (List.Targets[Index] == Target && (Shortest == INDEX_NONE || List.Remaining[Index] < List.Remaining[Shortest]))
+		{
+			Shortest = Index;
+		}
+	}
+	if (Shortest != INDEX_NONE)
+	{
+		List.Rates[Shortest] = FMath::Max(List.Rates[Shortest], Spec.AmountPerSecond);
+		List.Remaining[Shortest] = FMath::Max(List.Remaining[Shortest], Spec.Duration);
+	}
+}
+
+void UStatusEffectSubsystem::RemoveTarget(const ABaseCharacter* Target)
+{
+	for (FEffectList& List : Lists)
+	{
+		if (!List.NumStacks.Contains(Target))
+			continue;
+
+		for (int32 Index = List.Targets.Num() - 1; Index >= 0; --Index)
+		{
+			if (List.Targets[Index] == Target)
+			{
+				List.RemoveAtSwap(Index);
+			}
+		}
+	}
+	SET_DWORD_STAT(STAT_StatusEffectsActive, GetNumEffects());
+}
+
+void UStatusEffectSubsystem::RemoveAll()
+{
+	for (FEffectList& List : Lists)
+	{
+		List.Targets.Reset();
+		List.Rates.Reset();
+		List.Remaining.Reset();
+		List.NumStacks.Reset();
+	}
+	SET_DWORD_STAT(STAT_StatusEffectsActive, 0);
+}
+
+int32 UStatusEffectSubsystem::GetNumEffects() const
+{
+	int32 NumEffects = 0;
+	for (const FEffectList& List : Lists)
+	{
+		NumEffects += List.Targets.Num();
+	}
+	return NumEffects;
+}
+
+void UStatusEffectSubsystem::Tick(float DeltaTime)
+{
+	if (GetNumEffects() == 0)
+	{
+		TimeSinceAdvance = 0.f;
+		return;
+	}
+
+	TimeSinceAdvance += DeltaTime;
+	if (TimeSinceAdvance < SlashStatusEffects::Interval)
+		return;
+
+	Advance(TimeSinceAdvance);
+	TimeSinceAdvance = 0.f;
+}
+
+int32 UStatusEffectSubsystem::Advance(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_StatusEffectsAdvance);
+	CSV_SCOPED_TIMING_STAT(SlashEffects, Advance);
+
+	Totals.Reset();
+	int32 NumEffects = 0;
+	for (int32 TypeIndex = 0; TypeIndex < UE_ARRAY_COUNT(Lists); ++TypeIndex)
+	{
+		FEffectList& List = Lists[TypeIndex];
+		const int32  Num = List.Targets.Num();
+		if (Num == 0)
+			continue;
+
+		NumEffects += Num;
+		List.Amounts.SetNumUninitialized(Num, EAllowShrinking::No);
+
+		// Plain float arrays and no branches, so the compiler vectorizes this loop
+		const float* Rates = List.Rates.GetData();
+		float*       Remaining = List.Remaining.GetData();
+		float*       Amounts = List.Amounts.GetData();
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			const float Step = FMath::Min(DeltaSeconds, Remaining[Index]);
+			Amounts[Index] = Rates[Index] * Step;
+			Remaining[Index] -= Step;
+		}
+
+		const bool bDrainsStamina = TypeIndex == static_cast<int32>(EStatusEffectType::ESE_StaminaDrain);
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			FEffectTotals& Total = Totals.FindOrAdd(List.Targets[Index]);
+			(bDrainsStamina ? Total.Stamina : Total.Health) += Amounts[Index];
+		}
+
+		// Back to front, so the entries swapped in were already checked
+		for (int32 Index = Num - 1; Index >= 0; --Index)
+		{
+			if (List.Remaining[Index] <= 0.f)
+			{
+				List.RemoveAtSwap(Index);
+			}
+		}
+	}
+
+	// One change per character, however many stacks it carries
+	for (const TPair<ABaseCharacter*, FEffectTotals>& Pair : Totals)
+	{
+		ABaseCharacter*      Target = Pair.Key;
+		UAttributeComponent* Attributes = Target->GetAttributes();
+		if (Attributes == nullptr)
+			continue;
+
+		if (Pair.Value.Stamina > 0.f)
+		{
+			Attributes->UseStamina(Pair.Value.Stamina);
+		}
+		if (Pair.Value.Health > 0.f)
+		{
+			Target->ApplyEffectDamage(Pair.Value.Health);
+		}
+		if (!Attributes->IsAlive())
+		{
+			RemoveTarget(Target);
+		}
+	}
+
+	SET_DWORD_STAT(STAT_StatusEffectsActive, GetNumEffects());
+	INC_DWORD_STAT_BY(STAT_StatusEffectsTargets, Totals.Num());
+	CSV_CUSTOM_STAT(SlashEffects, Active, NumEffects, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SlashEffects, TargetsChanged, Totals.Num(), ECsvCustomStatOp::Accumulate);
+	return Totals.Num();
+}
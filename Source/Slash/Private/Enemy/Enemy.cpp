@@ -4,17 +4,43 @@
 #include "Enemy/Enemy.h"
 
 #include "Components/AttributeComponent.h"
+#include "Enemy/EnemyActivationSubsystem.h"
+#include "Enemy/EnemyAnimBudgetSubsystem.h"
+#include "Enemy/EnemyAttackDirectorSubsystem.h"
+#include "Enemy/EnemyAnimSharingSubsystem.h"
+#include "Enemy/EnemySpatialIndexSubsystem.h"
 #include "GameFramework/CharacterMovementComponent.h"
-#include "HUD/HealthBarComponent.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HUD/EnemyHealthBarLayer.h"
+#include "Items/PickupSubsystem.h"
 #include "Items/Soul.h"
 #include "Items/Weapons/Weapon.h"
 #include "Navigation/PathFollowingComponent.h"
+#include "Net/SlashEnemyNetSubsystem.h"
+#include "Net/SlashReplicationGraph.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
 #include "Perception/PawnSensingComponent.h"
 #include "Runtime/AIModule/Classes/AIController.h"
-#include "Slash/DebugMacros.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Slash/SlashDebugDraw.h"
+#include "World/SlashAssetPreloadSubsystem.h"
+#include "World/SlashCheckpointSubsystem.h"
+
+namespace SlashEnemy
+{
+	/** Chasing, holding, attacking or engaged; spelled out so Dead never counts, wherever it sits in EEnemyState */
+	static bool IsAggroState(EEnemyState State)
+	{
+		return State > EEnemyState::EES_Patrolling && State != EEnemyState::EES_Dead;
+	}
+}
 
 // Sets default values
-AEnemy::AEnemy()
+AEnemy::AEnemy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
 	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
@@ -24,17 +50,25 @@ AEnemy::AEnemy()
 	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
 	GetMesh()->SetGenerateOverlapEvents(true);
 
-	HealthBarWidget = CreateDefaultSubobject<UHealthBarComponent>(TEXT("HealthBarWidget"));
-	HealthBarWidget->SetupAttachment(GetRootComponent());
+	// Registered explicitly by UEnemyAnimBudgetSubsystem
+	if (USkeletalMeshComponentBudgeted* BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(GetMesh()))
+	{
+		BudgetedMesh->SetAutoRegisterWithBudgetAllocator(false);
+	}
 
+	// Registered while a player is near, see UpdateActivation
 	PawnSensing = CreateDefaultSubobject<UPawnSensingComponent>(TEXT("PawnSensing"));
 	PawnSensing->SightRadius = 4000.f;
 	PawnSensing->SetPeripheralVisionAngle(45.f);
+	PawnSensing->bAutoRegister = false;
 
 	GetCharacterMovement()->bOrientRotationToMovement = true;
 	bUseControllerRotationRoll = false;
 	bUseControllerRotationPitch = false;
 	bUseControllerRotationYaw = false;
+
+	// Movement goes through NetMovement instead
+	SetReplicatingMovement(false);
 }
 
 // Called every frame
@@ -42,6 +76,12 @@ void AEnemy::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (!HasAuthority())
+	{
+		SmoothNetMovement(DeltaTime);
+		return; // AI only runs on the server
+	}
+
 	if (IsDead())
 	{
 		return; // Do not process further if dead
@@ -59,14 +99,110 @@ void AEnemy::Tick(float DeltaTime)
 	//UE_LOG(LogTemp, Log, TEXT("Enemy State: %s"), *UEnum::GetValueAsString(EnemyState));
 }
 
+void AEnemy::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AEnemy, EnemyState, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AEnemy, DeathPose, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AEnemy, NetMovement, Params);
+}
+
+void AEnemy::PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker)
+{
+	Super::PreReplication(ChangedPropertyTracker);
+
+	// Only called when the enemy is due (state and distance tier rate), so this samples at the send rate
+	const FEnemyNetMovement NewMovement = FEnemyNetMovement::Make(GetActorLocation(), GetActorRotation().Yaw, GetVelocity());
+	if (NewMovement == NetMovement)
+		return;
+
+	NetMovement = NewMovement;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AEnemy, NetMovement, this);
+
+	if (USlashEnemyNetSubsystem* EnemyNet = GetWorld()->GetSubsystem<USlashEnemyNetSubsystem>())
+	{
+		EnemyNet->NotifyMovementSent(NetMovement);
+	}
+}
+
+void AEnemy::SetNetTier(uint8 Tier)
+{
+	if (NetTier == Tier)
+		return;
+
+	NetTier = Tier;
+	USlashReplicationGraph::UpdateEnemyFrequency(this);
+}
+
+void AEnemy::OnRep_NetMovement()
+{
+	// The first update snaps, later jumps (checkpoint teleports) snap in SmoothNetMovement
+	if (!bHasNetMovement)
+	{
+		SetActorLocationAndRotation(NetMovement.Location, FRotator(0.f, NetMovement.Yaw, 0.f));
+	}
+	bHasNetMovement = true;
+	NetMovementReceiveTime = GetWorld()->GetTimeSeconds();
+
+	// Sampled in PreReplication, one way trip ago on the server's clock
+	const AGameStateBase*    GameState = GetWorld()->GetGameState();
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const APlayerState*      PlayerState = PlayerController ? PlayerController->PlayerState : nullptr;
+	const double             ServerTime = GameState ? GameState->GetServerWorldTimeSeconds() : NetMovementReceiveTime;
+	NetMovementServerTime = ServerTime - (PlayerState ? PlayerState->GetPingInMilliseconds() * 0.0005 : 0.0);
+}
+
+double AEnemy::GetDisplayedServerTime() const
+{
+	if (!bHasNetMovement)
+	{
+		const AGameStateBase* GameState = GetWorld()->GetGameState();
+		return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+	}
+
+	// Same extrapolation as SmoothNetMovement; the exponential smoothing then trails that target by GetNetSmoothingDelay()
+	const double Age = FMath::Min(GetWorld()->GetTimeSeconds() - NetMovementReceiveTime, static_cast<double>(MaxNetExtrapolation));
+	return NetMovementServerTime + Age - GetNetSmoothingDelay();
+}
+
+void AEnemy::SmoothNetMovement(float DeltaTime)
+{
+	if (!bHasNetMovement)
+		return;
+
+	// Keep walking along the last velocity until the next update, but not forever if updates stop
+	const FVector  Velocity(NetMovement.Velocity, 0.f);
+	const double   Age = FMath::Min(GetWorld()->GetTimeSeconds() - NetMovementReceiveTime, static_cast<double>(MaxNetExtrapolation));
+	const FVector  Target = NetMovement.Location + Velocity * Age;
+	const FVector  Current = GetActorLocation();
+	const FRotator TargetRotation(0.f, NetMovement.Yaw, 0.f);
+
+	if (FVector::DistSquared(Current, Target) > FMath::Square(NetSnapDistance))
+	{
+		SetActorLocationAndRotation(Target, TargetRotation);
+	}
+	else
+	{
+		const float Alpha = 1.f - FMath::Exp(-NetSmoothingSpeed * DeltaTime);
+		SetActorLocationAndRotation(FMath::Lerp(Current, Target, Alpha), FMath::Lerp(GetActorRotation(), TargetRotation, Alpha));
+	}
+
+	// Drives GroundSpeed in the anim instance
+	GetCharacterMovement()->Velocity = Age < MaxNetExtrapolation ? Velocity : FVector::ZeroVector;
+}
+
 float AEnemy::TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser)
 {
+	LeaveAnimSharing();
 	HandleDamage(DamageAmount);
 
 	CombatTarget = EventInstigator->GetPawn();
 	if (IsInsideAttackRadius())
 	{
-		EnemyState = EEnemyState::EES_Attacking;
+		SetEnemyState(EEnemyState::EES_Attacking);
 	}
 	else if (IsOutsideAttackRadius())
 	{
@@ -76,19 +212,72 @@ float AEnemy::TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEv
 	return DamageAmount;
 }
 
-void AEnemy::Destroyed()
+void AEnemy::RestoreFromCheckpoint()
 {
+	GetWorldTimerManager().ClearAllTimersForObject(this);
+	if (EnemyController)
+	{
+		EnemyController->StopMovement();
+	}
+
+	Revive();
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
 	if (EquippedWeapon)
 	{
-		EquippedWeapon->Destroy();
-		EquippedWeapon = nullptr;
+		EquippedWeapon->SetActorHiddenInGame(false);
 	}
+	SetWeaponCollisionEnabled(ECollisionEnabled::NoCollision);
+	GetCharacterMovement()->bOrientRotationToMovement = true;
+
+	LoseInterest();
+	UpdateHealthBar();
+	StartPatrolling();
+}
+
+void AEnemy::Destroyed()
+{
+	ReleaseWeapon();
 
 	Super::Destroyed();
 }
 
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UEnemyAnimSharingSubsystem* AnimSharing = GetWorld()->GetSubsystem<UEnemyAnimSharingSubsystem>())
+	{
+		AnimSharing->RemoveEnemy(this);
+	}
+
+	if (UEnemyAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UEnemyAnimBudgetSubsystem>())
+	{
+		AnimBudget->UnregisterEnemy(this);
+	}
+
+	if (USlashEnemyNetSubsystem* EnemyNet = GetWorld()->GetSubsystem<USlashEnemyNetSubsystem>())
+	{
+		EnemyNet->UnregisterEnemy(this);
+	}
+
+	if (UEnemyActivationSubsystem* Activation = GetWorld()->GetSubsystem<UEnemyActivationSubsystem>())
+	{
+		Activation->UnregisterEnemy(this);
+	}
+
+	if (UEnemySpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UEnemySpatialIndexSubsystem>())
+	{
+		SpatialIndex->UnregisterEnemy(this);
+	}
+
+	ReleaseAttackToken();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AEnemy::GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter)
 {
+	LeaveAnimSharing();
 	Super::GetHit_Implementation(ImpactPoint, Hitter);
 	if (!IsDead())
 		ShowHealthBar();
@@ -100,7 +289,10 @@ void AEnemy::GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter)
 
 	if (IsInsideAttackRadius() && !IsDead())
 	{
-		StartAttackTimer();
+		if (TryAcquireAttackToken())
+			StartAttackTimer();
+		else
+			StartHolding();
 	}
 }
 
@@ -110,13 +302,57 @@ void AEnemy::BeginPlay()
 {
 	Super::BeginPlay();
 
-	if (PawnSensing)
+	if (Attributes && !HasAuthority())
+	{
+		Attributes->OnAttributesReplicated.AddUObject(this, &AEnemy::OnAttributesReplicated);
+	}
+
+	if (HasAuthority())
 	{
+		if (USlashEnemyNetSubsystem* EnemyNet = GetWorld()->GetSubsystem<USlashEnemyNetSubsystem>())
+		{
+			EnemyNet->RegisterEnemy(this);
+		}
 		PawnSensing->OnSeePawn.AddDynamic(this, &AEnemy::PawnSeen);
+		InitializeEnemy();
+	}
+	else
+	{
+		// Clients place the enemy from NetMovement, the movement component only reports its velocity
+		GetCharacterMovement()->SetComponentTickEnabled(false);
 	}
 
-	InitializeEnemy();
+	HideHealthBar();
 	Tags.Add(FName("Enemy"));
+
+	if (UEnemySpatialIndexSubsystem* SpatialIndex = GetWorld()->GetSubsystem<UEnemySpatialIndexSubsystem>())
+	{
+		SpatialIndex->RegisterEnemy(this);
+	}
+
+	if (UEnemyActivationSubsystem::AreComponentsLazy())
+	{
+		if (UEnemyActivationSubsystem* Activation = GetWorld()->GetSubsystem<UEnemyActivationSubsystem>())
+		{
+			Activation->RegisterEnemy(this);
+		}
+	}
+	else if (HasAuthority())
+	{
+		// Clients equip their copy of the weapon once OnRep_EnemyState reports the aggro
+		EquipDefaultWeapon();
+		UpdateActivation(true);
+	}
+
+	if (UEnemyAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UEnemyAnimBudgetSubsystem>())
+	{
+		AnimBudget->RegisterEnemy(this);
+	}
+
+	if (UEnemyAnimSharingSubsystem* AnimSharing = GetWorld()->GetSubsystem<UEnemyAnimSharingSubsystem>())
+	{
+		AnimSharing->AddEnemy(this);
+	}
 }
 
 void AEnemy::Die_Implementation()
@@ -126,11 +362,12 @@ void AEnemy::Die_Implementation()
 	
 	Super::Die_Implementation();
 	
-	EnemyState = EEnemyState::EES_Dead;
+	SetEnemyState(EEnemyState::EES_Dead);
 	ClearAttackTimer();
+	ReleaseAttackToken();
 	HideHealthBar();
 	DisableCapsule();
-	SetLifeSpan(DeathLifeSpan);
+	GetWorldTimerManager().SetTimer(DeathTimer, this, &AEnemy::DeathTimerFinished, DeathLifeSpan);
 	GetCharacterMovement()->bOrientRotationToMovement = false;
 	SetWeaponCollisionEnabled(ECollisionEnabled::NoCollision);
 
@@ -145,7 +382,7 @@ void AEnemy::Attack()
 	if (CombatTarget == nullptr)
 		return;
 	
-	EnemyState = EEnemyState::EES_Engaged;
+	SetEnemyState(EEnemyState::EES_Engaged);
 	PlayAttackMontage();
 }
 
@@ -158,19 +395,76 @@ void AEnemy::HandleDamage(float DamageAmount)
 {
 	Super::HandleDamage(DamageAmount);
 
-	if (Attributes && HealthBarWidget)
+	UpdateHealthBar();
+}
+
+namespace SlashEnemy
+{
+	/** Directions of ABaseCharacter::DirectionalHitReact, indexed for MulticastPlayMontage */
+	static const TArray<FName>& GetHitReactSections()
+	{
+		static const TArray<FName> Sections = { FName("FromFront"), FName("FromBack"), FName("FromLeft"), FName("FromRight") };
+		return Sections;
+	}
+}
+
+void AEnemy::PlayHitReactMontage(const FName& SectionName)
+{
+	Super::PlayHitReactMontage(SectionName);
+
+	if (HasAuthority())
+	{
+		MulticastPlayMontage(EEnemyMontage::EEM_HitReact, static_cast<int8>(SlashEnemy::GetHitReactSections().IndexOfByKey(SectionName)));
+	}
+}
+
+int32 AEnemy::PlayAttackMontage()
+{
+	const int32 Selection = Super::PlayAttackMontage();
+	if (HasAuthority() && Selection != INDEX_NONE)
 	{
-		HealthBarWidget->SetHealthPercent(Attributes->GetHealthPercent());
+		MulticastPlayMontage(EEnemyMontage::EEM_Attack, static_cast<int8>(Selection));
+	}
+	return Selection;
+}
+
+void AEnemy::MulticastPlayMontage_Implementation(EEnemyMontage Montage, int8 Section)
+{
+	// The server already played it
+	if (HasAuthority())
+		return;
+
+	switch (Montage)
+	{
+	case EEnemyMontage::EEM_Attack:
+		PlayAttackMontageSection(Section);
+		break;
+
+	case EEnemyMontage::EEM_HitReact:
+		if (SlashEnemy::GetHitReactSections().IsValidIndex(Section))
+		{
+			PlayHitReactMontage(SlashEnemy::GetHitReactSections()[Section]);
+		}
+		break;
+
+	case EEnemyMontage::EEM_Death:
+		PlayDeathMontageSection(Section);
+		break;
 	}
 }
 
 int32 AEnemy::PlayDeathMontage()
 {
 	const int32             Selection = Super::PlayDeathMontage();
+	if (HasAuthority() && Selection != INDEX_NONE)
+	{
+		MulticastPlayMontage(EEnemyMontage::EEM_Death, static_cast<int8>(Selection));
+	}
 	TEnumAsByte<EDeathPose> pose(Selection);
 	if (pose < EDeathPose::EDP_MAX)
 	{
 		DeathPose = pose;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AEnemy, DeathPose, this);
 	}
 
 	return Selection;
@@ -178,10 +472,69 @@ int32 AEnemy::PlayDeathMontage()
 
 void AEnemy::AttackEnd()
 {
-	EnemyState = EEnemyState::EES_NoState;
+	ReleaseAttackToken();
+	SetEnemyState(EEnemyState::EES_NoState);
 	CheckCombatTarget();
 }
 
+void AEnemy::SetEnemyState(EEnemyState NewState)
+{
+	if (EnemyState == NewState)
+		return;
+
+	const bool bWasHolding = IsHolding();
+	EnemyState = NewState;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AEnemy, EnemyState, this);
+
+	// Holding enemies only circle, the AI checks at a reduced rate
+	if (bWasHolding != IsHolding())
+	{
+		SetActorTickInterval(IsHolding() ? HoldingTickInterval : 0.f);
+	}
+
+	// First aggro
+	if (SlashEnemy::IsAggroState(NewState))
+	{
+		EquipDefaultWeapon();
+	}
+
+	if (HasAuthority())
+	{
+		USlashReplicationGraph::UpdateEnemyFrequency(this);
+	}
+}
+
+void AEnemy::OnRep_EnemyState()
+{
+	// AI is server side and montages arrive through MulticastPlayMontage, clients only mirror visuals and collision
+	if (SlashEnemy::IsAggroState(EnemyState))
+	{
+		EquipDefaultWeapon();
+	}
+
+	// Same as the server: only patrolling enemies copy a shared pose
+	if (EnemyState > EEnemyState::EES_Patrolling)
+	{
+		LeaveAnimSharing();
+	}
+	else if (EnemyState == EEnemyState::EES_Patrolling)
+	{
+		EnterAnimSharing();
+	}
+
+	if (IsDead())
+	{
+		HideHealthBar();
+		DisableCapsule();
+		GetCharacterMovement()->bOrientRotationToMovement = false;
+	}
+}
+
+void AEnemy::OnAttributesReplicated()
+{
+	UpdateHealthBar();
+}
+
 bool AEnemy::InTargetRange(AActor* Target, double Radius)
 {
 	if (Target == nullptr)
@@ -194,35 +547,32 @@ bool AEnemy::InTargetRange(AActor* Target, double Radius)
 
 void AEnemy::SpawnSoul()
 {
-	if (!SoulClass)
+	if (SoulClass.IsNull())
 		return;
-	if (UWorld* World = GetWorld())
+
+	// The drop must not be lost when the class is not resident yet, it comes a little later instead
+	const FVector                SpawnLocation = GetActorLocation() + FVector(0, 0, 125.f);
+	const int32                  Souls = Attributes->GetSouls();
+	const TWeakObjectPtr<UWorld> WeakWorld = GetWorld();
+	USlashAssetPreloadSubsystem::LoadClass(SoulClass, [WeakWorld, SpawnLocation, Souls](UClass* Class)
 	{
-		const FVector SpawnLocation = GetActorLocation() + FVector(0, 0, 125.f);
-		if (ASoul* SpawnedSoul = World->SpawnActor<ASoul>(SoulClass, SpawnLocation, GetActorRotation()))
+		UPickupSubsystem* Pickups = WeakWorld.IsValid() ? WeakWorld->GetSubsystem<UPickupSubsystem>() : nullptr;
+		if (Pickups)
 		{
-			SpawnedSoul->SetSouls(Attributes->GetSouls());
-			SpawnedSoul->SetOwner(this);
+			Pickups->SpawnPickup(Class, SpawnLocation, Souls);
 		}
-	}
+	});
 }
 
 void AEnemy::InitializeEnemy()
 {
 	GetCharacterMovement()->MaxWalkSpeed = PatrollingSpeed;
-	
-	if (Attributes && HealthBarWidget)
-	{
-		HealthBarWidget->SetHealthPercent(Attributes->GetHealthPercent());
-		HealthBarWidget->SetVisibility(false);
-	}
 
 	EnemyController = Cast<AAIController>(GetController());
 
 	// Start the timer to check when enemy can begin patrolling 
 	// (depends on NavMesh being ready)
 	GetWorldTimerManager().SetTimer(BeginPatrolTimer, this, &AEnemy::BeginPatrolling, 1.0f, true);
-	SpawnDefaultWeapon();
 }
 
 /**
@@ -240,7 +590,7 @@ void AEnemy::CheckPatrolTarget()
 }
 
 /**
- * CombatTarget와의 거리를 확인하여, CombatTarget이 범위를 벗어나면 CombatTarget을 nullptr로 설정하고 HealthBarWidget을 숨깁니다.
+ * CombatTarget와의 거리를 확인하여, CombatTarget이 범위를 벗어나면 CombatTarget을 nullptr로 설정하고 체력바를 숨깁니다.
  */
 void AEnemy::CheckCombatTarget()
 {
@@ -251,15 +601,29 @@ void AEnemy::CheckCombatTarget()
 		if (!IsEngaged())
 			StartPatrolling();
 	}
+	else if (IsHolding())
+	{
+		if (TryAcquireAttackToken())
+			ChaseTarget();
+		else
+			CircleTarget();
+	}
 	else if (IsOutsideAttackRadius() && !IsChasing())
 	{
 		ClearAttackTimer();
 		if (!IsEngaged())
 			ChaseTarget();
 	}
+	else if (IsChasing() && InTargetRange(CombatTarget, HoldingRange) && !TryAcquireAttackToken())
+	{
+		StartHolding();
+	}
 	else if (CanAttack())
 	{
-		StartAttackTimer();
+		if (TryAcquireAttackToken())
+			StartAttackTimer();
+		else
+			StartHolding();
 	}
 }
 
@@ -270,36 +634,48 @@ void AEnemy::PatrolTimerFinished()
 
 void AEnemy::HideHealthBar()
 {
-	if (HealthBarWidget)
+	if (UEnemyHealthBarLayer* HealthBars = UEnemyHealthBarLayer::Get(this))
 	{
-		HealthBarWidget->SetVisibility(false);
+		HealthBars->HideEnemy(this);
 	}
 }
 
 void AEnemy::ShowHealthBar()
 {
-	if (HealthBarWidget)
+	if (UEnemyHealthBarLayer* HealthBars = UEnemyHealthBarLayer::Get(this))
 	{
-		HealthBarWidget->SetVisibility(true);
+		HealthBars->ShowEnemy(this, Attributes ? Attributes->GetHealthPercent() : 1.f);
+	}
+}
+
+void AEnemy::UpdateHealthBar()
+{
+	UEnemyHealthBarLayer* HealthBars = UEnemyHealthBarLayer::Get(this);
+	if (HealthBars && Attributes)
+	{
+		HealthBars->SetEnemyPercent(this, Attributes->GetHealthPercent());
 	}
 }
 
 void AEnemy::LoseInterest()
 {
+	ReleaseAttackToken();
 	CombatTarget = nullptr;
 	HideHealthBar();
 }
 
 void AEnemy::StartPatrolling()
 {
-	EnemyState = EEnemyState::EES_Patrolling;
+	SetEnemyState(EEnemyState::EES_Patrolling);
 	GetCharacterMovement()->MaxWalkSpeed = PatrollingSpeed; // Reset speed to patrol speed
 	MoveToTarget(CurrentPatrolTarget);
+	EnterAnimSharing();
 }
 
 void AEnemy::ChaseTarget()
 {
-	EnemyState = EEnemyState::EES_Chasing;
+	LeaveAnimSharing();
+	SetEnemyState(EEnemyState::EES_Chasing);
 	GetCharacterMovement()->MaxWalkSpeed = ChasingSpeed; // Set speed to chase speed
 	MoveToTarget(CombatTarget);
 }
@@ -324,6 +700,11 @@ bool AEnemy::IsChasing()
 	return EnemyState == EEnemyState::EES_Chasing;
 }
 
+bool AEnemy::IsHolding()
+{
+	return EnemyState == EEnemyState::EES_Holding;
+}
+
 bool AEnemy::IsAttacking()
 {
 	return EnemyState == EEnemyState::EES_Attacking;
@@ -339,6 +720,25 @@ bool AEnemy::IsEngaged()
 	return EnemyState == EEnemyState::EES_Engaged;
 }
 
+void AEnemy::DeathTimerFinished()
+{
+	// Enemies the checkpoint can revive are parked instead of destroyed
+	USlashCheckpointSubsystem* Checkpoint = GetWorld()->GetSubsystem<USlashCheckpointSubsystem>();
+	if (Checkpoint == nullptr || !Checkpoint->CanRevive(this))
+	{
+		Destroy();
+		return;
+	}
+
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	if (EquippedWeapon)
+	{
+		EquippedWeapon->SetActorHiddenInGame(true);
+	}
+}
+
 void AEnemy::ClearPatrolTimer()
 {
 	GetWorldTimerManager().ClearTimer(PatrolTimer);
@@ -346,7 +746,8 @@ void AEnemy::ClearPatrolTimer()
 
 void AEnemy::StartAttackTimer()
 {
-	EnemyState = EEnemyState::EES_Attacking;
+	LeaveAnimSharing();
+	SetEnemyState(EEnemyState::EES_Attacking);
 
 	const float AttackTime = FMath::RandRange(AttackMin, AttackMax);
 	GetWorldTimerManager().SetTimer(AttackTimer, this, &AEnemy::Attack, AttackTime);
@@ -357,6 +758,79 @@ void AEnemy::ClearAttackTimer()
 	GetWorldTimerManager().ClearTimer(AttackTimer);
 }
 
+bool AEnemy::TryAcquireAttackToken()
+{
+	UEnemyAttackDirectorSubsystem* Director = GetWorld()->GetSubsystem<UEnemyAttackDirectorSubsystem>();
+	if (Director == nullptr || !UEnemyAttackDirectorSubsystem::IsEnabled() || CombatTarget == nullptr)
+		return true;
+
+	if (!Director->HasToken(this) && GetWorld()->GetTimeSeconds() < NextAttackTokenTime)
+		return false;
+
+	return Director->RequestToken(this, CombatTarget, AttackTokenCost);
+}
+
+void AEnemy::ReleaseAttackToken()
+{
+	UEnemyAttackDirectorSubsystem* Director = GetWorld()->GetSubsystem<UEnemyAttackDirectorSubsystem>();
+	if (Director && Director->ReleaseToken(this))
+	{
+		NextAttackTokenTime = GetWorld()->GetTimeSeconds() + AttackTokenCooldown;
+	}
+}
+
+/**
+ * 공격 토큰이 없는 동안 무기 충돌과 공격 없이 HoldingRange에서 대상을 돌며 기다립니다.
+ */
+void AEnemy::StartHolding()
+{
+	ClearAttackTimer();
+	SetEnemyState(EEnemyState::EES_Holding);
+	SetWeaponCollisionEnabled(ECollisionEnabled::NoCollision);
+	GetCharacterMovement()->MaxWalkSpeed = PatrollingSpeed;
+	bCircleClockwise = FMath::RandBool();
+
+	if (EnemyController)
+	{
+		EnemyController->StopMovement();
+	}
+	CircleTarget();
+}
+
+void AEnemy::CircleTarget()
+{
+	if (EnemyController == nullptr || CombatTarget == nullptr || EnemyController->GetMoveStatus() == EPathFollowingStatus::Moving)
+		return;
+
+	const FVector TargetLocation = CombatTarget->GetActorLocation();
+	FVector       FromTarget = (GetActorLocation() - TargetLocation).GetSafeNormal2D();
+	if (FromTarget.IsNearlyZero())
+	{
+		FromTarget = -GetActorForwardVector();
+	}
+
+	const float   Step = bCircleClockwise ? HoldingOrbitAngle : -HoldingOrbitAngle;
+	const FVector Goal = TargetLocation + FromTarget.RotateAngleAxis(Step, FVector::UpVector) * HoldingRange;
+	EnemyController->MoveToLocation(Goal, AcceptanceRadius);
+	SLASH_DEBUG_LINE(this, AI, GetActorLocation(), Goal, FColor::Yellow);
+}
+
+void AEnemy::EnterAnimSharing()
+{
+	if (UEnemyAnimSharingSubsystem* AnimSharing = GetWorld()->GetSubsystem<UEnemyAnimSharingSubsystem>())
+	{
+		AnimSharing->EnterSharing(this);
+	}
+}
+
+void AEnemy::LeaveAnimSharing()
+{
+	if (UEnemyAnimSharingSubsystem* AnimSharing = GetWorld()->GetSubsystem<UEnemyAnimSharingSubsystem>())
+	{
+		AnimSharing->LeaveSharing(this);
+	}
+}
+
 void AEnemy::MoveToTarget(AActor* Target)
 {
 	if (EnemyController == nullptr || Target == nullptr)
@@ -367,6 +841,7 @@ void AEnemy::MoveToTarget(AActor* Target)
 	MoveRequest.SetAcceptanceRadius(AcceptanceRadius);
 
 	EnemyController->MoveTo(MoveRequest);
+	SLASH_DEBUG_LINE(this, AI, GetActorLocation(), Target->GetActorLocation(), Target == CombatTarget ? FColor::Red : FColor::Blue);
 }
 
 AActor* AEnemy::ChoosePatrolTarget()
@@ -392,18 +867,81 @@ AActor* AEnemy::ChoosePatrolTarget()
 
 void AEnemy::SpawnDefaultWeapon()
 {
-	UWorld* World = GetWorld();
-	if (World && WeaponClass)
+	if (WeaponClass.IsNull() || bLoadingWeapon)
+		return;
+
+	bLoadingWeapon = true;
+	USlashAssetPreloadSubsystem::LoadClass(WeaponClass, [WeakThis = TWeakObjectPtr<AEnemy>(this)](UClass* Class)
+	{
+		AEnemy* Enemy = WeakThis.Get();
+		if (Enemy == nullptr)
+			return;
+
+		Enemy->bLoadingWeapon = false;
+		if (Enemy->EquippedWeapon)
+			return;
+
+		// 장착용 인스턴스 하나만 스폰해서 소켓에 바로 붙임
+		Enemy->EquippedWeapon = AWeapon::SpawnEquipped(Class, Enemy->GetMesh(), FName("WeaponSocket"), Enemy, Enemy);
+	});
+}
+
+void AEnemy::EquipDefaultWeapon()
+{
+	if (EquippedWeapon == nullptr)
 	{
-		// 원본 스폰
-		AWeapon* DefaultWeapon = World->SpawnActor<AWeapon>(WeaponClass);
-		if (DefaultWeapon)
-		{
-			// Equip 후, 새 무기 인스턴스를 반환받음
-			AWeapon* Equipped = DefaultWeapon->Equip(GetMesh(), FName("WeaponSocket"), this, this);
+		SpawnDefaultWeapon();
+	}
+}
+
+void AEnemy::ReleaseWeapon()
+{
+	if (EquippedWeapon)
+	{
+		EquippedWeapon->Destroy();
+		EquippedWeapon = nullptr;
+	}
+}
 
-			EquippedWeapon = Equipped;
+void AEnemy::UpdateActivation(bool bPlayerNearby)
+{
+	if (bPlayerNearby)
+	{
+		bActivated = true;
+		EnableSensing();
+		if (SlashEnemy::IsAggroState(EnemyState))
+		{
+			EquipDefaultWeapon();
 		}
+		return;
+	}
+
+	// Idle and alone: back to the lean state until a player comes near again
+	if (CombatTarget == nullptr && EnemyState <= EEnemyState::EES_Patrolling)
+	{
+		bActivated = false;
+		DisableSensing();
+		ReleaseWeapon();
+	}
+}
+
+void AEnemy::EnableSensing()
+{
+	// Sensing drives the AI, which only runs on the server
+	if (PawnSensing == nullptr || PawnSensing->IsRegistered() || !HasAuthority())
+		return;
+
+	PawnSensing->RegisterComponent();
+	PawnSensing->SetSensingUpdatesEnabled(true);
+}
+
+void AEnemy::DisableSensing()
+{
+	// The sensing timer runs on the owner, it does not stop with the registration
+	if (PawnSensing && PawnSensing->IsRegistered())
+	{
+		PawnSensing->SetSensingUpdatesEnabled(false);
+		PawnSensing->UnregisterComponent();
 	}
 }
 
@@ -423,6 +961,7 @@ void AEnemy::PawnSeen(APawn* SeenPawn)
 
 	if (bShouldChaseTarget)
 	{
+		SLASH_DEBUG_SPHERE(this, AI, SeenPawn->GetActorLocation(), 50.f, FColor::Orange);
 		CombatTarget = SeenPawn;
 		ClearPatrolTimer();
 		if (!IsOutsideCombatRadius())
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyActivationSubsystem.h"
+
+#include "Enemy/Enemy.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Slash/Slash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Activation"), STAT_EnemyActivation, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Activated Enemies"), STAT_ActivatedEnemies, STATGROUP_Slash);
+
+namespace SlashEnemyActivation
+{
+	static int32 LazyComponents = 1;
+	static FAutoConsoleVariableRef CVarLazyComponents(TEXT("Slash.Enemy.LazyComponents"), LazyComponents,
+		TEXT("1: enemies register pawn sensing and spawn their weapon only near players. 0: at BeginPlay. Read when an enemy begins play."));
+
+	static float ActivationRadius = 5000.f;
+	static FAutoConsoleVariableRef CVarActivationRadius(TEXT("Slash.Enemy.ActivationRadius"), ActivationRadius,
+		TEXT("Enemies closer than this to a player are activated; they deactivate a quarter further out."));
+
+	static float ActivationInterval = 0.5f;
+	static FAutoConsoleVariableRef CVarActivationInterval(TEXT("Slash.Enemy.ActivationInterval"), ActivationInterval,
+		TEXT("Seconds between enemy activation checks."));
+}
+
+bool UEnemyActivationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemyActivationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyActivationSubsystem, STATGROUP_Tickables);
+}
+
+bool UEnemyActivationSubsystem::AreComponentsLazy()
+{
+	return SlashEnemyActivation::LazyComponents != 0;
+}
+
+void UEnemyActivationSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	Enemies.AddUnique(Enemy);
+}
+
+void UEnemyActivationSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	Enemies.RemoveSwap(Enemy);
+}
+
+void UEnemyActivationSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceUpdate += DeltaTime;
+	if (TimeSinceUpdate >= SlashEnemyActivation::ActivationInterval)
+	{
+		TimeSinceUpdate = 0.f;
+		UpdateActivation();
+	}
+}
+
+void UEnemyActivationSubsystem::UpdateActivation()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyActivation);
+
+	// Server: every player, client: the local ones, which are the only ones it shows weapons for
+	TArray<FVector, TInlineAllocator<16>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	const double ActivateSquared = FMath::Square(SlashEnemyActivation::ActivationRadius);
+	const double DeactivateSquared = FMath::Square(SlashEnemyActivation::ActivationRadius * 1.25f);
+	int32        NumActivated = 0;
+	for (AEnemy* Enemy : Enemies)
+	{
+		const FVector Location = Enemy->GetActorLocation();
+		double        ClosestSquared = TNumericLimits<double>::Max();
+		for (const FVector& PlayerLocation : PlayerLocations)
+		{
+			ClosestSquared = FMath::Min(ClosestSquared, FVector::DistSquared(Location, PlayerLocation));
+		}
+
+		const bool bNearby = ClosestSquared < (Enemy->IsActivated() ? DeactivateSquared : ActivateSquared);
+		Enemy->UpdateActivation(bNearby);
+		NumActivated += Enemy->IsActivated();
+	}
+
+	SET_DWORD_STAT(STAT_ActivatedEnemies, NumActivated);
+}
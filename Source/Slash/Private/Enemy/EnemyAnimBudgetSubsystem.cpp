@@ -0,0 +1,180 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyAnimBudgetSubsystem.h"
+
+#include "IAnimationBudgetAllocator.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Enemy/Enemy.h"
+#include "GameFramework/PlayerController.h"
+
+namespace SlashAnimBudget
+{
+	static bool  bEnabled = true;
+	static float BudgetMs = 1.5f;
+	static float MinQuality = 0.f;
+	static int32 MaxTickRate = 10;
+	static int32 MaxInterpolatedComponents = 32;
+	static float InterpolationMaxRate = 6.f;
+	static float SignificanceMaxDistance = 4000.f;
+
+	static void OnSettingChanged(IConsoleVariable* Variable)
+	{
+		if (GEngine == nullptr)
+			return;
+
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if (UWorld* World = Context.World())
+			{
+				if (UEnemyAnimBudgetSubsystem* AnimBudget = World->GetSubsystem<UEnemyAnimBudgetSubsystem>())
+				{
+					AnimBudget->ApplyBudgetSettings();
+				}
+			}
+		}
+	}
+
+	static FAutoConsoleVariableRef CVarEnabled(TEXT("Slash.AnimBudget.Enable"), bEnabled,
+		TEXT("Enable the animation budget allocator for enemy meshes."),
+		FConsoleVariableDelegate::CreateStatic(&OnSettingChanged));
+
+	static FAutoConsoleVariableRef CVarBudgetMs(TEXT("Slash.AnimBudget.BudgetMs"), BudgetMs,
+		TEXT("Game thread time in ms enemies may spend evaluating animation per frame."),
+		FConsoleVariableDelegate::CreateStatic(&OnSettingChanged));
+
+	static FAutoConsoleVariableRef CVarMinQuality(TEXT("Slash.AnimBudget.MinQuality"), MinQuality,
+		TEXT("Lowest quality (0-1) the allocator may drop to; 0 lets far enemies tick at MaxTickRate."),
+		FConsoleVariableDelegate::CreateStatic(&OnSettingChanged));
+
+	static FAutoConsoleVariableRef CVarMaxTickRate(TEXT("Slash.AnimBudget.MaxTickRate"), MaxTickRate,
+		TEXT("Maximum number of frames between animation evaluations of a budgeted enemy."),
+		FConsoleVariableDelegate::CreateStatic(&OnSettingChanged));
+
+	static FAutoConsoleVariableRef CVarMaxInterpolated(TEXT("Slash.AnimBudget.MaxInterpolatedComponents"), MaxInterpolatedComponents,
+		TEXT("Maximum number of enemies that interpolate their skipped frames."),
+		FConsoleVariableDelegate::CreateStatic(&OnSettingChanged));
+
+	static FAutoConsoleVariableRef CVarInterpolationMaxRate(TEXT("Slash.AnimBudget.InterpolationMaxRate"), InterpolationMaxRate,
+		TEXT("Tick rate above which skipped frames are no longer interpolated."),
+		FConsoleVariableDelegate::CreateStatic(&OnSettingChanged));
+
+	static FAutoConsoleVariableRef CVarMaxDistance(TEXT("Slash.AnimBudget.SignificanceMaxDistance"), SignificanceMaxDistance,
+		TEXT("Distance from the view at which an idle enemy's significance reaches zero."));
+}
+
+void UEnemyAnimBudgetSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// The delegate is global to all budgeted meshes; CalculateSignificance resolves the world per component
+	if (!USkeletalMeshComponentBudgeted::OnCalculateSignificance().IsBound())
+	{
+		USkeletalMeshComponentBudgeted::OnCalculateSignificance().BindStatic(&UEnemyAnimBudgetSubsystem::CalculateSignificance);
+	}
+}
+
+void UEnemyAnimBudgetSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	ApplyBudgetSettings();
+}
+
+bool UEnemyAnimBudgetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyAnimBudgetSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	USkeletalMeshComponentBudgeted* Mesh = Enemy ? Cast<USkeletalMeshComponentBudgeted>(Enemy->GetMesh()) : nullptr;
+	if (Allocator && Mesh)
+	{
+		Mesh->SetAutoCalculateSignificance(true);
+		Allocator->RegisterComponent(Mesh);
+	}
+}
+
+void UEnemyAnimBudgetSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	USkeletalMeshComponentBudgeted* Mesh = Enemy ? Cast<USkeletalMeshComponentBudgeted>(Enemy->GetMesh()) : nullptr;
+	if (Allocator && Mesh)
+	{
+		Allocator->UnregisterComponent(Mesh);
+	}
+}
+
+void UEnemyAnimBudgetSubsystem::ApplyBudgetSettings()
+{
+	IAnimationBudgetAllocator* Allocator = IAnimationBudgetAllocator::Get(GetWorld());
+	if (Allocator == nullptr)
+		return;
+
+	FAnimationBudgetAllocatorParameters Parameters;
+	Parameters.BudgetInMs = SlashAnimBudget::BudgetMs;
+	Parameters.MinQuality = SlashAnimBudget::MinQuality;
+	Parameters.MaxTickRate = SlashAnimBudget::MaxTickRate;
+	Parameters.MaxInterpolatedComponents = SlashAnimBudget::MaxInterpolatedComponents;
+	Parameters.InterpolationMaxRate = SlashAnimBudget::InterpolationMaxRate;
+
+	Allocator->SetParameters(Parameters);
+	Allocator->SetEnabled(SlashAnimBudget::bEnabled);
+}
+
+/**
+ * 전투 중(Attacking/Engaged)인 적은 거리와 상관없이 항상 다른 적보다 높은 significance를 갖고,
+ * 나머지는 뷰와의 거리에 따라 1 -> 0 으로 감소합니다.
+ */
+float UEnemyAnimBudgetSubsystem::CalculateSignificance(USkeletalMeshComponentBudgeted* Component)
+{
+	const AEnemy* Enemy = Cast<AEnemy>(Component->GetOwner());
+	UWorld*       World = Component->GetWorld();
+	UEnemyAnimBudgetSubsystem* AnimBudget = World ? World->GetSubsystem<UEnemyAnimBudgetSubsystem>() : nullptr;
+	if (Enemy == nullptr || AnimBudget == nullptr)
+		return 0.f;
+
+	const double Distance = FVector::Dist(AnimBudget->GetViewLocation(), Component->GetComponentLocation());
+	float Significance = 1.f - FMath::Clamp(static_cast<float>(Distance) / SlashAnimBudget::SignificanceMaxDistance, 0.f, 1.f);
+
+	switch (Enemy->GetEnemyState())
+	{
+		case EEnemyState::EES_Holding:
+		case EEnemyState::EES_Attacking:
+		case EEnemyState::EES_Engaged:
+			Significance += 2.f;
+			break;
+		case EEnemyState::EES_Chasing:
+			Significance += 1.f;
+			break;
+		case EEnemyState::EES_Dead:
+			Significance *= 0.5f;
+			break;
+		default:
+			break;
+	}
+
+	return Significance;
+}
+
+FVector UEnemyAnimBudgetSubsystem::GetViewLocation()
+{
+	if (ViewLocationFrame != GFrameCounter)
+	{
+		ViewLocationFrame = GFrameCounter;
+
+		APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+		if (PlayerController && PlayerController->PlayerCameraManager)
+		{
+			ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+		}
+		else if (PlayerController && PlayerController->GetPawn())
+		{
+			ViewLocation = PlayerController->GetPawn()->GetActorLocation();
+		}
+	}
+	return ViewLocation;
+}
@@ -0,0 +1,51 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyAnimInstance.h"
+
+#include "Enemy/Enemy.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Slash/Slash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Anim PreUpdate (GT)"), STAT_EnemyAnimPreUpdate, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Enemy Anim ThreadSafeUpdate"), STAT_EnemyAnimThreadSafeUpdate, STATGROUP_Slash);
+
+void FEnemyAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyAnimPreUpdate);
+
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	// Game thread: copy only, no derived math here
+	const UEnemyAnimInstance* AnimInstance = CastChecked<UEnemyAnimInstance>(InAnimInstance);
+	if (const AEnemy* Enemy = AnimInstance->Enemy)
+	{
+		if (const UCharacterMovementComponent* Movement = Enemy->GetCharacterMovement())
+		{
+			Velocity = Movement->Velocity;
+			bIsFalling = Movement->IsFalling();
+		}
+		EnemyState = Enemy->GetEnemyState();
+		DeathPose = Enemy->GetDeathPose();
+	}
+}
+
+void UEnemyAnimInstance::NativeInitializeAnimation()
+{
+	Super::NativeInitializeAnimation();
+
+	Enemy = Cast<AEnemy>(TryGetPawnOwner());
+}
+
+void UEnemyAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyAnimThreadSafeUpdate);
+
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+	const FEnemyAnimInstanceProxy& Proxy = GetProxyOnAnyThread<FEnemyAnimInstanceProxy>();
+	GroundSpeed = Proxy.Velocity.Size2D();
+	IsFalling = Proxy.bIsFalling;
+	EnemyState = Proxy.EnemyState;
+	DeathPose = Proxy.DeathPose;
+}
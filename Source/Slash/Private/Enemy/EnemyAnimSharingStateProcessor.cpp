@@ -0,0 +1,35 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyAnimSharingStateProcessor.h"
+
+#include "GameFramework/Actor.h"
+
+void UEnemyAnimSharingStateProcessor::ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState, uint8 OnDemandState, bool& bShouldProcess)
+{
+	if (InActor == nullptr)
+	{
+		bShouldProcess = false;
+		return;
+	}
+
+	const double GroundSpeed = InActor->GetVelocity().Size2D();
+
+	EEnemySharedAnimState State = EEnemySharedAnimState::ESAS_Jog;
+	if (GroundSpeed < WalkSpeedThreshold)
+	{
+		State = EEnemySharedAnimState::ESAS_Idle;
+	}
+	else if (GroundSpeed < JogSpeedThreshold)
+	{
+		State = EEnemySharedAnimState::ESAS_Walk;
+	}
+
+	OutState = static_cast<int32>(State);
+	bShouldProcess = true;
+}
+
+UEnum* UEnemyAnimSharingStateProcessor::GetAnimationStateEnum_Implementation()
+{
+	return StaticEnum<EEnemySharedAnimState>();
+}
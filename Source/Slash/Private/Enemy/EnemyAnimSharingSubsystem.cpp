@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyAnimSharingSubsystem.h"
+
+#include "AnimationSharingManager.h"
+#include "AnimationSharingSetup.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Enemy/Enemy.h"
+#include "Enemy/EnemyAnimBudgetSubsystem.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Slash/Slash.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Evaluated Enemy Poses"), STAT_EvaluatedEnemyPoses, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Shared Leader Poses"), STAT_SharedLeaderPoses, STATGROUP_Slash);
+CSV_DEFINE_CATEGORY(SlashAnimSharing, true);
+
+namespace SlashAnimSharing
+{
+	static bool bEnabled = true;
+	static FAutoConsoleVariableRef CVarEnabled(TEXT("Slash.AnimSharing.Enable"), bEnabled,
+		TEXT("Let patrolling enemies copy their pose from shared leader meshes. Takes effect on the next world begin play."));
+}
+
+void UEnemyAnimSharingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (!SlashAnimSharing::bEnabled || !UAnimationSharingManager::AnimationSharingEnabled())
+		return;
+
+	if (const UAnimationSharingSetup* Setup = AnimationSharingSetup.LoadSynchronous())
+	{
+		UAnimationSharingManager::CreateAnimationSharingManager(&InWorld, Setup);
+		SharingManager = UAnimationSharingManager::GetAnimationSharingManager(&InWorld);
+	}
+	else if (!AnimationSharingSetup.IsNull())
+	{
+		UE_LOG(LogSlash, Warning, TEXT("Anim sharing - setup %s not found, every enemy evaluates its own pose"), *AnimationSharingSetup.ToString());
+	}
+}
+
+bool UEnemyAnimSharingSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyAnimSharingSubsystem::Tick(float DeltaTime)
+{
+	const int32 NumLeaderPoses = GetNumLeaderPoses();
+	SET_DWORD_STAT(STAT_EvaluatedEnemyPoses, UniqueEnemies.Num() + NumLeaderPoses);
+	SET_DWORD_STAT(STAT_SharedLeaderPoses, NumLeaderPoses);
+	CSV_CUSTOM_STAT(SlashAnimSharing, EvaluatedPoses, UniqueEnemies.Num() + NumLeaderPoses, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SlashAnimSharing, LeaderPoses, NumLeaderPoses, ECsvCustomStatOp::Set);
+}
+
+int32 UEnemyAnimSharingSubsystem::GetNumLeaderPoses() const
+{
+	// Followers copy from a state leader, or from a blend actor while they change state; each of those evaluates once
+	TSet<const USkinnedMeshComponent*, DefaultKeyFuncs<const USkinnedMeshComponent*>, TInlineSetAllocator<32>> Leaders;
+	for (const TWeakObjectPtr<AEnemy>& Enemy : SharedEnemies)
+	{
+		const USkinnedMeshComponent* Leader = Enemy.IsValid() ? Enemy->GetMesh()->LeaderPoseComponent.Get() : nullptr;
+		if (Leader)
+		{
+			Leaders.Add(Leader);
+		}
+	}
+	return Leaders.Num();
+}
+
+TStatId UEnemyAnimSharingSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyAnimSharingSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemyAnimSharingSubsystem::AddEnemy(AEnemy* Enemy)
+{
+	UniqueEnemies.Add(Enemy);
+	EnterSharing(Enemy);
+}
+
+void UEnemyAnimSharingSubsystem::RemoveEnemy(AEnemy* Enemy)
+{
+	LeaveSharing(Enemy);
+	UniqueEnemies.Remove(Enemy);
+}
+
+void UEnemyAnimSharingSubsystem::EnterSharing(AEnemy* Enemy)
+{
+	if (SharingManager == nullptr || Enemy == nullptr || Enemy->GetEnemyState() != EEnemyState::EES_Patrolling)
+		return;
+
+	if (UniqueEnemies.Remove(Enemy) == 0)
+		return; // Already shared, or never added
+
+	// A follower mesh does not evaluate its own graph, so it no longer needs an animation budget
+	if (UEnemyAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UEnemyAnimBudgetSubsystem>())
+	{
+		AnimBudget->UnregisterEnemy(Enemy);
+	}
+
+	SharingManager->RegisterActor(Enemy, FUpdateActorHandle::CreateLambda([](int32 Handle) {}));
+	SharedEnemies.Add(Enemy);
+}
+
+void UEnemyAnimSharingSubsystem::LeaveSharing(AEnemy* Enemy)
+{
+	if (SharedEnemies.Remove(Enemy) == 0)
+		return;
+
+	if (SharingManager)
+	{
+		SharingManager->UnregisterActor(Enemy);
+	}
+
+	if (UEnemyAnimBudgetSubsystem* AnimBudget = GetWorld()->GetSubsystem<UEnemyAnimBudgetSubsystem>())
+	{
+		AnimBudget->RegisterEnemy(Enemy);
+	}
+
+	UniqueEnemies.Add(Enemy);
+}
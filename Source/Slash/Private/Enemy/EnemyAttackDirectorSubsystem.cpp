@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyAttackDirectorSubsystem.h"
+
+#include "Enemy/Enemy.h"
+#include "Slash/Slash.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Attack Token Holders"), STAT_AttackTokenHolders, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Attack Tokens Denied"), STAT_AttackTokensDenied, STATGROUP_Slash);
+
+namespace SlashAttackTokens
+{
+	static int32 PerTarget = 3;
+	static FAutoConsoleVariableRef CVarPerTarget(TEXT("Slash.AttackTokens.PerTarget"), PerTarget,
+		TEXT("Attack tokens per target, an enemy needs its archetype's token cost to attack. 0 lets every enemy attack."));
+}
+
+bool UEnemyAttackDirectorSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool UEnemyAttackDirectorSubsystem::IsEnabled()
+{
+	return SlashAttackTokens::PerTarget > 0;
+}
+
+bool UEnemyAttackDirectorSubsystem::RequestToken(AEnemy* Enemy, AActor* Target, int32 Cost)
+{
+	if (const FHeldTokens* Held = TokensByHolder.Find(Enemy))
+	{
+		if (Held->Target == Target)
+			return true;
+
+		ReleaseToken(Enemy);
+	}
+
+	// An archetype costing more than there are tokens still attacks, alone
+	Cost = FMath::Clamp(Cost, 1, SlashAttackTokens::PerTarget);
+
+	if (const AActor* const* WaitingFor = TargetByWaiter.Find(Enemy); WaitingFor && *WaitingFor != Target)
+	{
+		StopWaiting(Enemy);
+	}
+
+	FTargetTokens& Tokens = TokensByTarget.FindOrAdd(Target);
+	if (Tokens.Used + Cost > SlashAttackTokens::PerTarget)
+	{
+		Tokens.Waiting.Add(Enemy);
+		TargetByWaiter.Add(Enemy, Target);
+		INC_DWORD_STAT(STAT_AttackTokensDenied);
+		return false;
+	}
+
+	Tokens.Used += Cost;
+	Tokens.Waiting.Remove(Enemy);
+	TargetByWaiter.Remove(Enemy);
+	TokensByHolder.Add(Enemy, { Target, Cost });
+	INC_DWORD_STAT(STAT_AttackTokenHolders);
+	return true;
+}
+
+bool UEnemyAttackDirectorSubsystem::ReleaseToken(AEnemy* Enemy)
+{
+	StopWaiting(Enemy);
+
+	FHeldTokens Held;
+	if (!TokensByHolder.RemoveAndCopyValue(Enemy, Held))
+		return false;
+
+	FTargetTokens& Tokens = TokensByTarget.FindChecked(Held.Target);
+	const bool     bContested = Tokens.Waiting.Num() > 0;
+	Tokens.Used -= Held.Cost;
+	RemoveIfUnused(Held.Target);
+	DEC_DWORD_STAT(STAT_AttackTokenHolders);
+	return bContested;
+}
+
+void UEnemyAttackDirectorSubsystem::StopWaiting(const AEnemy* Enemy)
+{
+	const AActor* Target = nullptr;
+	if (!TargetByWaiter.RemoveAndCopyValue(Enemy, Target))
+		return;
+
+	TokensByTarget.FindChecked(Target).Waiting.Remove(Enemy);
+	RemoveIfUnused(Target);
+}
+
+void UEnemyAttackDirectorSubsystem::RemoveIfUnused(const AActor* Target)
+{
+	const FTargetTokens& Tokens = TokensByTarget.FindChecked(Target);
+	if (Tokens.Used <= 0 && Tokens.Waiting.Num() == 0)
+	{
+		TokensByTarget.Remove(Target);
+	}
+}
+
+int32 UEnemyAttackDirectorSubsystem::GetNumTokensUsed(const AActor* Target) const
+{
+	const FTargetTokens* Tokens = TokensByTarget.Find(Target);
+	return Tokens ? Tokens->Used : 0;
+}
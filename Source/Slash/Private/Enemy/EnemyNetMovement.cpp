@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyNetMovement.h"
+
+namespace EnemyNetMovement
+{
+	static constexpr float OffsetScale = 65535.f / FEnemyNetMovement::CellSize;
+
+	static uint32 ZigZag(int32 Value) { return static_cast<uint32>((Value << 1) ^ (Value >> 31)); }
+	static int32  UnZigZag(uint32 Value) { return static_cast<int32>(Value >> 1) ^ -static_cast<int32>(Value & 1); }
+
+	static void SerializeSigned(FArchive& Ar, int32& Value)
+	{
+		uint32 Packed = ZigZag(Value);
+		Ar.SerializeIntPacked(Packed);
+		Value = UnZigZag(Packed);
+	}
+
+	/** SerializeIntPacked stores 7 bits per byte */
+	static int32 GetSignedSize(int32 Value)
+	{
+		int32 NumBytes = 1;
+		for (uint32 Packed = ZigZag(Value) >> 7; Packed != 0; Packed >>= 7)
+		{
+			++NumBytes;
+		}
+		return NumBytes;
+	}
+
+	/** The integers NetSerialize writes */
+	struct FQuantized
+	{
+		int32  CellX;
+		int32  CellY;
+		uint16 OffsetX;
+		uint16 OffsetY;
+		int32  HalfZ;
+		uint8  CompressedYaw;
+		int32  VelocityX;
+		int32  VelocityY;
+	};
+
+	static FQuantized Quantize(const FEnemyNetMovement& Movement)
+	{
+		FQuantized Quantized;
+		Quantized.CellX = FMath::FloorToInt32(Movement.Location.X / FEnemyNetMovement::CellSize);
+		Quantized.CellY = FMath::FloorToInt32(Movement.Location.Y / FEnemyNetMovement::CellSize);
+		Quantized.OffsetX = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32((Movement.Location.X - Quantized.CellX * FEnemyNetMovement::CellSize) * OffsetScale), 0, MAX_uint16));
+		Quantized.OffsetY = static_cast<uint16>(FMath::Clamp(FMath::RoundToInt32((Movement.Location.Y - Quantized.CellY * FEnemyNetMovement::CellSize) * OffsetScale), 0, MAX_uint16));
+		Quantized.HalfZ = FMath::RoundToInt32(Movement.Location.Z * 2.0);
+		Quantized.CompressedYaw = FRotator::CompressAxisToByte(Movement.Yaw);
+		Quantized.VelocityX = FMath::RoundToInt32(Movement.Velocity.X);
+		Quantized.VelocityY = FMath::RoundToInt32(Movement.Velocity.Y);
+		return Quantized;
+	}
+}
+
+FEnemyNetMovement FEnemyNetMovement::Make(const FVector& InLocation, float InYaw, const FVector& InVelocity)
+{
+	using namespace EnemyNetMovement;
+
+	FEnemyNetMovement Movement;
+	for (int32 Axis = 0; Axis < 2; ++Axis)
+	{
+		const double Cell = FMath::FloorToDouble(InLocation[Axis] / CellSize);
+		const double Offset = FMath::RoundToDouble((InLocation[Axis] - Cell * CellSize) * OffsetScale);
+		Movement.Location[Axis] = Cell * CellSize + FMath::Min(Offset, 65535.0) / OffsetScale;
+		Movement.Velocity[Axis] = FMath::Clamp(FMath::RoundToFloat(InVelocity[Axis]), -32767.f, 32767.f);
+	}
+	Movement.Location.Z = FMath::RoundToDouble(InLocation.Z * 2.0) / 2.0;
+	Movement.Yaw = FRotator::DecompressAxisFromByte(FRotator::CompressAxisToByte(InYaw));
+	return Movement;
+}
+
+bool FEnemyNetMovement::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	using namespace EnemyNetMovement;
+
+	FQuantized Quantized = Quantize(*this);
+	SerializeSigned(Ar, Quantized.CellX);
+	SerializeSigned(Ar, Quantized.CellY);
+	Ar << Quantized.OffsetX;
+	Ar << Quantized.OffsetY;
+	SerializeSigned(Ar, Quantized.HalfZ);
+	Ar << Quantized.CompressedYaw;
+	SerializeSigned(Ar, Quantized.VelocityX);
+	SerializeSigned(Ar, Quantized.VelocityY);
+
+	if (Ar.IsLoading())
+	{
+		// In double like Make, so the client ends up with exactly the server's value far from the origin too
+		Location.X = Quantized.CellX * static_cast<double>(CellSize) + Quantized.OffsetX / static_cast<double>(OffsetScale);
+		Location.Y = Quantized.CellY * static_cast<double>(CellSize) + Quantized.OffsetY / static_cast<double>(OffsetScale);
+		Location.Z = Quantized.HalfZ / 2.0;
+		Yaw = FRotator::DecompressAxisFromByte(Quantized.CompressedYaw);
+		Velocity = FVector2D(Quantized.VelocityX, Quantized.VelocityY);
+	}
+
+	bOutSuccess = true;
+	return true;
+}
+
+int32 FEnemyNetMovement::GetNetSize() const
+{
+	using namespace EnemyNetMovement;
+
+	// Two uint16 offsets and the yaw byte are fixed size
+	const FQuantized Quantized = Quantize(*this);
+	return GetSignedSize(Quantized.CellX) + GetSignedSize(Quantized.CellY) + 4 + GetSignedSize(Quantized.HalfZ) + 1
+		+ GetSignedSize(Quantized.VelocityX) + GetSignedSize(Quantized.VelocityY);
+}
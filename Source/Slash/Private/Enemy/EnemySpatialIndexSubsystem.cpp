@@ -0,0 +1,126 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemySpatialIndexSubsystem.h"
+
+#include "Enemy/Enemy.h"
+#include "Slash/Slash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Index Refresh"), STAT_EnemyIndexRefresh, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Enemy Index Query"), STAT_EnemyIndexQuery, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Enemy Index Enemies"), STAT_EnemyIndexEnemies, STATGROUP_Slash);
+
+namespace SlashEnemyIndex
+{
+	static float CellSize = 1000.f;
+	static FAutoConsoleVariableRef CVarCellSize(TEXT("Slash.Enemy.IndexCellSize"), CellSize,
+		TEXT("Grid cell size of the enemy spatial index. Only read when the world starts."));
+
+	static float Interval = 0.1f;
+	static FAutoConsoleVariableRef CVarInterval(TEXT("Slash.Enemy.IndexInterval"), Interval,
+		TEXT("Seconds between moving enemies to their current cell in the spatial index."));
+}
+
+bool UEnemySpatialIndexSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemySpatialIndexSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySpatialIndexSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UEnemySpatialIndexSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / SlashEnemyIndex::CellSize), FMath::FloorToInt32(Location.Y / SlashEnemyIndex::CellSize));
+}
+
+void UEnemySpatialIndexSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	if (CellByEnemy.Contains(Enemy))
+		return;
+
+	const FIntPoint Cell = GetCell(Enemy->GetActorLocation());
+	Cells.FindOrAdd(Cell).Add(Enemy);
+	CellByEnemy.Add(Enemy, Cell);
+	INC_DWORD_STAT(STAT_EnemyIndexEnemies);
+}
+
+void UEnemySpatialIndexSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	FIntPoint Cell;
+	if (!CellByEnemy.RemoveAndCopyValue(Enemy, Cell))
+		return;
+
+	if (TArray<AEnemy*>* Enemies = Cells.Find(Cell))
+	{
+		Enemies->RemoveSwap(Enemy, EAllowShrinking::No);
+	}
+	DEC_DWORD_STAT(STAT_EnemyIndexEnemies);
+}
+
+void UEnemySpatialIndexSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceRefresh += DeltaTime;
+	if (TimeSinceRefresh >= SlashEnemyIndex::Interval)
+	{
+		TimeSinceRefresh = 0.f;
+		Refresh();
+	}
+}
+
+int32 UEnemySpatialIndexSubsystem::Refresh()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyIndexRefresh);
+
+	int32 NumMoved = 0;
+	for (TPair<AEnemy*, FIntPoint>& Pair : CellByEnemy)
+	{
+		const FIntPoint NewCell = GetCell(Pair.Key->GetActorLocation());
+		if (NewCell == Pair.Value)
+			continue;
+
+		if (TArray<AEnemy*>* Enemies = Cells.Find(Pair.Value))
+		{
+			Enemies->RemoveSwap(Pair.Key, EAllowShrinking::No);
+		}
+		Cells.FindOrAdd(NewCell).Add(Pair.Key);
+		Pair.Value = NewCell;
+		++NumMoved;
+	}
+	return NumMoved;
+}
+
+int32 UEnemySpatialIndexSubsystem::GatherInRadius(const FVector& Origin, float Radius, TArray<AEnemy*>& OutEnemies) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyIndexQuery);
+
+	// An enemy may have walked up to a cell out of its indexed one since the last refresh
+	const float     CellRadius = Radius + SlashEnemyIndex::CellSize;
+	const FIntPoint MinCell = GetCell(Origin - FVector(CellRadius));
+	const FIntPoint MaxCell = GetCell(Origin + FVector(CellRadius));
+	const double    RadiusSquared = FMath::Square(Radius);
+	const FName     DeadTag("Dead");
+
+	int32 NumTested = 0;
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<AEnemy*>* Enemies = Cells.Find(FIntPoint(X, Y));
+			if (Enemies == nullptr)
+				continue;
+
+			NumTested += Enemies->Num();
+			for (AEnemy* Enemy : *Enemies)
+			{
+				if (FVector::DistSquared2D(Origin, Enemy->GetActorLocation()) <= RadiusSquared && !Enemy->ActorHasTag(DeadTag))
+				{
+					OutEnemies.Add(Enemy);
+				}
+			}
+		}
+	}
+	return NumTested;
+}
@@ -0,0 +1,216 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "HUD/EnemyHealthBarLayer.h"
+
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+#include "Components/ProgressBar.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "HUD/HealthBar.h"
+#include "HUD/SlashHUD.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "SceneView.h"
+#include "Slash/Slash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Health Bar Layer"), STAT_HealthBarLayer, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Health Bars Shown"), STAT_HealthBarsShown, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Health Bars Bound"), STAT_HealthBarsBound, STATGROUP_Slash);
+
+CSV_DEFINE_CATEGORY(SlashHUD, true);
+
+namespace SlashHealthBars
+{
+	static int32 PoolSize = 32;
+	static FAutoConsoleVariableRef CVarPoolSize(TEXT("Slash.HealthBars.PoolSize"), PoolSize,
+		TEXT("Number of enemy health bars on screen at once, the closest enemies get them. Read when the HUD is created."));
+
+	static float MaxDistance = 5000.f;
+	static FAutoConsoleVariableRef CVarMaxDistance(TEXT("Slash.HealthBars.MaxDistance"), MaxDistance,
+		TEXT("Enemies further than this from the camera show no health bar."));
+
+	static float HeightOffset = 30.f;
+	static FAutoConsoleVariableRef CVarHeightOffset(TEXT("Slash.HealthBars.HeightOffset"), HeightOffset,
+		TEXT("Height of the health bar above the enemy's capsule."));
+
+	static const FVector2D BarSize(120.f, 12.f);
+}
+
+UEnemyHealthBarLayer* UEnemyHealthBarLayer::Get(const UObject* WorldContextObject)
+{
+	const UWorld*      World = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	APlayerController* Controller = World ? World->GetFirstPlayerController() : nullptr;
+	const ASlashHUD*   HUD = Controller ? Controller->GetHUD<ASlashHUD>() : nullptr;
+	return HUD ? HUD->GetEnemyHealthBars() : nullptr;
+}
+
+void UEnemyHealthBarLayer::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// No designer layout, the layer is a full screen canvas holding the pool
+	Canvas = WidgetTree->ConstructWidget<UCanvasPanel>(UCanvasPanel::StaticClass(), TEXT("HealthBarCanvas"));
+	WidgetTree->RootWidget = Canvas;
+	SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void UEnemyHealthBarLayer::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	if (Bars.Num() == 0)
+	{
+		BuildPool();
+	}
+}
+
+void UEnemyHealthBarLayer::SetBarClass(TSubclassOf<UHealthBar> InBarClass)
+{
+	BarClass = InBarClass;
+}
+
+void UEnemyHealthBarLayer::BuildPool()
+{
+	for (int32 Index = 0; Index < SlashHealthBars::PoolSize; ++Index)
+	{
+		FBar Bar;
+		if (BarClass)
+		{
+			UHealthBar* HealthBar = CreateWidget<UHealthBar>(this, BarClass);
+			Bar.Widget = HealthBar;
+			Bar.Progress = HealthBar->HealthBar;
+		}
+		else
+		{
+			Bar.Progress = WidgetTree->ConstructWidget<UProgressBar>();
+			Bar.Progress->SetFillColorAndOpacity(FLinearColor::Red);
+			Bar.Widget = Bar.Progress;
+		}
+
+		Bar.Slot = Canvas->AddChildToCanvas(Bar.Widget);
+		Bar.Slot->SetAlignment(FVector2D(0.5f, 1.f));
+		Bar.Slot->SetSize(SlashHealthBars::BarSize);
+		Bar.Widget->SetVisibility(ESlateVisibility::Collapsed);
+		Bars.Add(Bar);
+	}
+}
+
+void UEnemyHealthBarLayer::ShowEnemy(AActor* Enemy, float Percent)
+{
+	Shown.Add(Enemy, Percent);
+	SET_DWORD_STAT(STAT_HealthBarsShown, Shown.Num());
+}
+
+void UEnemyHealthBarLayer::HideEnemy(AActor* Enemy)
+{
+	Shown.Remove(Enemy);
+	SET_DWORD_STAT(STAT_HealthBarsShown, Shown.Num());
+}
+
+void UEnemyHealthBarLayer::SetEnemyPercent(AActor* Enemy, float Percent)
+{
+	if (float* ShownPercent = Shown.Find(Enemy))
+	{
+		*ShownPercent = Percent;
+	}
+}
+
+void UEnemyHealthBarLayer::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	SCOPE_CYCLE_COUNTER(STAT_HealthBarLayer);
+	CSV_SCOPED_TIMING_STAT(SlashHUD, HealthBarLayer);
+
+	BindBars();
+
+	SET_DWORD_STAT(STAT_HealthBarsBound, NumBound);
+	CSV_CUSTOM_STAT(SlashHUD, HealthBarsShown, Shown.Num(), ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SlashHUD, HealthBarsBound, NumBound, ECsvCustomStatOp::Set);
+}
+
+void UEnemyHealthBarLayer::BindBars()
+{
+	struct FCandidate
+	{
+		AActor*   Enemy;
+		FVector2D Position;
+		double    DistanceSquared;
+		float     Percent;
+	};
+
+	TArray<FCandidate, TInlineAllocator<64>> Candidates;
+
+	// One view projection for every enemy, instead of a projection per widget component
+	ULocalPlayer*            LocalPlayer = GetOwningLocalPlayer();
+	FSceneViewProjectionData ProjectionData;
+	if (Shown.Num() > 0 && LocalPlayer && LocalPlayer->ViewportClient && LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData))
+	{
+		const FMatrix  ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+		const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+		const float    ViewportScale = UWidgetLayoutLibrary::GetViewportScale(this);
+		const double   MaxDistanceSquared = FMath::Square(SlashHealthBars::MaxDistance);
+
+		for (auto It = Shown.CreateIterator(); It; ++It)
+		{
+			AActor* Enemy = It->Key.Get();
+			if (Enemy == nullptr)
+			{
+				It.RemoveCurrent();
+				continue;
+			}
+
+			const double DistanceSquared = FVector::DistSquared(ProjectionData.ViewOrigin, Enemy->GetActorLocation());
+			if (DistanceSquared > MaxDistanceSquared || !Enemy->WasRecentlyRendered(0.2f))
+				continue;
+
+			float Radius = 0.f;
+			float HalfHeight = 0.f;
+			Enemy->GetSimpleCollisionCylinder(Radius, HalfHeight);
+			const FVector Anchor = Enemy->GetActorLocation() + FVector(0.f, 0.f, HalfHeight + SlashHealthBars::HeightOffset);
+
+			FVector2D ScreenPosition;
+			if (FSceneView::ProjectWorldToScreen(Anchor, ViewRect, ViewProjection, ScreenPosition))
+			{
+				Candidates.Add({ Enemy, ScreenPosition / ViewportScale, DistanceSquared, It->Value });
+			}
+		}
+	}
+
+	if (Candidates.Num() > Bars.Num())
+	{
+		Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistanceSquared < B.DistanceSquared; });
+	}
+
+	NumBound = FMath::Min(Candidates.Num(), Bars.Num());
+	for (int32 Index = 0; Index < Bars.Num(); ++Index)
+	{
+		FBar& Bar = Bars[Index];
+		if (Index >= NumBound)
+		{
+			if (Bar.Enemy.IsValid() || Bar.Widget->IsVisible())
+			{
+				Bar.Widget->SetVisibility(ESlateVisibility::Collapsed);
+				Bar.Enemy = nullptr;
+			}
+			continue;
+		}
+
+		const FCandidate& Candidate = Candidates[Index];
+		Bar.Enemy = Candidate.Enemy;
+		Bar.Slot->SetPosition(Candidate.Position);
+		if (Bar.Percent != Candidate.Percent && Bar.Progress)
+		{
+			Bar.Percent = Candidate.Percent;
+			Bar.Progress->SetPercent(Candidate.Percent);
+		}
+		if (!Bar.Widget->IsVisible())
+		{
+			Bar.Widget->SetVisibility(ESlateVisibility::HitTestInvisible);
+		}
+	}
+}
@@ -2,12 +2,17 @@
 
 
 #include "HUD/SlashHUD.h"
+#include "HUD/EnemyHealthBarLayer.h"
 #include "HUD/SlashOverlay.h"
 
 void ASlashHUD::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Headless bots (-nullrhi) have nothing to draw the overlay on
+	if (!FApp::CanEverRender())
+		return;
+
 	UWorld* World = GetWorld();
 	if (World)
 	{
@@ -17,5 +22,13 @@ void ASlashHUD::BeginPlay()
 			SlashOverlay = CreateWidget<USlashOverlay>(Controller, SlashOverlayClass);
 			SlashOverlay->AddToViewport();
 		}
+
+		// Below the overlay
+		if (Controller)
+		{
+			EnemyHealthBars = CreateWidget<UEnemyHealthBarLayer>(Controller, UEnemyHealthBarLayer::StaticClass());
+			EnemyHealthBars->SetBarClass(EnemyHealthBarClass);
+			EnemyHealthBars->AddToViewport(-1);
+		}
 	}
 }
\ No newline at end of file
@@ -9,6 +9,6 @@ void IPickupInterface::SetOverlappingItem(class AItem* Item)
 	
 }
 
-void IPickupInterface::AddSouls(class ASoul* Soul) {}
+void IPickupInterface::AddSouls(int32 NumberOfSouls) {}
 
-void IPickupInterface::AddGold(class ATreasure* AmountOfGold) {}
\ No newline at end of file
+void IPickupInterface::AddGold(int32 AmountOfGold) {}
\ No newline at end of file
@@ -3,17 +3,24 @@
 
 #include "Items/Item.h"
 
-#include "Slash/DebugMacros.h"
 #include "Components/SphereComponent.h"
 #include "NiagaraComponent.h"
-#include "NiagaraFunctionLibrary.h"
 #include "Interfaces/PickupInterface.h"
-#include "Kismet/GameplayStatics.h"
+#include "Items/PickupProximitySubsystem.h"
+#include "Items/PickupSubsystem.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "World/SlashFeedbackSubsystem.h"
+#include "World/SlashWorldStateSubsystem.h"
 
 AItem::AItem()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	// Hovering is simulated locally, the server only sends spawn, collection and removal
+	bReplicates = true;
+	NetDormancy = DORM_DormantAll;
+
 	ItemMesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("ItemMeshComponent"));
 	RootComponent = ItemMesh;
 	ItemMesh->SetCollisionResponseToAllChannels(ECR_Ignore);
@@ -21,17 +28,67 @@ AItem::AItem()
 
 	Sphere = CreateDefaultSubobject<USphereComponent>(TEXT("Sphere"));
 	Sphere->SetupAttachment(GetRootComponent());
+	Sphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Sphere->SetGenerateOverlapEvents(false);
 
 	ItemEffect = CreateDefaultSubobject<UNiagaraComponent>(TEXT("Embers"));
 	ItemEffect->SetupAttachment(GetRootComponent());
 }
 
+void AItem::PreRegisterAllComponents()
+{
+	Super::PreRegisterAllComponents();
+
+	// Already collected in an earlier visit of this cell: nothing registers and the actor is dropped once initialized
+	const UWorld* World = GetWorld();
+	if (World && !IsActorInitialized())
+	{
+		USlashWorldStateSubsystem* WorldState = World->GetSubsystem<USlashWorldStateSubsystem>();
+		bSkippedOnLoad = WorldState && WorldState->ShouldSkipOnLoad(this);
+	}
+}
+
+void AItem::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	if (bSkippedOnLoad)
+	{
+		Destroy();
+	}
+}
+
+void AItem::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AItem, bItemActive, Params);
+}
+
 void AItem::BeginPlay()
 {
 	Super::BeginPlay();
 
-	Sphere->OnComponentBeginOverlap.AddDynamic(this, &AItem::OnSphereOverlap);
-	Sphere->OnComponentEndOverlap.AddDynamic(this, &AItem::OnSphereEndOverlap);
+	// Blueprints may still have the sphere's old overlap settings
+	Sphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Sphere->SetGenerateOverlapEvents(false);
+
+	if (UPickupProximitySubsystem* Proximity = GetWorld()->GetSubsystem<UPickupProximitySubsystem>())
+	{
+		Proximity->RegisterItem(this);
+	}
+}
+
+void AItem::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPickupProximitySubsystem* Proximity = GetWorld()->GetSubsystem<UPickupProximitySubsystem>())
+	{
+		Proximity->UnregisterItem(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 float AItem::TransformedSin()
@@ -52,28 +109,110 @@ void AItem::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* Ot
 	}
 }
 
-void AItem::OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+void AItem::NotifyPlayerTouch(AActor* Player)
 {
-	if (IPickupInterface* PickupInterface = Cast<IPickupInterface>(OtherActor))
-	{
-		PickupInterface->SetOverlappingItem(nullptr);
-	}
+	OnSphereOverlap(Sphere, Player, nullptr, INDEX_NONE, false, FHitResult());
+}
+
+float AItem::GetContactRadius() const
+{
+	return Sphere ? Sphere->GetScaledSphereRadius() : 0.f;
 }
 
 void AItem::SpawnPickupSystem()
 {
-	if (PickupEffect)
+	if (USlashFeedbackSubsystem* Feedback = GetWorld()->GetSubsystem<USlashFeedbackSubsystem>())
 	{
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), PickupEffect, GetActorLocation());
+		Feedback->SpawnNiagara(PickupEffect, GetActorLocation());
 	}
 }
 
 void AItem::SpawnPickupSound()
 {
-	if (PickupSound)
+	if (USlashFeedbackSubsystem* Feedback = GetWorld()->GetSubsystem<USlashFeedbackSubsystem>())
+	{
+		Feedback->PlaySound(PickupSound, GetActorLocation());
+	}
+}
+
+void AItem::MarkConsumed()
+{
+	if (USlashWorldStateSubsystem* WorldState = GetWorld()->GetSubsystem<USlashWorldStateSubsystem>())
+	{
+		WorldState->MarkConsumed(this);
+	}
+}
+
+void AItem::Consume()
+{
+	MarkConsumed();
+
+	// Placed pickups stay loaded (hidden) so a checkpoint can bring them back without a respawn
+	if (USlashWorldStateSubsystem::IsTrackedActor(this))
+	{
+		SetItemActive(false);
+	}
+	else
+	{
+		Destroy();
+	}
+}
+
+void AItem::InitPickup(uint32 Id, int32 Value)
+{
+	PickupId = Id;
+	bPickupVisual = true;
+}
+
+void AItem::PlayPickupEffects()
+{
+	SpawnPickupSystem();
+	SpawnPickupSound();
+}
+
+bool AItem::TryCollectAsPickup(AActor* Collector)
+{
+	if (!bPickupVisual)
+		return false;
+
+	if (UPickupSubsystem* Pickups = GetWorld()->GetSubsystem<UPickupSubsystem>())
+	{
+		Pickups->RequestCollect(this, Collector);
+	}
+	return true;
+}
+
+void AItem::SetItemActive(bool bActive)
+{
+	if (HasAuthority() && bItemActive != bActive)
+	{
+		FlushNetDormancy();
+		bItemActive = bActive;
+		MARK_PROPERTY_DIRTY_FROM_NAME(AItem, bItemActive, this);
+	}
+
+	SetActorHiddenInGame(!bActive);
+	SetActorEnableCollision(bActive);
+	SetActorTickEnabled(bActive);
+
+	// Pooled pickup visuals come back at a new location
+	if (bActive)
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, PickupSound, GetActorLocation());
+		if (UPickupProximitySubsystem* Proximity = GetWorld()->GetSubsystem<UPickupProximitySubsystem>())
+		{
+			Proximity->UpdateItem(this);
+		}
 	}
+
+	if (ItemEffect)
+	{
+		bActive ? ItemEffect->Activate() : ItemEffect->Deactivate();
+	}
+}
+
+void AItem::OnRep_ItemActive()
+{
+	SetItemActive(bItemActive);
 }
 
 void AItem::Tick(float DeltaTime)
@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Items/PickupCell.h"
+
+#include "Items/Item.h"
+#include "Items/PickupSubsystem.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+
+void FPickupEntry::PostReplicatedAdd(const FPickupArray& InArraySerializer)
+{
+	if (UPickupSubsystem* Pickups = InArraySerializer.Cell->GetWorld()->GetSubsystem<UPickupSubsystem>())
+	{
+		Pickups->OnEntryAdded(InArraySerializer.Cell, *this);
+	}
+}
+
+void FPickupEntry::PreReplicatedRemove(const FPickupArray& InArraySerializer)
+{
+	if (UPickupSubsystem* Pickups = InArraySerializer.Cell->GetWorld()->GetSubsystem<UPickupSubsystem>())
+	{
+		Pickups->OnEntryRemoved(*this, true);
+	}
+}
+
+APickupCell::APickupCell()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
+
+	bReplicates = true;
+	SetReplicatingMovement(false);
+	NetUpdateFrequency = 10.f;
+
+	Pickups.Cell = this;
+}
+
+void APickupCell::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(APickupCell, Classes, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(APickupCell, Pickups, Params);
+}
+
+void APickupCell::AddEntry(uint32 Id, TSubclassOf<AItem> Class, const FVector& Location, int32 Value)
+{
+	int32 ClassIndex = Classes.IndexOfByKey(Class);
+	if (ClassIndex == INDEX_NONE)
+	{
+		ClassIndex = Classes.Add(Class);
+		MARK_PROPERTY_DIRTY_FROM_NAME(APickupCell, Classes, this);
+	}
+
+	FPickupEntry& Entry = Pickups.Entries.AddDefaulted_GetRef();
+	Entry.Id = Id;
+	Entry.ClassIndex = static_cast<uint8>(ClassIndex);
+	Entry.Location = Location;
+	Entry.Value = Value;
+	Pickups.MarkItemDirty(Entry);
+	MARK_PROPERTY_DIRTY_FROM_NAME(APickupCell, Pickups, this);
+	ForceNetUpdate();
+}
+
+bool APickupCell::RemoveEntry(uint32 Id, FPickupEntry& OutEntry)
+{
+	const int32 Index = Pickups.Entries.IndexOfByPredicate([Id](const FPickupEntry& Entry) { return Entry.Id == Id; });
+	if (Index == INDEX_NONE)
+		return false;
+
+	OutEntry = Pickups.Entries[Index];
+	Pickups.Entries.RemoveAtSwap(Index);
+	Pickups.MarkArrayDirty();
+	MARK_PROPERTY_DIRTY_FROM_NAME(APickupCell, Pickups, this);
+	ForceNetUpdate();
+	return true;
+}
+
+void APickupCell::RemoveAllEntries()
+{
+	if (Pickups.Entries.IsEmpty())
+		return;
+
+	Pickups.Entries.Reset();
+	Pickups.MarkArrayDirty();
+	MARK_PROPERTY_DIRTY_FROM_NAME(APickupCell, Pickups, this);
+	ForceNetUpdate();
+}
+
+const FPickupEntry* APickupCell::FindEntry(uint32 Id) const
+{
+	return Pickups.Entries.FindByPredicate([Id](const FPickupEntry& Entry) { return Entry.Id == Id; });
+}
+
+UClass* APickupCell::GetEntryClass(const FPickupEntry& Entry) const
+{
+	return Classes.IsValidIndex(Entry.ClassIndex) ? Classes[Entry.ClassIndex].Get() : nullptr;
+}
+
+void APickupCell::OnRep_Classes()
+{
+	// Entries can arrive before the class they refer to
+	if (UPickupSubsystem* PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>())
+	{
+		for (const FPickupEntry& Entry : Pickups.Entries)
+		{
+			PickupSubsystem->OnEntryAdded(this, Entry);
+		}
+	}
+}
+
+void APickupCell::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// A client drops the whole cell when it goes out of relevancy
+	if (UPickupSubsystem* PickupSubsystem = GetWorld()->GetSubsystem<UPickupSubsystem>())
+	{
+		for (const FPickupEntry& Entry : Pickups.Entries)
+		{
+			PickupSubsystem->OnEntryRemoved(Entry, false);
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
@@ -0,0 +1,235 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Items/PickupProximitySubsystem.h"
+
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Interfaces/PickupInterface.h"
+#include "Items/Item.h"
+#include "Slash/Slash.h"
+#include "Slash/SlashDebugDraw.h"
+
+DECLARE_CYCLE_STAT(TEXT("Pickup Proximity"), STAT_PickupProximity, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Proximity Tests"), STAT_PickupProximityTests, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pickup Proximity Items"), STAT_PickupProximityItems, STATGROUP_Slash);
+
+namespace SlashPickups
+{
+	static float ProximityCellSize = 500.f;
+	static FAutoConsoleVariableRef CVarProximityCellSize(TEXT("Slash.Pickups.ProximityCellSize"), ProximityCellSize,
+		TEXT("Grid cell size of the pickup proximity index. Only read when the world starts."));
+
+	static float FocusHysteresis = 50.f;
+	static FAutoConsoleVariableRef CVarFocusHysteresis(TEXT("Slash.Pickups.FocusHysteresis"), FocusHysteresis,
+		TEXT("How much closer another interactable has to be to take the focus from the current one."));
+}
+
+bool UPickupProximitySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UPickupProximitySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPickupProximitySubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UPickupProximitySubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt32(Location.X / SlashPickups::ProximityCellSize), FMath::FloorToInt32(Location.Y / SlashPickups::ProximityCellSize));
+}
+
+void UPickupProximitySubsystem::RegisterItem(AItem* Item)
+{
+	if (CellByItem.Contains(Item))
+	{
+		UpdateItem(Item);
+		return;
+	}
+
+	const FIntPoint Cell = GetCell(Item->GetActorLocation());
+	Cells.FindOrAdd(Cell).Add(Item);
+	CellByItem.Add(Item, Cell);
+	MaxItemRadius = FMath::Max(MaxItemRadius, Item->GetContactRadius());
+	INC_DWORD_STAT(STAT_PickupProximityItems);
+}
+
+void UPickupProximitySubsystem::UnregisterItem(AItem* Item)
+{
+	FIntPoint Cell;
+	if (!CellByItem.RemoveAndCopyValue(Item, Cell))
+		return;
+
+	if (TArray<AItem*>* Items = Cells.Find(Cell))
+	{
+		Items->RemoveSwap(Item, EAllowShrinking::No);
+	}
+	DEC_DWORD_STAT(STAT_PickupProximityItems);
+}
+
+void UPickupProximitySubsystem::UpdateItem(AItem* Item)
+{
+	FIntPoint* Cell = CellByItem.Find(Item);
+	if (Cell == nullptr)
+		return;
+
+	const FIntPoint NewCell = GetCell(Item->GetActorLocation());
+	if (NewCell == *Cell)
+		return;
+
+	if (TArray<AItem*>* Items = Cells.Find(*Cell))
+	{
+		Items->RemoveSwap(Item, EAllowShrinking::No);
+	}
+	Cells.FindOrAdd(NewCell).Add(Item);
+	*Cell = NewCell;
+}
+
+void UPickupProximitySubsystem::Tick(float DeltaTime)
+{
+	UpdatePlayers();
+}
+
+int32 UPickupProximitySubsystem::UpdatePlayers()
+{
+	// Server: every player, client: the local ones
+	TArray<APawn*, TInlineAllocator<16>> Pawns;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr;
+		if (Pawn && Cast<IPickupInterface>(Pawn))
+		{
+			Pawns.Add(Pawn);
+		}
+	}
+	return UpdatePlayers(Pawns);
+}
+
+int32 UPickupProximitySubsystem::UpdatePlayers(TConstArrayView<APawn*> Pawns)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PickupProximity);
+
+	Players.RemoveAllSwap([&Pawns](const FPlayerProximity& State)
+	{
+		return !Pawns.Contains(State.Player.Get());
+	});
+
+	int32 NumTested = 0;
+	for (APawn* Pawn : Pawns)
+	{
+		FPlayerProximity* State = Players.FindByPredicate([Pawn](const FPlayerProximity& Other) { return Other.Player == Pawn; });
+		if (State == nullptr)
+		{
+			State = &Players.AddDefaulted_GetRef();
+			State->Player = Pawn;
+		}
+		NumTested += UpdatePlayer(Pawn, *State);
+	}
+
+	INC_DWORD_STAT_BY(STAT_PickupProximityTests, NumTested);
+	return NumTested;
+}
+
+AItem* UPickupProximitySubsystem::GetFocus(const APawn* Player) const
+{
+	const FPlayerProximity* State = Players.FindByPredicate([Player](const FPlayerProximity& Other) { return Other.Player == Player; });
+	return State ? State->Focus.Get() : nullptr;
+}
+
+int32 UPickupProximitySubsystem::UpdatePlayer(APawn* Player, FPlayerProximity& State)
+{
+	float PlayerRadius = 0.f;
+	float PlayerHalfHeight = 0.f;
+	Player->GetSimpleCollisionCylinder(PlayerRadius, PlayerHalfHeight);
+
+	// Contact is the item's sphere against the player's capsule: distance to the capsule's segment
+	const FVector PlayerLocation = Player->GetActorLocation();
+	const FVector SegmentOffset(0.f, 0.f, FMath::Max(PlayerHalfHeight - PlayerRadius, 0.f));
+	const FVector SegmentStart = PlayerLocation - SegmentOffset;
+	const FVector SegmentEnd = PlayerLocation + SegmentOffset;
+
+	const float     QueryRadius = PlayerRadius + MaxItemRadius + SlashPickups::FocusHysteresis;
+	const FIntPoint MinCell = GetCell(PlayerLocation - FVector(QueryRadius));
+	const FIntPoint MaxCell = GetCell(PlayerLocation + FVector(QueryRadius));
+
+	TArray<TWeakObjectPtr<AItem>, TInlineAllocator<8>> Touching;
+	AItem* Focus = State.Focus.Get();
+	AItem* Nearest = nullptr;
+	float  NearestGap = TNumericLimits<float>::Max();
+	float  FocusGap = TNumericLimits<float>::Max();
+	int32  NumTested = 0;
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			const TArray<AItem*>* Items = Cells.Find(FIntPoint(X, Y));
+			if (Items == nullptr)
+				continue;
+
+			for (AItem* Item : *Items)
+			{
+				++NumTested;
+				if (!Item->IsItemActive() || Item->GetItemState() != EItemState::EIS_Hovering)
+					continue;
+
+				const FVector Closest = FMath::ClosestPointOnSegment(Item->GetActorLocation(), SegmentStart, SegmentEnd);
+				const float   Gap = FVector::Dist(Closest, Item->GetActorLocation()) - PlayerRadius - Item->GetContactRadius();
+
+				// The focused item stays in reach a little further, so standing on the edge does not flicker
+				if (Gap > (Item == Focus ? SlashPickups::FocusHysteresis : 0.f))
+					continue;
+
+				if (Item->IsAutoCollected())
+				{
+					Touching.Add(Item);
+					continue;
+				}
+
+				if (Gap < NearestGap)
+				{
+					NearestGap = Gap;
+					Nearest = Item;
+				}
+				if (Item == Focus)
+				{
+					FocusGap = Gap;
+				}
+			}
+		}
+	}
+
+	// Touch once per contact, like a begin overlap
+	for (const TWeakObjectPtr<AItem>& Item : Touching)
+	{
+		if (!State.Touching.Contains(Item))
+		{
+			SLASH_DEBUG_SPHERE(Player, Pickups, Item->GetActorLocation(), Item->GetContactRadius(), FColor::Cyan);
+			Item->NotifyPlayerTouch(Player);
+		}
+	}
+	State.Touching.Reset();
+	State.Touching.Append(Touching);
+
+	// Keep the current focus while it is in reach, unless another one is clearly closer
+	if (Focus && FocusGap < TNumericLimits<float>::Max() && NearestGap > FocusGap - SlashPickups::FocusHysteresis)
+	{
+		Nearest = Focus;
+	}
+
+	if (Nearest != Focus)
+	{
+		State.Focus = Nearest;
+		if (Nearest)
+		{
+			SLASH_DEBUG_LINE(Player, Pickups, PlayerLocation, Nearest->GetActorLocation(), FColor::Yellow);
+		}
+		if (IPickupInterface* PickupInterface = Cast<IPickupInterface>(Player))
+		{
+			PickupInterface->SetOverlappingItem(Nearest);
+		}
+	}
+	return NumTested;
+}
@@ -0,0 +1,247 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Items/PickupSubsystem.h"
+
+#include "Characters/SlashCharacter.h"
+#include "Engine/World.h"
+#include "Interfaces/PickupInterface.h"
+#include "Items/Item.h"
+#include "Items/PickupCell.h"
+#include "Items/Soul.h"
+#include "Items/Treasure.h"
+#include "Slash/Slash.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickups"), STAT_Pickups, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pickup Visuals"), STAT_PickupVisuals, STATGROUP_Slash);
+
+namespace SlashPickups
+{
+	static float CellSize = 5000.f;
+	static FAutoConsoleVariableRef CVarCellSize(
+		TEXT("Slash.Pickups.CellSize"),
+		CellSize,
+		TEXT("Side of the square covered by one replicated pickup cell."));
+
+	static float CollectRadius = 300.f;
+	static FAutoConsoleVariableRef CVarCollectRadius(
+		TEXT("Slash.Pickups.CollectRadius"),
+		CollectRadius,
+		TEXT("Furthest a player may be from a dropped pickup when the server receives its collection."));
+
+	static FIntPoint GetCellCoord(const FVector& Location)
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+}
+
+bool UPickupSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UPickupSubsystem::Deinitialize()
+{
+	Cells.Reset();
+	CellById.Reset();
+	Visuals.Reset();
+	FreeVisuals.Reset();
+	PooledVisuals.Reset();
+
+	Super::Deinitialize();
+}
+
+bool UPickupSubsystem::ShouldShowVisuals() const
+{
+	return GetWorld()->GetNetMode() != NM_DedicatedServer;
+}
+
+APickupCell* UPickupSubsystem::FindOrAddCell(const FVector& Location)
+{
+	const FIntPoint Coord = SlashPickups::GetCellCoord(Location);
+	if (APickupCell* const* Cell = Cells.Find(Coord))
+		return *Cell;
+
+	const FVector         Center((Coord.X + 0.5f) * SlashPickups::CellSize, (Coord.Y + 0.5f) * SlashPickups::CellSize, Location.Z);
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	APickupCell* Cell = GetWorld()->SpawnActor<APickupCell>(Center, FRotator::ZeroRotator, SpawnParams);
+	if (Cell)
+	{
+		// Relevant as long as any corner of the cell is (the replication graph does the same per class)
+		Cell->NetCullDistanceSquared = FMath::Square(FMath::Sqrt(Cell->NetCullDistanceSquared) + GetCellRadius());
+		Cells.Add(Coord, Cell);
+	}
+	return Cell;
+}
+
+float UPickupSubsystem::GetCellRadius()
+{
+	return SlashPickups::CellSize * UE_HALF_SQRT_2;
+}
+
+void UPickupSubsystem::SpawnPickup(TSubclassOf<AItem> Class, const FVector& Location, int32 Value)
+{
+	UWorld* World = GetWorld();
+	if (Class == nullptr || World->GetNetMode() == NM_Client)
+		return;
+
+	APickupCell* Cell = FindOrAddCell(Location);
+	if (Cell == nullptr)
+		return;
+
+	const uint32 Id = ++LastPickupId;
+	Cell->AddEntry(Id, Class, Location, Value);
+	CellById.Add(Id, SlashPickups::GetCellCoord(Location));
+	INC_DWORD_STAT(STAT_Pickups);
+
+	// Fast array callbacks only run on clients
+	if (const FPickupEntry* Entry = Cell->FindEntry(Id))
+	{
+		OnEntryAdded(Cell, *Entry);
+	}
+}
+
+void UPickupSubsystem::RequestCollect(AItem* Visual, AActor* Collector)
+{
+	const APawn* Pawn = Cast<APawn>(Collector);
+	if (Pawn == nullptr || !Pawn->IsLocallyControlled())
+		return;
+
+	const uint32 Id = Visual->GetPickupId();
+	if (Id == 0)
+		return;
+
+	if (Pawn->HasAuthority())
+	{
+		Collect(Id, Collector);
+	}
+	else if (ASlashCharacter* Character = Cast<ASlashCharacter>(Collector); Character && !PendingCollects.Contains(Id))
+	{
+		// The visual goes away when the removal replicates back
+		PendingCollects.Add(Id);
+		Character->ServerCollectPickup(Id);
+	}
+}
+
+bool UPickupSubsystem::Collect(uint32 Id, AActor* Collector)
+{
+	const FIntPoint* Coord = CellById.Find(Id);
+	APickupCell*     Cell = Coord ? Cells.FindRef(*Coord) : nullptr;
+	const FPickupEntry* Entry = Cell ? Cell->FindEntry(Id) : nullptr;
+	IPickupInterface*   PickupInterface = Cast<IPickupInterface>(Collector);
+	if (Entry == nullptr || PickupInterface == nullptr)
+		return false;
+
+	if (FVector::DistSquared(Collector->GetActorLocation(), Entry->Location) > FMath::Square(SlashPickups::CollectRadius))
+	{
+		UE_LOG(LogSlash, Verbose, TEXT("Pickups - %s too far from pickup %u"), *GetNameSafe(Collector), Id);
+		return false;
+	}
+
+	const UClass* Class = Cell->GetEntryClass(*Entry);
+	if (Class && Class->IsChildOf(ASoul::StaticClass()))
+	{
+		PickupInterface->AddSouls(Entry->Value);
+	}
+	else if (Class && Class->IsChildOf(ATreasure::StaticClass()))
+	{
+		PickupInterface->AddGold(Entry->Value);
+	}
+
+	FPickupEntry Removed;
+	Cell->RemoveEntry(Id, Removed);
+	CellById.Remove(Id);
+	DEC_DWORD_STAT(STAT_Pickups);
+
+	OnEntryRemoved(Removed, true);
+	return true;
+}
+
+void UPickupSubsystem::RemoveAllPickups()
+{
+	for (const TPair<FIntPoint, APickupCell*>& Pair : Cells)
+	{
+		for (const FPickupEntry& Entry : Pair.Value->GetEntries())
+		{
+			OnEntryRemoved(Entry, false);
+		}
+		Pair.Value->RemoveAllEntries();
+	}
+	CellById.Reset();
+	SET_DWORD_STAT(STAT_Pickups, 0);
+}
+
+int32 UPickupSubsystem::GetNumPickups() const
+{
+	int32 NumPickups = 0;
+	for (const TPair<FIntPoint, APickupCell*>& Pair : Cells)
+	{
+		NumPickups += Pair.Value->GetEntries().Num();
+	}
+	return NumPickups;
+}
+
+void UPickupSubsystem::OnEntryAdded(APickupCell* Cell, const FPickupEntry& Entry)
+{
+	if (!ShouldShowVisuals() || Visuals.Contains(Entry.Id))
+		return;
+
+	// Class not replicated yet, APickupCell::OnRep_Classes adds it again
+	UClass* Class = Cell->GetEntryClass(Entry);
+	if (Class == nullptr)
+		return;
+
+	if (AItem* Visual = AcquireVisual(Class, Entry.Location))
+	{
+		Visual->InitPickup(Entry.Id, Entry.Value);
+		Visuals.Add(Entry.Id, Visual);
+		INC_DWORD_STAT(STAT_PickupVisuals);
+	}
+}
+
+void UPickupSubsystem::OnEntryRemoved(const FPickupEntry& Entry, bool bCollected)
+{
+	PendingCollects.Remove(Entry.Id);
+
+	AItem* Visual = nullptr;
+	if (!Visuals.RemoveAndCopyValue(Entry.Id, Visual) || Visual == nullptr)
+		return;
+
+	if (bCollected)
+	{
+		Visual->PlayPickupEffects();
+	}
+	ReleaseVisual(Visual);
+	DEC_DWORD_STAT(STAT_PickupVisuals);
+}
+
+AItem* UPickupSubsystem::AcquireVisual(UClass* Class, const FVector& Location)
+{
+	TArray<AItem*>& Free = FreeVisuals.FindOrAdd(Class);
+	if (Free.Num() > 0)
+	{
+		AItem* Visual = Free.Pop(EAllowShrinking::No);
+		Visual->SetActorLocation(Location);
+		Visual->SetItemActive(true);
+		return Visual;
+	}
+
+	// Local only: the entry is what replicates
+	const FTransform SpawnTransform(Location);
+	AItem*           Visual = GetWorld()->SpawnActorDeferred<AItem>(Class, SpawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (Visual == nullptr)
+		return nullptr;
+
+	Visual->SetReplicates(false);
+	Visual->FinishSpawning(SpawnTransform);
+	PooledVisuals.Add(Visual);
+	return Visual;
+}
+
+void UPickupSubsystem::ReleaseVisual(AItem* Visual)
+{
+	Visual->InitPickup(0, 0);
+	Visual->SetItemActive(false);
+	FreeVisuals.FindOrAdd(Visual->GetClass()).Add(Visual);
+}
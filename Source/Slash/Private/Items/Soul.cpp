@@ -23,6 +23,19 @@ void ASoul::BeginPlay()
 {
 	Super::BeginPlay();
 
+	UpdateDesiredZ();
+}
+
+void ASoul::InitPickup(uint32 Id, int32 Value)
+{
+	Super::InitPickup(Id, Value);
+
+	Souls = Value;
+	UpdateDesiredZ();
+}
+
+void ASoul::UpdateDesiredZ()
+{
 	const FVector Start = GetActorLocation();
 	const FVector End = Start - FVector(0.f, 0.f, 2000.f);
 
@@ -47,13 +60,19 @@ void ASoul::BeginPlay()
 
 void ASoul::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	if (TryCollectAsPickup(OtherActor))
+		return;
+
+	// Pickups are granted by the server, the attributes replicate back
+	if (!HasAuthority())
+		return;
+
 	if (IPickupInterface* PickupInterface = Cast<IPickupInterface>(OtherActor))
 	{
-		PickupInterface->AddSouls(this);
-		SpawnPickupSystem();
-		SpawnPickupSound();
+		PickupInterface->AddSouls(Souls);
+		PlayPickupEffects();
 
-		Destroy();
+		Consume();
 	}
 
 }
\ No newline at end of file
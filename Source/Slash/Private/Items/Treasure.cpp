@@ -8,11 +8,31 @@
 
 void ATreasure::OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
 {
+	if (TryCollectAsPickup(OtherActor))
+		return;
+
+	// Pickups are granted by the server, the attributes replicate back
+	if (!HasAuthority())
+		return;
+
 	if (IPickupInterface* PickupInterface = Cast<IPickupInterface>(OtherActor))
 	{
-		PickupInterface->AddGold(this);
-		SpawnPickupSound();
-		Destroy();
+		PickupInterface->AddGold(Gold);
+		PlayPickupEffects();
+		Consume();
 	}
 
+}
+
+void ATreasure::InitPickup(uint32 Id, int32 Value)
+{
+	Super::InitPickup(Id, Value);
+
+	Gold = Value;
+}
+
+void ATreasure::PlayPickupEffects()
+{
+	// Treasure has no pickup effect, only the sound
+	SpawnPickupSound();
 }
\ No newline at end of file
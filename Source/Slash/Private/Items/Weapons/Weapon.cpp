@@ -6,13 +6,27 @@
 #include "NiagaraComponent.h"
 #include "Breakable/BreakableActor.h"
 #include "Characters/SlashCharacter.h"
+#include "Components/AttributeComponent.h"
 #include "Components/BoxComponent.h"
 #include "Components/SphereComponent.h"
 #include "Interfaces/HitInterface.h"
 #include "Kismet/GameplayStatics.h"
+#include "Slash/Slash.h"
+#include "Slash/SlashDebugDraw.h"
+#include "World/SlashAssetPreloadSubsystem.h"
+#include "World/SlashFeedbackSubsystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Weapon Box Traces"), STAT_WeaponBoxTraces, STATGROUP_Slash);
+
+namespace SlashWeapon
+{
+	static uint32 NumBoxTraces = 0;
+}
 
 AWeapon::AWeapon()
 {
+	// Placed weapons replicate whether they were picked up, like other pickups; the equipped instances are spawned
+	// locally on every machine, see Equip
 	WeaponBox = CreateDefaultSubobject<UBoxComponent>(TEXT("Weapon Box"));
 	WeaponBox->SetupAttachment(RootComponent);
 
@@ -32,6 +46,30 @@ void AWeapon::BeginPlay()
 	Super::BeginPlay();
 
 	WeaponBox->OnComponentBeginOverlap.AddDynamic(this, &AWeapon::OnBoxOverlap);
+
+	if (USlashAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<USlashAssetPreloadSubsystem>())
+	{
+		Preload->AddUser(this);
+	}
+}
+
+void AWeapon::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ItemState == EItemState::EIS_Equipped)
+	{
+		const ABaseCharacter* OwnerCharacter = Cast<ABaseCharacter>(GetOwner());
+		if (UAttributeComponent* OwnerAttributes = OwnerCharacter ? OwnerCharacter->GetAttributes() : nullptr)
+		{
+			OwnerAttributes->RemoveModifiers(this);
+		}
+	}
+
+	if (USlashAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<USlashAssetPreloadSubsystem>())
+	{
+		Preload->RemoveUser(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AWeapon::AttachMeshToSocket(USceneComponent* InParent, FName InSocketName)
@@ -42,9 +80,9 @@ void AWeapon::AttachMeshToSocket(USceneComponent* InParent, FName InSocketName)
 
 void AWeapon::PlayEquipSound()
 {
-	if (EquipSound)
+	if (USlashFeedbackSubsystem* Feedback = GetWorld()->GetSubsystem<USlashFeedbackSubsystem>())
 	{
-		UGameplayStatics::PlaySoundAtLocation(this, EquipSound, GetActorLocation());
+		Feedback->PlaySound(USlashAssetPreloadSubsystem::GetIfResident(EquipSound), GetActorLocation());
 	}
 }
 
@@ -64,55 +102,49 @@ void AWeapon::DeactivateEmbers()
 	}
 }
 
-AWeapon* AWeapon::Equip(USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator)
+AWeapon* AWeapon::Equip(USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator, bool bConsume)
 {
-	// ItemState = EItemState::EIS_Equipped;
-	// SetOwner(NewOwner);
-	// SetInstigator(NewInstigator);
-	// AttachMeshToSocket(InParent, InSocketName);
-	//
-	// SetIsSpatiallyLoaded(false);
-	//
-	// PlayEquipSound();
-	// DisableSphereCollision();
-	// DeactivateEmbers();
-
-	// Spawn a new runtime instance of the same class
-	FActorSpawnParameters Params;
-	Params.Owner = NewOwner;
-	Params.Instigator = NewInstigator;
-	Params.SpawnCollisionHandlingOverride =
-		ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
-	AWeapon* NewWeapon = GetWorld()->SpawnActor<AWeapon>(
-		GetClass(), GetActorTransform(), Params);
-
-	if (NewWeapon)
-	{
-		// Attach and initialize
-		NewWeapon->ItemState = EItemState::EIS_Equipped;
-		NewWeapon->AttachMeshToSocket(InParent, InSocketName);
-
-		// Optionally copy mesh/visual state if needed
-		// NewWeapon->WeaponMesh->SetSkeletalMesh(WeaponMesh->SkeletalMesh);
+	AWeapon* NewWeapon = SpawnEquipped(GetClass(), InParent, InSocketName, NewOwner, NewInstigator);
 
-		NewWeapon->PlayEquipSound();
-		NewWeapon->DisableSphereCollision();
-		NewWeapon->DeactivateEmbers();
+	// Retire the original placed actor (still tied to World Partition)
+	if (bConsume)
+	{
+		Consume();
 	}
 
-	// Destroy the original placed actor (still tied to World Partition)
-	Destroy();
-
 	return NewWeapon;
 }
 
-void AWeapon::ExecuteGetHit(FHitResult& BoxHit)
+AWeapon* AWeapon::SpawnEquipped(UClass* WeaponClass, USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator)
 {
-	if (IHitInterface* HitInterface = Cast<IHitInterface>(BoxHit.GetActor()))
+	if (WeaponClass == nullptr || InParent == nullptr)
+		return nullptr;
+
+	// Spawn a new runtime instance, local only
+	const FTransform SocketTransform = InParent->GetSocketTransform(InSocketName);
+	AWeapon*         NewWeapon = InParent->GetWorld()->SpawnActorDeferred<AWeapon>(
+		WeaponClass, SocketTransform, NewOwner, NewInstigator, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (NewWeapon == nullptr)
+		return nullptr;
+
+	NewWeapon->SetReplicates(false);
+	NewWeapon->FinishSpawning(SocketTransform);
+
+	// Attach and initialize
+	NewWeapon->ItemState = EItemState::EIS_Equipped;
+	NewWeapon->AttachMeshToSocket(InParent, InSocketName);
+
+	NewWeapon->PlayEquipSound();
+	NewWeapon->DisableSphereCollision();
+	NewWeapon->DeactivateEmbers();
+
+	// Every machine equips its own instance, so the modifiers match everywhere
+	const ABaseCharacter* OwnerCharacter = Cast<ABaseCharacter>(NewOwner);
+	if (UAttributeComponent* OwnerAttributes = OwnerCharacter ? OwnerCharacter->GetAttributes() : nullptr)
 	{
-		HitInterface->Execute_GetHit(BoxHit.GetActor(), BoxHit.ImpactPoint, GetOwner());
+		OwnerAttributes->AddModifiers(NewWeapon->AttributeModifiers, NewWeapon);
 	}
+	return NewWeapon;
 }
 
 bool AWeapon::ActorIsSameType(AActor* OtherActor)
@@ -125,6 +157,15 @@ void AWeapon::OnBoxOverlap(UPrimitiveComponent* OverlappedComponent, AActor* Oth
 	if (ActorIsSameType(OtherActor))
 		return;
 
+	// A remote client only claims the hit, the server rewinds the target and applies it
+	ASlashCharacter* OwnerCharacter = Cast<ASlashCharacter>(GetOwner());
+	const bool       bClaimsHits = OwnerCharacter && OwnerCharacter->GetLocalRole() == ROLE_AutonomousProxy;
+
+	// Only the server applies hits; its replay of a remote player's swing is just animation, those hits arrive
+	// as claims and are the only ones recorded in IgnoreActors
+	if (!bClaimsHits && (!GetOwner()->HasAuthority() || (OwnerCharacter && !OwnerCharacter->IsLocallyControlled())))
+		return;
+
 	FHitResult BoxHit;
 	BoxTrace(BoxHit);
 
@@ -133,19 +174,53 @@ void AWeapon::OnBoxOverlap(UPrimitiveComponent* OverlappedComponent, AActor* Oth
 		if (ActorIsSameType(BoxHit.GetActor()))
 			return;
 
-		UGameplayStatics::ApplyDamage(BoxHit.GetActor(), Damage, GetInstigatorController(), this, UDamageType::StaticClass());
+		if (bClaimsHits)
+		{
+			OwnerCharacter->ClaimHit(BoxHit.GetActor(), BoxTraceStart->GetComponentLocation(), BoxTraceEnd->GetComponentLocation(), BoxHit.ImpactPoint);
+			return;
+		}
+
+		ApplyHit(BoxHit.GetActor(), BoxHit.ImpactPoint);
+	}
+}
+
+void AWeapon::ApplyHit(AActor* HitActor, const FVector& ImpactPoint)
+{
+	const ABaseCharacter*      OwnerCharacter = Cast<ABaseCharacter>(GetOwner());
+	const UAttributeComponent* OwnerAttributes = OwnerCharacter ? OwnerCharacter->GetAttributes() : nullptr;
+	const float                HitDamage = Damage * (OwnerAttributes ? OwnerAttributes->GetValue(ESlashAttribute::ESA_DamageScale) : 1.f);
+	UGameplayStatics::ApplyDamage(HitActor, HitDamage, GetInstigatorController(), this, UDamageType::StaticClass());
 
-		ExecuteGetHit(BoxHit);
+	if (IHitInterface* HitInterface = Cast<IHitInterface>(HitActor))
+	{
+		HitInterface->Execute_GetHit(HitActor, ImpactPoint, GetOwner());
+	}
 
-		if (Cast<ABreakableActor>(BoxHit.GetActor()))
+	ABaseCharacter* HitCharacter = Cast<ABaseCharacter>(HitActor);
+	if (HitCharacter && HitEffects.Num() > 0)
+	{
+		if (UStatusEffectSubsystem* StatusEffects = GetWorld()->GetSubsystem<UStatusEffectSubsystem>())
 		{
-			CreateFields(BoxHit.ImpactPoint);
+			StatusEffects->ApplyEffects(HitCharacter, HitEffects);
 		}
 	}
+
+	if (Cast<ABreakableActor>(HitActor))
+	{
+		CreateFields(ImpactPoint);
+	}
+}
+
+uint32 AWeapon::GetNumBoxTraces()
+{
+	return SlashWeapon::NumBoxTraces;
 }
 
 void AWeapon::BoxTrace(FHitResult& BoxHit)
 {
+	++SlashWeapon::NumBoxTraces;
+	INC_DWORD_STAT(STAT_WeaponBoxTraces);
+
 	const FVector Start = BoxTraceStart->GetComponentLocation();
 	const FVector End = BoxTraceEnd->GetComponentLocation();
 
@@ -167,10 +242,16 @@ void AWeapon::BoxTrace(FHitResult& BoxHit)
 		ETraceTypeQuery::TraceTypeQuery1,
 		false,
 		ActorsToIgnore,
-		bShowBoxDebug ? EDrawDebugTrace::ForDuration : EDrawDebugTrace::None,
+		EDrawDebugTrace::None,
 		BoxHit,
 		true
 		);
 
+	SLASH_DEBUG_BOX(this, Combat, End, BoxTraceExtent, BoxTraceStart->GetComponentQuat(), BoxHit.bBlockingHit ? FColor::Red : FColor::Green);
+	if (BoxHit.bBlockingHit)
+	{
+		SLASH_DEBUG_POINT(this, Combat, BoxHit.ImpactPoint, 15.f, FColor::Red);
+	}
+
 	IgnoreActors.AddUnique(BoxHit.GetActor());
 }
\ No newline at end of file
@@ -0,0 +1,137 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Net/SlashEnemyNetSubsystem.h"
+
+#include "Enemy/Enemy.h"
+#include "Enemy/EnemyNetMovement.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Slash/Slash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Net Tiers"), STAT_EnemyNetTiers, STATGROUP_Slash);
+
+CSV_DEFINE_CATEGORY(SlashEnemyNet, true);
+
+namespace SlashEnemyNet
+{
+	static float TierInterval = 0.5f;
+	static FAutoConsoleVariableRef CVarTierInterval(TEXT("Slash.EnemyNet.TierInterval"), TierInterval,
+		TEXT("Seconds between updates of the enemies' distance tiers."));
+
+	static float NearDistance = 3000.f;
+	static FAutoConsoleVariableRef CVarNearDistance(TEXT("Slash.EnemyNet.NearDistance"), NearDistance,
+		TEXT("Enemies closer than this to any player replicate at their full state rate."));
+
+	static float FarDistance = 8000.f;
+	static FAutoConsoleVariableRef CVarFarDistance(TEXT("Slash.EnemyNet.FarDistance"), FarDistance,
+		TEXT("Enemies further than this from every player use the far tier rate."));
+
+	static float ReportInterval = 5.f;
+	static FAutoConsoleVariableRef CVarReportInterval(TEXT("Slash.EnemyNet.ReportInterval"), ReportInterval,
+		TEXT("Seconds between enemy replication log lines, 0 disables them."));
+}
+
+bool USlashEnemyNetSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool USlashEnemyNetSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return World && World->GetNetDriver() && World->GetNetMode() != NM_Client;
+}
+
+TStatId USlashEnemyNetSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USlashEnemyNetSubsystem, STATGROUP_Tickables);
+}
+
+void USlashEnemyNetSubsystem::RegisterEnemy(AEnemy* Enemy)
+{
+	Enemies.AddUnique(Enemy);
+}
+
+void USlashEnemyNetSubsystem::UnregisterEnemy(AEnemy* Enemy)
+{
+	Enemies.RemoveSwap(Enemy);
+}
+
+void USlashEnemyNetSubsystem::NotifyMovementSent(const FEnemyNetMovement& Movement)
+{
+	MovementBytes += Movement.GetNetSize();
+	++NumMovementUpdates;
+}
+
+void USlashEnemyNetSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceTiers += DeltaTime;
+	if (TimeSinceTiers >= SlashEnemyNet::TierInterval)
+	{
+		TimeSinceTiers = 0.f;
+		UpdateTiers();
+	}
+
+	TimeSinceReport += DeltaTime;
+	if (SlashEnemyNet::ReportInterval > 0.f && TimeSinceReport >= SlashEnemyNet::ReportInterval)
+	{
+		Report();
+	}
+}
+
+void USlashEnemyNetSubsystem::UpdateTiers()
+{
+	SCOPE_CYCLE_COUNTER(STAT_EnemyNetTiers);
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<FVector, TInlineAllocator<16>> PlayerLocations;
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APawn* Pawn = It->Get() ? It->Get()->GetPawn() : nullptr)
+		{
+			PlayerLocations.Add(Pawn->GetActorLocation());
+		}
+	}
+
+	FMemory::Memzero(NumPerTier);
+	for (AEnemy* Enemy : Enemies)
+	{
+		const uint8 Tier = SelectTier(Enemy->GetActorLocation(), PlayerLocations);
+		Enemy->SetNetTier(Tier);
+		++NumPerTier[Tier];
+	}
+
+	TierSeconds += FPlatformTime::Seconds() - StartTime;
+	CSV_CUSTOM_STAT(SlashEnemyNet, NearEnemies, NumPerTier[0], ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SlashEnemyNet, MidEnemies, NumPerTier[1], ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SlashEnemyNet, FarEnemies, NumPerTier[2], ECsvCustomStatOp::Set);
+}
+
+uint8 USlashEnemyNetSubsystem::SelectTier(const FVector& Location, TConstArrayView<FVector> PlayerLocations)
+{
+	double ClosestSquared = TNumericLimits<double>::Max();
+	for (const FVector& PlayerLocation : PlayerLocations)
+	{
+		ClosestSquared = FMath::Min(ClosestSquared, FVector::DistSquared(Location, PlayerLocation));
+	}
+
+	return ClosestSquared < FMath::Square(SlashEnemyNet::NearDistance) ? 0 : ClosestSquared < FMath::Square(SlashEnemyNet::FarDistance) ? 1 : 2;
+}
+
+void USlashEnemyNetSubsystem::Report()
+{
+	const int32 NumEnemies = Enemies.Num();
+	const double BytesPerEnemySecond = NumEnemies > 0 ? MovementBytes / TimeSinceReport / NumEnemies : 0.0;
+	CSV_CUSTOM_STAT(SlashEnemyNet, MovementBytesPerEnemySecond, BytesPerEnemySecond, ECsvCustomStatOp::Set);
+
+	UE_LOG(LogSlash, Log, TEXT("Enemy net - %d enemies (near %d, mid %d, far %d), movement %.1f B/s per enemy (sent once to each connection relevant to it), %.1f B per update, tiers %.3f ms"),
+	       NumEnemies, NumPerTier[0], NumPerTier[1], NumPerTier[2], BytesPerEnemySecond,
+	       NumMovementUpdates > 0 ? static_cast<double>(MovementBytes) / NumMovementUpdates : 0.0, TierSeconds * 1000.0);
+
+	MovementBytes = 0;
+	NumMovementUpdates = 0;
+	TierSeconds = 0.0;
+	TimeSinceReport = 0.f;
+}
@@ -0,0 +1,135 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Net/SlashNetStatsSubsystem.h"
+
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Slash/Slash.h"
+
+CSV_DEFINE_CATEGORY(SlashNet, true);
+
+namespace SlashNetStats
+{
+	static float ReportInterval = 5.f;
+	static FAutoConsoleVariableRef CVarReportInterval(
+		TEXT("Slash.Net.ReportInterval"),
+		ReportInterval,
+		TEXT("Seconds between server network load log lines, 0 disables the log (CSV stats are always recorded)."));
+}
+
+bool USlashNetStatsSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USlashNetStatsSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	bRecordLoadReport = FParse::Param(FCommandLine::Get(), TEXT("SlashLoadReport"));
+	FParse::Value(FCommandLine::Get(), TEXT("SlashLoadTestSeconds="), LoadTestSeconds);
+	if (bRecordLoadReport)
+	{
+		LoadReportRows.Add(TEXT("Seconds,Clients,OutKBps,OutKBpsPerClient,InKBps,BusyAvgMs,BusyMaxMs,MemoryMB"));
+	}
+}
+
+void USlashNetStatsSubsystem::Deinitialize()
+{
+	WriteLoadReport();
+
+	Super::Deinitialize();
+}
+
+bool USlashNetStatsSubsystem::IsTickable() const
+{
+	const UWorld* World = GetWorld();
+	return World && World->GetNetDriver() && World->GetNetMode() != NM_Client;
+}
+
+TStatId USlashNetStatsSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USlashNetStatsSubsystem, STATGROUP_Tickables);
+}
+
+void USlashNetStatsSubsystem::Tick(float DeltaTime)
+{
+	// Frame time minus the time spent sleeping to honor the server tick rate
+	const double BusyMs = FMath::Max(0.0, (FApp::GetDeltaTime() - FApp::GetIdleTime()) * 1000.0);
+	TotalBusyMs += BusyMs;
+	MaxBusyMs = FMath::Max(MaxBusyMs, BusyMs);
+	++NumFrames;
+
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	CSV_CUSTOM_STAT(SlashNet, ServerBusyMs, BusyMs, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SlashNet, OutKBps, NetDriver->OutBytesPerSecond / 1024.f, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SlashNet, InKBps, NetDriver->InBytesPerSecond / 1024.f, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(SlashNet, Clients, NetDriver->ClientConnections.Num(), ECsvCustomStatOp::Set);
+
+	TimeSinceReport += DeltaTime;
+	RunSeconds += DeltaTime;
+	if (SlashNetStats::ReportInterval > 0.f && TimeSinceReport >= SlashNetStats::ReportInterval)
+	{
+		Report();
+	}
+
+	if (LoadTestSeconds > 0.0 && RunSeconds >= LoadTestSeconds)
+	{
+		LoadTestSeconds = 0.0;
+		WriteLoadReport();
+		FPlatformMisc::RequestExit(false, TEXT("Slash load test finished"));
+	}
+}
+
+void USlashNetStatsSubsystem::Report()
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	const int32       NumClients = NetDriver->ClientConnections.Num();
+	const float       OutKBps = NetDriver->OutBytesPerSecond / 1024.f;
+	const float       OutKBpsPerClient = NumClients > 0 ? OutKBps / NumClients : 0.f;
+	const float       InKBps = NetDriver->InBytesPerSecond / 1024.f;
+	const double      MemoryMB = FPlatformMemory::GetStats().UsedPhysical / (1024.0 * 1024.0);
+
+	UE_LOG(LogSlash, Log, TEXT("Net - %d clients, out %.1f KB/s (%.2f KB/s per client), in %.1f KB/s, server busy avg %.2f ms max %.2f ms, memory %.1f MB"),
+	       NumClients, OutKBps, OutKBpsPerClient, InKBps, GetAverageBusyMs(), MaxBusyMs, MemoryMB);
+
+	if (bRecordLoadReport)
+	{
+		LoadReportRows.Add(FString::Printf(TEXT("%.1f,%d,%.2f,%.3f,%.2f,%.3f,%.3f,%.1f"),
+		                                   RunSeconds, NumClients, OutKBps, OutKBpsPerClient, InKBps, GetAverageBusyMs(), MaxBusyMs, MemoryMB));
+		PeakBusyMs = FMath::Max(PeakBusyMs, MaxBusyMs);
+		PeakMemoryMB = FMath::Max(PeakMemoryMB, MemoryMB);
+		PeakClients = FMath::Max(PeakClients, NumClients);
+	}
+
+	TotalBusyMs = 0.0;
+	MaxBusyMs = 0.0;
+	NumFrames = 0;
+	TimeSinceReport = 0.f;
+}
+
+void USlashNetStatsSubsystem::WriteLoadReport()
+{
+	// Header only, nothing was recorded
+	if (LoadReportRows.Num() <= 1)
+		return;
+
+	const FString ReportDir = FPaths::ProjectSavedDir() / TEXT("LoadTest");
+	const FString ReportPath = ReportDir / FString::Printf(TEXT("SlashLoadTest_%s.csv"), *FDateTime::Now().ToString());
+	IFileManager::Get().MakeDirectory(*ReportDir, true);
+
+	if (FFileHelper::SaveStringArrayToFile(LoadReportRows, *ReportPath))
+	{
+		UE_LOG(LogSlash, Log, TEXT("Load test - %.0f s, peak %d clients, peak busy %.2f ms, peak memory %.1f MB, report %s"),
+		       RunSeconds, PeakClients, PeakBusyMs, PeakMemoryMB, *ReportPath);
+	}
+	else
+	{
+		UE_LOG(LogSlash, Warning, TEXT("Load test - failed to write %s"), *ReportPath);
+	}
+	LoadReportRows.SetNum(1);
+}
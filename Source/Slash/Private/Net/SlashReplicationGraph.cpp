@@ -0,0 +1,177 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Net/SlashReplicationGraph.h"
+
+#include "Breakable/BreakableActor.h"
+#include "Engine/NetDriver.h"
+#include "Enemy/Enemy.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+#include "Items/Item.h"
+#include "Items/PickupCell.h"
+#include "Items/PickupSubsystem.h"
+#include "ReplicationGraphTypes.h"
+#include "UObject/UObjectIterator.h"
+
+void USlashReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass*       Class = *It;
+		const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject(false));
+		if (ActorCDO == nullptr || !ActorCDO->GetIsReplicated())
+			continue;
+
+		// Blueprint compilation leftovers
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+			continue;
+
+		ClassRepNodePolicies.Set(Class, GetMappingPolicy(Class));
+
+		float Frequency = ActorCDO->NetUpdateFrequency;
+		float CullDistanceSquared = ActorCDO->NetCullDistanceSquared;
+		if (Class->IsChildOf(AEnemy::StaticClass()))
+		{
+			Frequency = EnemyPatrolFrequency;
+			CullDistanceSquared = FMath::Square(EnemyCullDistance);
+		}
+		else if (Class->IsChildOf(ABreakableActor::StaticClass()) || Class->IsChildOf(AItem::StaticClass()))
+		{
+			Frequency = PickupFrequency;
+			CullDistanceSquared = FMath::Square(PickupCullDistance);
+		}
+		else if (Class->IsChildOf(APickupCell::StaticClass()))
+		{
+			Frequency = PickupCellFrequency;
+			CullDistanceSquared = FMath::Square(PickupCullDistance + UPickupSubsystem::GetCellRadius());
+		}
+
+		FClassReplicationInfo ClassInfo;
+		ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(Frequency);
+		ClassInfo.SetCullDistanceSquared(CullDistanceSquared);
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+void USlashReplicationGraph::InitGlobalGraphNodes()
+{
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = SpatialBias;
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void USlashReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* ConnectionManager)
+{
+	Super::InitConnectionGraphNodes(ConnectionManager);
+
+	// The connection's player controller and view target
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* ConnectionNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(ConnectionNode, ConnectionManager);
+}
+
+void USlashReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	const ESlashClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(ActorInfo.Class);
+	switch (Policy ? *Policy : ESlashClassRepNodeMapping::NotRouted)
+	{
+	case ESlashClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+	case ESlashClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+	case ESlashClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	case ESlashClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->AddActor_Dormancy(ActorInfo, GlobalInfo);
+		break;
+	default:
+		break;
+	}
+}
+
+void USlashReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	const ESlashClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(ActorInfo.Class);
+	switch (Policy ? *Policy : ESlashClassRepNodeMapping::NotRouted)
+	{
+	case ESlashClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+	case ESlashClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+	case ESlashClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	case ESlashClassRepNodeMapping::Spatialize_Dormancy:
+		GridNode->RemoveActor_Dormancy(ActorInfo);
+		break;
+	default:
+		break;
+	}
+}
+
+void USlashReplicationGraph::UpdateEnemyFrequency(AEnemy* Enemy)
+{
+	const USlashReplicationGraph* Defaults = GetDefault<USlashReplicationGraph>();
+	const float TierScale = Enemy->GetNetTier() == 0 ? 1.f : Enemy->GetNetTier() == 1 ? Defaults->EnemyMidTierScale : Defaults->EnemyFarTierScale;
+	const float Frequency = FMath::Max(Defaults->GetEnemyFrequency(Enemy->GetEnemyState()) * TierScale, 1.f);
+	Enemy->NetUpdateFrequency = Frequency;
+
+	UNetDriver* NetDriver = Enemy->GetNetDriver();
+	if (NetDriver == nullptr)
+		return;
+
+	// The graph caches the period when the actor is added, so it has to be patched as well
+	if (USlashReplicationGraph* Graph = NetDriver->GetReplicationDriver<USlashReplicationGraph>())
+	{
+		if (FGlobalActorReplicationInfo* GlobalInfo = Graph->GlobalActorReplicationInfoMap.Find(Enemy))
+		{
+			GlobalInfo->Settings.ReplicationPeriodFrame = Graph->GetReplicationPeriodFrameForFrequency(Frequency);
+		}
+	}
+	Enemy->ForceNetUpdate();
+}
+
+ESlashClassRepNodeMapping USlashReplicationGraph::GetMappingPolicy(const UClass* Class) const
+{
+	if (Class->IsChildOf(ABreakableActor::StaticClass()) || Class->IsChildOf(AItem::StaticClass()))
+		return ESlashClassRepNodeMapping::Spatialize_Dormancy;
+
+	if (Class->IsChildOf(APawn::StaticClass()))
+		return ESlashClassRepNodeMapping::Spatialize_Dynamic;
+
+	const AActor* ActorCDO = Class->GetDefaultObject<AActor>();
+	if (ActorCDO->bAlwaysRelevant || Class->IsChildOf(APlayerState::StaticClass()) || Class->IsChildOf(AGameStateBase::StaticClass()))
+		return ESlashClassRepNodeMapping::RelevantAllConnections;
+
+	if (ActorCDO->bOnlyRelevantToOwner)
+		return ESlashClassRepNodeMapping::NotRouted;
+
+	return ActorCDO->IsReplicatingMovement() ? ESlashClassRepNodeMapping::Spatialize_Dynamic : ESlashClassRepNodeMapping::Spatialize_Static;
+}
+
+float USlashReplicationGraph::GetEnemyFrequency(EEnemyState State) const
+{
+	switch (State)
+	{
+	case EEnemyState::EES_Dead:
+		return EnemyDeadFrequency;
+	case EEnemyState::EES_Chasing:
+	case EEnemyState::EES_Holding:
+	case EEnemyState::EES_Attacking:
+	case EEnemyState::EES_Engaged:
+		return EnemyCombatFrequency;
+	default:
+		return EnemyPatrolFrequency;
+	}
+}
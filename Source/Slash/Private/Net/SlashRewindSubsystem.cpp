@@ -0,0 +1,220 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Net/SlashRewindSubsystem.h"
+
+#include "Characters/BaseCharacter.h"
+#include "Components/CapsuleComponent.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Slash/Slash.h"
+
+DECLARE_CYCLE_STAT(TEXT("Rewind Record"), STAT_RewindRecord, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Rewind Validate"), STAT_RewindValidate, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Rewind Characters"), STAT_RewindCharacters, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rewind Hits Accepted"), STAT_RewindHitsAccepted, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Rewind Hits Rejected"), STAT_RewindHitsRejected, STATGROUP_Slash);
+
+CSV_DEFINE_CATEGORY(SlashRewind, true);
+
+namespace SlashRewind
+{
+	static float MaxRewindSeconds = 0.4f;
+	static FAutoConsoleVariableRef CVarMaxRewindSeconds(TEXT("Slash.Rewind.MaxSeconds"), MaxRewindSeconds,
+		TEXT("Oldest client timestamp a hit claim may rewind to, relative to the server time."));
+
+	static float Tolerance = 15.f;
+	static FAutoConsoleVariableRef CVarTolerance(TEXT("Slash.Rewind.Tolerance"), Tolerance,
+		TEXT("Extra distance (cm) accepted between a claimed trace and the rewound capsule, for quantization and interpolation error."));
+
+	static float MaxReach = 300.f;
+	static FAutoConsoleVariableRef CVarMaxReach(TEXT("Slash.Rewind.MaxReach"), MaxReach,
+		TEXT("Maximum distance (cm) between the attacker's rewound location and the start of its claimed trace."));
+
+	static int32 MaxClaimsPerSecond = 20;
+	static FAutoConsoleVariableRef CVarMaxClaimsPerSecond(TEXT("Slash.Rewind.MaxClaimsPerSecond"), MaxClaimsPerSecond,
+		TEXT("Hit claims validated per attacker per second; the rest are rejected without any work."));
+}
+
+bool USlashRewindSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USlashRewindSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USlashRewindSubsystem, STATGROUP_Tickables);
+}
+
+void USlashRewindSubsystem::Tick(float DeltaTime)
+{
+	// Clients never validate anything
+	if (GetWorld()->GetNetMode() == NM_Client)
+		return;
+
+	RecordFrame();
+
+	TimeSinceClaimReset += DeltaTime;
+	if (TimeSinceClaimReset >= 1.f)
+	{
+		ClaimsThisSecond.Reset();
+		TimeSinceClaimReset = 0.f;
+	}
+}
+
+void USlashRewindSubsystem::RegisterCharacter(ABaseCharacter* Character)
+{
+	if (Character == nullptr || SlotByCharacter.Contains(Character))
+		return;
+
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		Slot = Characters.AddDefaulted();
+		Radii.AddZeroed();
+		HalfHeights.AddZeroed();
+		Centers.AddZeroed(NumFrames);
+	}
+
+	Characters[Slot] = Character;
+	Character->GetCapsuleComponent()->GetScaledCapsuleSize(Radii[Slot], HalfHeights[Slot]);
+
+	// No history yet: fill the row with the current location so early claims rewind to something sane
+	const FVector Center = Character->GetActorLocation();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		Centers[GetIndex(Slot, Frame)] = Center;
+	}
+
+	SlotByCharacter.Add(Character, Slot);
+	SET_DWORD_STAT(STAT_RewindCharacters, SlotByCharacter.Num());
+}
+
+void USlashRewindSubsystem::UnregisterCharacter(ABaseCharacter* Character)
+{
+	int32 Slot;
+	if (SlotByCharacter.RemoveAndCopyValue(Character, Slot))
+	{
+		Characters[Slot] = nullptr;
+		FreeSlots.Add(Slot);
+	}
+	SET_DWORD_STAT(STAT_RewindCharacters, SlotByCharacter.Num());
+}
+
+void USlashRewindSubsystem::RecordFrame()
+{
+	SCOPE_CYCLE_COUNTER(STAT_RewindRecord);
+
+	NewestFrame = (NewestFrame + 1) % NumFrames;
+	NumRecordedFrames = FMath::Min(NumRecordedFrames + 1, NumFrames);
+	FrameTimes[NewestFrame] = GetWorld()->GetTimeSeconds();
+
+	for (int32 Slot = 0; Slot < Characters.Num(); ++Slot)
+	{
+		if (const ABaseCharacter* Character = Characters[Slot].Get())
+		{
+			Centers[GetIndex(Slot, NewestFrame)] = Character->GetActorLocation();
+		}
+	}
+}
+
+bool USlashRewindSubsystem::GetHistoricalLocation(const AActor* Target, double Time, FVector& OutCenter) const
+{
+	const int32* Slot = SlotByCharacter.Find(Target);
+	if (Slot == nullptr || NumRecordedFrames == 0)
+		return false;
+
+	// Walk back from the newest frame to the first one at or before Time
+	int32 Newer = NewestFrame;
+	for (int32 Step = 0; Step < NumRecordedFrames; ++Step)
+	{
+		const int32 Frame = (NewestFrame - Step + NumFrames) % NumFrames;
+		if (FrameTimes[Frame] <= Time)
+		{
+			const FVector& Older = Centers[GetIndex(*Slot, Frame)];
+			if (Frame == Newer)
+			{
+				OutCenter = Older;
+				return true;
+			}
+
+			const double Span = FrameTimes[Newer] - FrameTimes[Frame];
+			const double Alpha = Span > UE_SMALL_NUMBER ? (Time - FrameTimes[Frame]) / Span : 0.0;
+			OutCenter = FMath::Lerp(Older, Centers[GetIndex(*Slot, Newer)], FMath::Clamp(Alpha, 0.0, 1.0));
+			return true;
+		}
+		Newer = Frame;
+	}
+
+	// Older than the history, use the oldest frame
+	OutCenter = Centers[GetIndex(*Slot, Newer)];
+	return true;
+}
+
+bool USlashRewindSubsystem::ValidateHit(const AActor* Attacker, const AActor* Target, const FVector& TraceStart, const FVector& TraceEnd, float TraceRadius, double ClientTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_RewindValidate);
+
+	if (Attacker == nullptr || Target == nullptr || ++ClaimsThisSecond.FindOrAdd(Attacker) > SlashRewind::MaxClaimsPerSecond)
+	{
+		INC_DWORD_STAT(STAT_RewindHitsRejected);
+		return false;
+	}
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const double RewindTime = FMath::Clamp(ClientTime, Now - SlashRewind::MaxRewindSeconds, Now);
+
+	FVector AttackerCenter;
+	if (!GetHistoricalLocation(Attacker, RewindTime, AttackerCenter))
+	{
+		AttackerCenter = Attacker->GetActorLocation();
+	}
+
+	float   TargetRadius = 0.f;
+	float   TargetHalfHeight = 0.f;
+	FVector TargetCenter;
+	if (const int32* Slot = SlotByCharacter.Find(Target))
+	{
+		GetHistoricalLocation(Target, RewindTime, TargetCenter);
+		TargetRadius = Radii[*Slot];
+		TargetHalfHeight = HalfHeights[*Slot];
+	}
+	else
+	{
+		// Breakables and other static targets don't need a history
+		TargetCenter = Target->GetActorLocation();
+		Target->GetSimpleCollisionCylinder(TargetRadius, TargetHalfHeight);
+	}
+
+	const bool bInReach = FVector::DistSquared(AttackerCenter, TraceStart) <= FMath::Square(SlashRewind::MaxReach);
+	const bool bValid = bInReach && SegmentHitsCapsule(TraceStart, TraceEnd, TraceRadius + SlashRewind::Tolerance, TargetCenter, TargetRadius, TargetHalfHeight);
+
+	if (bValid)
+	{
+		INC_DWORD_STAT(STAT_RewindHitsAccepted);
+		CSV_CUSTOM_STAT(SlashRewind, HitsAccepted, 1, ECsvCustomStatOp::Accumulate);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_RewindHitsRejected);
+		CSV_CUSTOM_STAT(SlashRewind, HitsRejected, 1, ECsvCustomStatOp::Accumulate);
+		UE_LOG(LogSlash, Verbose, TEXT("Rejected hit of %s on %s (rewound %.0f ms, in reach %d)"),
+		       *GetNameSafe(Attacker), *GetNameSafe(Target), (Now - RewindTime) * 1000.0, bInReach);
+	}
+	return bValid;
+}
+
+bool USlashRewindSubsystem::SegmentHitsCapsule(const FVector& Start, const FVector& End, float SegmentRadius, const FVector& CapsuleCenter, float CapsuleRadius, float CapsuleHalfHeight)
+{
+	// Upright capsule: a segment on Z between the centers of its two spheres
+	const FVector AxisOffset(0.f, 0.f, FMath::Max(0.f, CapsuleHalfHeight - CapsuleRadius));
+
+	FVector OnTrace;
+	FVector OnAxis;
+	FMath::SegmentDistToSegmentSafe(Start, End, CapsuleCenter - AxisOffset, CapsuleCenter + AxisOffset, OnTrace, OnAxis);
+
+	return FVector::DistSquared(OnTrace, OnAxis) <= FMath::Square(CapsuleRadius + SegmentRadius);
+}
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/SlashAttributeSet.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashAttributeSetTest, "Slash.Attributes.ModifierSet",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashAttributeSetTest::RunTest(const FString& Parameters)
+{
+	const UObject* Sword = NewObject<UObject>(GetTransientPackage());
+	const UObject* Buff = NewObject<UObject>(GetTransientPackage());
+	const uint32   MaxHealthBit = FSlashAttributeSet::Bit(ESlashAttribute::ESA_MaxHealth);
+	const uint32   DamageScaleBit = FSlashAttributeSet::Bit(ESlashAttribute::ESA_DamageScale);
+
+	FSlashAttributeSet Set;
+	TestEqual(TEXT("Starts at zero"), Set.Get(ESlashAttribute::ESA_MaxHealth), 0.f);
+	TestFalse(TEXT("Starts without changes"), Set.HasChanges());
+
+	Set.SetBase(ESlashAttribute::ESA_MaxHealth, 100.f);
+	TestEqual(TEXT("Without modifiers the final value is the base"), Set.Get(ESlashAttribute::ESA_MaxHealth), 100.f);
+	TestEqual(TEXT("Setting a base marks only its attribute changed"), Set.ConsumeChanges(), MaxHealthBit);
+	TestFalse(TEXT("Consuming clears the changes"), Set.HasChanges());
+
+	Set.SetBase(ESlashAttribute::ESA_MaxHealth, 100.f);
+	TestFalse(TEXT("Setting the same base is not a change"), Set.HasChanges());
+
+	FSlashAttributeModifierSpec AddHealth;
+	AddHealth.Attribute = ESlashAttribute::ESA_MaxHealth;
+	AddHealth.Op = EAttributeModifierOp::EAMO_Add;
+	AddHealth.Magnitude = 20.f;
+	FSlashAttributeModifierSpec ScaleDamage;
+	ScaleDamage.Attribute = ESlashAttribute::ESA_DamageScale;
+	ScaleDamage.Op = EAttributeModifierOp::EAMO_Multiply;
+	ScaleDamage.Magnitude = 1.5f;
+	const FSlashAttributeModifierSpec SwordSpecs[] = {AddHealth, ScaleDamage};
+
+	Set.SetBase(ESlashAttribute::ESA_DamageScale, 1.f);
+	Set.ConsumeChanges();
+	Set.AddModifiers(SwordSpecs, Sword);
+	TestEqual(TEXT("Every modifier is kept"), Set.GetNumModifiers(), 2);
+	TestEqual(TEXT("Adding modifiers marks their attributes changed"), Set.ConsumeChanges(), MaxHealthBit | DamageScaleBit);
+	TestEqual(TEXT("Add modifiers add to the base"), Set.Get(ESlashAttribute::ESA_MaxHealth), 120.f);
+	TestEqual(TEXT("Multiply modifiers scale"), Set.Get(ESlashAttribute::ESA_DamageScale), 1.5f);
+
+	Set.AddModifier(ESlashAttribute::ESA_MaxHealth, EAttributeModifierOp::EAMO_Multiply, 2.f, Buff);
+	Set.AddModifier(ESlashAttribute::ESA_MaxHealth, EAttributeModifierOp::EAMO_Add, 10.f, Buff);
+	TestEqual(TEXT("Adds are summed before multiplying"), Set.Get(ESlashAttribute::ESA_MaxHealth), (100.f + 20.f + 10.f) * 2.f);
+
+	Set.SetBase(ESlashAttribute::ESA_MaxHealth, 50.f);
+	TestEqual(TEXT("A new base is picked up on the next read"), Set.Get(ESlashAttribute::ESA_MaxHealth), (50.f + 20.f + 10.f) * 2.f);
+	TestEqual(TEXT("The base is unchanged by modifiers"), Set.GetBase(ESlashAttribute::ESA_MaxHealth), 50.f);
+
+	Set.ConsumeChanges();
+	TestEqual(TEXT("Removing a source returns its modifiers"), Set.RemoveModifiers(Sword), 2);
+	TestEqual(TEXT("Only that source's modifiers are removed"), Set.GetNumModifiers(), 2);
+	TestEqual(TEXT("Removing marks the source's attributes changed"), Set.ConsumeChanges(), MaxHealthBit | DamageScaleBit);
+	TestEqual(TEXT("The other source still applies"), Set.Get(ESlashAttribute::ESA_MaxHealth), (50.f + 10.f) * 2.f);
+	TestEqual(TEXT("Without modifiers the multiplier is gone"), Set.Get(ESlashAttribute::ESA_DamageScale), 1.f);
+
+	TestEqual(TEXT("Removing an absent source removes nothing"), Set.RemoveModifiers(Sword), 0);
+	TestFalse(TEXT("Removing nothing is not a change"), Set.HasChanges());
+
+	Set.RemoveModifiers(Buff);
+	TestEqual(TEXT("Back to the base"), Set.Get(ESlashAttribute::ESA_MaxHealth), 50.f);
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Enemy/EnemyNetMovement.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Net/SlashEnemyNetSubsystem.h"
+#include "Serialization/BitReader.h"
+#include "Serialization/BitWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashEnemyNetTierTest, "Slash.EnemyNet.SelectTier",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashEnemyNetTierTest::RunTest(const FString& Parameters)
+{
+	const float Near = IConsoleManager::Get().FindConsoleVariable(TEXT("Slash.EnemyNet.NearDistance"))->GetFloat();
+	const float Far = IConsoleManager::Get().FindConsoleVariable(TEXT("Slash.EnemyNet.FarDistance"))->GetFloat();
+
+	const FVector Enemy(1000.f, -2000.f, 50.f);
+	const auto    TierWithPlayerAt = [&Enemy](float Distance)
+	{
+		const FVector Player = Enemy + FVector(Distance, 0.f, 0.f);
+		return USlashEnemyNetSubsystem::SelectTier(Enemy, MakeArrayView(&Player, 1));
+	};
+
+	TestEqual(TEXT("No players is far"), USlashEnemyNetSubsystem::SelectTier(Enemy, {}), static_cast<uint8>(2));
+	TestEqual(TEXT("Inside the near distance is near"), TierWithPlayerAt(Near - 1.f), static_cast<uint8>(0));
+	TestEqual(TEXT("At the near distance is mid"), TierWithPlayerAt(Near), static_cast<uint8>(1));
+	TestEqual(TEXT("Inside the far distance is mid"), TierWithPlayerAt(Far - 1.f), static_cast<uint8>(1));
+	TestEqual(TEXT("At the far distance is far"), TierWithPlayerAt(Far), static_cast<uint8>(2));
+
+	const FVector Above = Enemy + FVector(0.f, 0.f, Near + 1.f);
+	TestEqual(TEXT("Height counts"), USlashEnemyNetSubsystem::SelectTier(Enemy, MakeArrayView(&Above, 1)), static_cast<uint8>(1));
+
+	const FVector Players[] = {Enemy + FVector(Far * 2.f, 0.f, 0.f), Enemy + FVector(0.f, Near * 0.5f, 0.f), Enemy + FVector(0.f, -Far, 0.f)};
+	TestEqual(TEXT("The closest player decides"), USlashEnemyNetSubsystem::SelectTier(Enemy, Players), static_cast<uint8>(0));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashEnemyNetMovementTest, "Slash.EnemyNet.Movement",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashEnemyNetMovementTest::RunTest(const FString& Parameters)
+{
+	const FEnemyNetMovement Samples[] = {
+		FEnemyNetMovement::Make(FVector::ZeroVector, 0.f, FVector::ZeroVector),
+		FEnemyNetMovement::Make(FVector(1234.567, -8901.234, 95.3), 90.f, FVector(350.f, -120.f, 0.f)),
+		FEnemyNetMovement::Make(FVector(-409600.4, 204800.9, -1500.25), -135.f, FVector(-600.f, 600.f, -980.f)),
+		FEnemyNetMovement::Make(FVector(FEnemyNetMovement::CellSize - 0.01, FEnemyNetMovement::CellSize, 0.f), 359.f, FVector(40000.f, 0.f, 0.f)),
+	};
+
+	for (const FEnemyNetMovement& Sample : Samples)
+	{
+		FEnemyNetMovement Sent = Sample;
+		FBitWriter        Writer(0, true);
+		bool              bSuccess = false;
+		Sent.NetSerialize(Writer, nullptr, bSuccess);
+
+		TestEqual(TEXT("GetNetSize matches the serialized size"), Sample.GetNetSize(), static_cast<int32>(Writer.GetNumBytes()));
+
+		FBitReader        Reader(Writer.GetData(), Writer.GetNumBits());
+		FEnemyNetMovement Received;
+		Received.NetSerialize(Reader, nullptr, bSuccess);
+		TestTrue(TEXT("Serialization succeeds"), bSuccess && !Reader.IsError());
+		TestTrue(TEXT("A quantized value survives the round trip"), Received == Sample);
+
+		// Unchanged enemies must not be marked dirty, so quantizing again changes nothing
+		TestTrue(TEXT("Make is stable on its own output"),
+			FEnemyNetMovement::Make(Sample.Location, Sample.Yaw, FVector(Sample.Velocity, 0.f)) == Sample);
+	}
+
+	const FEnemyNetMovement Movement = FEnemyNetMovement::Make(FVector(1234.567, -8901.234, 95.3), 90.f, FVector::ZeroVector);
+	TestEqual(TEXT("Planar location within 1/16 cm"), Movement.Location.X, 1234.567, 1.0 / 16.0);
+	TestEqual(TEXT("Z within 0.5 cm"), Movement.Location.Z, 95.3, 0.5);
+
+	return true;
+}
+
+#endif
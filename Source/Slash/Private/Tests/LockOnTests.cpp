@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/LockOnComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Enemy/Enemy.h"
+#include "Enemy/EnemySpatialIndexSubsystem.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SlashLockOnTests
+{
+	static FVector AtAngle(float Degrees, float Distance)
+	{
+		return FRotator(0.f, Degrees, 0.f).Vector() * Distance;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashLockOnScoreTest, "Slash.LockOn.ScoreCandidate",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashLockOnScoreTest::RunTest(const FString& Parameters)
+{
+	using namespace SlashLockOnTests;
+
+	// Defaults: 1500 range, 60 degree half cone
+	const ULockOnComponent* LockOn = GetDefault<ULockOnComponent>();
+	const FVector           Origin = FVector::ZeroVector;
+	const FVector           Forward = FVector::ForwardVector;
+
+	TestTrue(TEXT("Ahead in range scores"), LockOn->ScoreCandidate(Origin, Forward, AtAngle(0.f, 500.f)) > 0.f);
+	TestEqual(TEXT("Behind scores 0"), LockOn->ScoreCandidate(Origin, Forward, AtAngle(180.f, 500.f)), 0.f);
+	TestTrue(TEXT("Just inside the cone scores"), LockOn->ScoreCandidate(Origin, Forward, AtAngle(59.f, 500.f)) > 0.f);
+	TestEqual(TEXT("Just outside the cone scores 0"), LockOn->ScoreCandidate(Origin, Forward, AtAngle(61.f, 500.f)), 0.f);
+	TestTrue(TEXT("Just inside the range scores"), LockOn->ScoreCandidate(Origin, Forward, AtAngle(0.f, 1499.f)) > 0.f);
+	TestEqual(TEXT("Just outside the range scores 0"), LockOn->ScoreCandidate(Origin, Forward, AtAngle(0.f, 1501.f)), 0.f);
+	TestTrue(TEXT("Edge of cone and range still scores"), LockOn->ScoreCandidate(Origin, Forward, AtAngle(59.f, 1499.f)) > 0.f);
+
+	TestTrue(TEXT("Same distance, the smaller angle scores higher"),
+		LockOn->ScoreCandidate(Origin, Forward, AtAngle(10.f, 800.f)) > LockOn->ScoreCandidate(Origin, Forward, AtAngle(40.f, 800.f)));
+	TestTrue(TEXT("Same angle, the nearer target scores higher"),
+		LockOn->ScoreCandidate(Origin, Forward, AtAngle(20.f, 300.f)) > LockOn->ScoreCandidate(Origin, Forward, AtAngle(20.f, 1200.f)));
+	TestEqual(TEXT("Height is ignored"),
+		LockOn->ScoreCandidate(Origin, Forward, AtAngle(20.f, 700.f) + FVector(0.f, 0.f, 1000.f)),
+		LockOn->ScoreCandidate(Origin, Forward, AtAngle(20.f, 700.f)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashEnemySpatialIndexTest, "Slash.Enemy.SpatialIndex",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashEnemySpatialIndexTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	UEnemySpatialIndexSubsystem* Index = World->GetSubsystem<UEnemySpatialIndexSubsystem>();
+	if (TestNotNull(TEXT("Game worlds have the enemy index"), Index))
+	{
+		const float CellSize = IConsoleManager::Get().FindConsoleVariable(TEXT("Slash.Enemy.IndexCellSize"))->GetFloat();
+
+		// The world has not begun play, so enemies are registered by hand
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		const auto Spawn = [World, Index, &Params](const FVector& Location)
+		{
+			AEnemy* Enemy = World->SpawnActor<AEnemy>(AEnemy::StaticClass(), Location, FRotator::ZeroRotator, Params);
+			Index->RegisterEnemy(Enemy);
+			return Enemy;
+		};
+
+		AEnemy* Near = Spawn(FVector(300.f, 0.f, 0.f));
+		AEnemy* High = Spawn(FVector(0.f, 300.f, 5000.f));
+		AEnemy* Far = Spawn(FVector(900.f, 0.f, 0.f));
+		AEnemy* BelowEdge = Spawn(FVector(CellSize - 1.f, 2.f * CellSize, 0.f));
+		AEnemy* AboveEdge = Spawn(FVector(CellSize + 1.f, 2.f * CellSize, 0.f));
+		AEnemy* Dead = Spawn(FVector(-300.f, 0.f, 0.f));
+		Dead->Tags.Add(FName("Dead"));
+		TestEqual(TEXT("Every enemy is indexed"), Index->GetNumEnemies(), 6);
+
+		TArray<AEnemy*> Found;
+		Index->GatherInRadius(FVector::ZeroVector, 500.f, Found);
+		TestTrue(TEXT("Enemy inside the radius is found"), Found.Contains(Near));
+		TestTrue(TEXT("Radius is horizontal"), Found.Contains(High));
+		TestFalse(TEXT("Enemy outside the radius is not found"), Found.Contains(Far));
+		TestFalse(TEXT("Dead enemies are excluded"), Found.Contains(Dead));
+
+		Found.Reset();
+		Index->GatherInRadius(FVector(CellSize, 2.f * CellSize, 0.f), 5.f, Found);
+		TestTrue(TEXT("Enemy on the near side of a cell edge is found"), Found.Contains(BelowEdge));
+		TestTrue(TEXT("Enemy on the far side of a cell edge is found"), Found.Contains(AboveEdge));
+
+		// Moved one cell over and not refreshed yet, the query still reaches its old cell
+		Near->SetActorLocation(FVector(CellSize + 300.f, 0.f, 0.f));
+		Found.Reset();
+		Index->GatherInRadius(FVector(CellSize + 300.f, 0.f, 0.f), 100.f, Found);
+		TestTrue(TEXT("Enemy that left its cell is found before a refresh"), Found.Contains(Near));
+		TestEqual(TEXT("Refresh moves it to its new cell"), Index->Refresh(), 1);
+
+		Index->UnregisterEnemy(Near);
+		Found.Reset();
+		Index->GatherInRadius(FVector(CellSize + 300.f, 0.f, 0.f), 100.f, Found);
+		TestFalse(TEXT("Unregistered enemies are not found"), Found.Contains(Near));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Characters/SlashCharacter.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Items/Item.h"
+#include "Items/PickupProximitySubsystem.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashPickupProximityTest, "Slash.Pickups.ProximityFocus",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashPickupProximityTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	UPickupProximitySubsystem* Proximity = World->GetSubsystem<UPickupProximitySubsystem>();
+	if (TestNotNull(TEXT("Game worlds have the proximity index"), Proximity))
+	{
+		const float CellSize = IConsoleManager::Get().FindConsoleVariable(TEXT("Slash.Pickups.ProximityCellSize"))->GetFloat();
+		const float Hysteresis = IConsoleManager::Get().FindConsoleVariable(TEXT("Slash.Pickups.FocusHysteresis"))->GetFloat();
+
+		// The world has not begun play, so items are registered and players updated by hand
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		APawn* Player = World->SpawnActor<ASlashCharacter>(ASlashCharacter::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, Params);
+		const auto Spawn = [World, Proximity, &Params](const FVector& Location)
+		{
+			AItem* Item = World->SpawnActor<AItem>(AItem::StaticClass(), Location, FRotator::ZeroRotator, Params);
+			Proximity->RegisterItem(Item);
+			return Item;
+		};
+		const auto Update = [Proximity, Player]()
+		{
+			return Proximity->UpdatePlayers(MakeArrayView(&Player, 1));
+		};
+		const auto MoveTo = [Proximity](AItem* Item, const FVector& Location)
+		{
+			Item->SetActorLocation(Location);
+			Proximity->UpdateItem(Item);
+		};
+
+		float PlayerRadius = 0.f;
+		float PlayerHalfHeight = 0.f;
+		Player->GetSimpleCollisionCylinder(PlayerRadius, PlayerHalfHeight);
+		const float Reach = PlayerRadius + GetDefault<AItem>()->GetContactRadius();
+
+		// Contact is against the capsule, not a sphere around the player's center
+		AItem* Above = Spawn(FVector(0.f, 0.f, PlayerHalfHeight - PlayerRadius + Reach - 1.f));
+		Update();
+		TestTrue(TEXT("An item touching the top of the capsule is in reach"), Proximity->GetFocus(Player) == Above);
+
+		Proximity->UnregisterItem(Above);
+		Update();
+		TestNull(TEXT("Unregistered items lose the focus"), Proximity->GetFocus(Player));
+
+		AItem* First = Spawn(FVector(Reach - 1.f, 0.f, 0.f));
+		AItem* Second = Spawn(FVector(-3.f * CellSize, 0.f, 0.f));
+		TestEqual(TEXT("Items in cells out of reach are not tested"), Update(), 1);
+		TestTrue(TEXT("The item in reach gets the focus"), Proximity->GetFocus(Player) == First);
+
+		MoveTo(Second, FVector(-(Reach - 1.f - Hysteresis * 0.5f), 0.f, 0.f));
+		Update();
+		TestTrue(TEXT("A slightly closer item does not take the focus"), Proximity->GetFocus(Player) == First);
+
+		MoveTo(Second, FVector(-1.f, 0.f, 0.f));
+		Update();
+		TestTrue(TEXT("A clearly closer item takes the focus"), Proximity->GetFocus(Player) == Second);
+
+		Second->SetItemActive(false);
+		Update();
+		TestTrue(TEXT("Hidden items are skipped"), Proximity->GetFocus(Player) == First);
+
+		MoveTo(First, FVector(Reach + Hysteresis * 0.5f, 0.f, 0.f));
+		Update();
+		TestTrue(TEXT("The focused item stays in reach a little further"), Proximity->GetFocus(Player) == First);
+
+		MoveTo(First, FVector(Reach + Hysteresis + 1.f, 0.f, 0.f));
+		Update();
+		TestNull(TEXT("Past the hysteresis the focus is dropped"), Proximity->GetFocus(Player));
+
+		Proximity->UnregisterItem(First);
+		Proximity->UnregisterItem(Second);
+		TestEqual(TEXT("Unregistered items leave the index"), Proximity->GetNumItems(), 0);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
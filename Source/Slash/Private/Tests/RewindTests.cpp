@@ -0,0 +1,161 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Enemy/Enemy.h"
+#include "Misc/AutomationTest.h"
+#include "Net/SlashRewindSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SlashRewindTests
+{
+	static constexpr double FrameSeconds = 0.1;
+	static constexpr float  Speed = 1000.f;
+	static constexpr int32  NumFrames = 10;
+
+	/** Records NumFrames frames of Enemy walking along X at Speed, frame i at time i * FrameSeconds */
+	static void RecordWalk(UWorld* World, USlashRewindSubsystem* Rewind, AEnemy* Enemy)
+	{
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			World->TimeSeconds = Frame * FrameSeconds;
+			Enemy->SetActorLocation(FVector(Frame * FrameSeconds * Speed, 0.f, 0.f));
+			Rewind->Tick(FrameSeconds);
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashRewindSegmentTest, "Slash.Rewind.SegmentHitsCapsule",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashRewindSegmentTest::RunTest(const FString& Parameters)
+{
+	const FVector Center(0.f, 0.f, 100.f);
+
+	TestTrue(TEXT("Trace through the center hits"),
+		USlashRewindSubsystem::SegmentHitsCapsule(FVector(-100.f, 0.f, 100.f), FVector(100.f, 0.f, 100.f), 0.f, Center, 30.f, 90.f));
+	TestTrue(TEXT("Trace grazing the side hits"),
+		USlashRewindSubsystem::SegmentHitsCapsule(FVector(-100.f, 29.f, 100.f), FVector(100.f, 29.f, 100.f), 0.f, Center, 30.f, 90.f));
+	TestFalse(TEXT("Trace beside the capsule misses"),
+		USlashRewindSubsystem::SegmentHitsCapsule(FVector(-100.f, 31.f, 100.f), FVector(100.f, 31.f, 100.f), 0.f, Center, 30.f, 90.f));
+	TestTrue(TEXT("The trace radius counts"),
+		USlashRewindSubsystem::SegmentHitsCapsule(FVector(-100.f, 31.f, 100.f), FVector(100.f, 31.f, 100.f), 5.f, Center, 30.f, 90.f));
+	TestTrue(TEXT("Trace near the top hits the upper sphere"),
+		USlashRewindSubsystem::SegmentHitsCapsule(FVector(-100.f, 0.f, 185.f), FVector(100.f, 0.f, 185.f), 0.f, Center, 30.f, 90.f));
+	TestFalse(TEXT("Trace above the capsule misses"),
+		USlashRewindSubsystem::SegmentHitsCapsule(FVector(-100.f, 0.f, 195.f), FVector(100.f, 0.f, 195.f), 0.f, Center, 30.f, 90.f));
+	TestFalse(TEXT("Trace that stops short misses"),
+		USlashRewindSubsystem::SegmentHitsCapsule(FVector(-100.f, 0.f, 100.f), FVector(-40.f, 0.f, 100.f), 0.f, Center, 30.f, 90.f));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashRewindHistoryTest, "Slash.Rewind.HistoricalLocation",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashRewindHistoryTest::RunTest(const FString& Parameters)
+{
+	using namespace SlashRewindTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	USlashRewindSubsystem* Rewind = World->GetSubsystem<USlashRewindSubsystem>();
+	if (TestNotNull(TEXT("Game worlds have the rewind subsystem"), Rewind))
+	{
+		// The world has not begun play, so characters are registered and frames recorded by hand
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AEnemy* Enemy = World->SpawnActor<AEnemy>(AEnemy::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, Params);
+		AEnemy* Other = World->SpawnActor<AEnemy>(AEnemy::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, Params);
+		Rewind->RegisterCharacter(Enemy);
+		TestEqual(TEXT("Registered"), Rewind->GetNumRegistered(), 1);
+
+		RecordWalk(World, Rewind, Enemy);
+
+		FVector Center;
+		TestTrue(TEXT("Registered characters have a history"), Rewind->GetHistoricalLocation(Enemy, 0.3, Center));
+		TestEqual(TEXT("A recorded frame is returned as is"), Center.X, 0.3 * Speed, 0.01);
+
+		Rewind->GetHistoricalLocation(Enemy, 0.45, Center);
+		TestEqual(TEXT("Between two frames the location is interpolated"), Center.X, 0.45 * Speed, 0.01);
+
+		Rewind->GetHistoricalLocation(Enemy, -1.0, Center);
+		TestEqual(TEXT("Older than the history gives the oldest frame"), Center.X, 0.0, 0.01);
+
+		Rewind->GetHistoricalLocation(Enemy, 5.0, Center);
+		TestEqual(TEXT("Newer than the history gives the newest frame"), Center.X, (NumFrames - 1) * FrameSeconds * Speed, 0.01);
+
+		TestFalse(TEXT("Unregistered characters have no history"), Rewind->GetHistoricalLocation(Other, 0.3, Center));
+
+		// More frames than the ring holds: the oldest ones are overwritten
+		for (int32 Frame = NumFrames; Frame < USlashRewindSubsystem::NumFrames + NumFrames; ++Frame)
+		{
+			World->TimeSeconds = Frame * FrameSeconds;
+			Enemy->SetActorLocation(FVector(Frame * FrameSeconds * Speed, 0.f, 0.f));
+			Rewind->Tick(FrameSeconds);
+		}
+		Rewind->GetHistoricalLocation(Enemy, 0.0, Center);
+		TestEqual(TEXT("After wrapping, the oldest kept frame is returned"), Center.X, NumFrames * FrameSeconds * Speed, 0.01);
+
+		Rewind->UnregisterCharacter(Enemy);
+		TestFalse(TEXT("Unregistering drops the history"), Rewind->GetHistoricalLocation(Enemy, 0.3, Center));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashRewindLagClaimTest, "Slash.Rewind.LaggedClaim",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashRewindLagClaimTest::RunTest(const FString& Parameters)
+{
+	using namespace SlashRewindTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	USlashRewindSubsystem* Rewind = World->GetSubsystem<USlashRewindSubsystem>();
+	if (TestNotNull(TEXT("Game worlds have the rewind subsystem"), Rewind))
+	{
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AEnemy* Enemy = World->SpawnActor<AEnemy>(AEnemy::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, Params);
+		Rewind->RegisterCharacter(Enemy);
+		RecordWalk(World, Rewind, Enemy);
+
+		// 150 ms round trip: the client shows the enemy a round trip plus the smoothing lag behind the server, which
+		// is the time ClaimHit sends (AEnemy::GetDisplayedServerTime)
+		const double Now = World->GetTimeSeconds();
+		const double Latency = 0.15;
+		const double DisplayedTime = Now - Latency - Enemy->GetNetSmoothingDelay();
+		const double CurrentServerTime = Now - Latency * 0.5;
+
+		// The claim traces through the enemy where the client saw it, the enemy claims against itself so the
+		// attacker's rewound location is in reach
+		const FVector Shown(DisplayedTime * Speed, 0.f, 0.f);
+		const FVector Across(0.f, 50.f, 0.f);
+		TestTrue(TEXT("A claim stamped with the displayed time passes"),
+			Rewind->ValidateHit(Enemy, Enemy, Shown + Across, Shown - Across, 5.f, DisplayedTime));
+		TestFalse(TEXT("The same claim stamped with the current server time fails"),
+			Rewind->ValidateHit(Enemy, Enemy, Shown + Across, Shown - Across, 5.f, CurrentServerTime));
+		TestFalse(TEXT("The same claim without rewinding fails"),
+			Rewind->ValidateHit(Enemy, Enemy, Shown + Across, Shown - Across, 5.f, Now));
+
+		const FVector Behind = Shown - FVector(Speed * 0.15, 0.f, 0.f);
+		TestFalse(TEXT("A claim behind the displayed pose fails"),
+			Rewind->ValidateHit(Enemy, Enemy, Behind + Across, Behind - Across, 5.f, DisplayedTime));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -0,0 +1,145 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/AttributeComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+#include "World/SlashSaveSubsystem.h"
+#include "World/SlashWorldStateSubsystem.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SlashSaveGameTests
+{
+	/** Attributes with a max of 100 health and stamina, so loaded values are not clamped */
+	static UAttributeComponent* MakeAttributes()
+	{
+		UAttributeComponent* Attributes = NewObject<UAttributeComponent>(GetTransientPackage());
+
+		FSlashAttributeModifierSpec MaxHealth;
+		MaxHealth.Attribute = ESlashAttribute::ESA_MaxHealth;
+		MaxHealth.Magnitude = 100.f;
+		FSlashAttributeModifierSpec MaxStamina;
+		MaxStamina.Attribute = ESlashAttribute::ESA_MaxStamina;
+		MaxStamina.Magnitude = 100.f;
+		const FSlashAttributeModifierSpec Modifiers[] = {MaxHealth, MaxStamina};
+		Attributes->AddModifiers(Modifiers, Attributes);
+		return Attributes;
+	}
+
+	/** Overwrites the header field at Offset of a save file */
+	static TArray<uint8> WithHeaderField(const TArray<uint8>& FileData, int64 Offset, int32 Value)
+	{
+		TArray<uint8> Result = FileData;
+		FMemoryWriter Writer(Result);
+		Writer.Seek(Offset);
+		Writer << Value;
+		return Result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashSaveRoundTripTest, "Slash.Save.RoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashSaveRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace SlashSaveGameTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	USlashWorldStateSubsystem* WorldState = World->GetSubsystem<USlashWorldStateSubsystem>();
+	if (TestNotNull(TEXT("Game worlds have the world state subsystem"), WorldState))
+	{
+		// Player and world blocks as USlashSaveSubsystem::BuildSnapshot writes them
+		UAttributeComponent* Saved = MakeAttributes();
+		{
+			float         Health = 70.f;
+			float         Stamina = 40.f;
+			int32         Gold = 12;
+			int32         Souls = 5;
+			TArray<uint8> Data;
+			FMemoryWriter Writer(Data);
+			Writer << Health << Stamina << Gold << Souls;
+			FMemoryReader Reader(Data);
+			Saved->SerializeSaveData(Reader);
+		}
+		WorldState->SetBenchmarkCells(8, 100);
+
+		TMap<FName, TBitArray<>> ExpectedCells;
+		for (const TPair<FName, FSlashWorldStateCell>& Pair : WorldState->GetCells())
+		{
+			ExpectedCells.Add(Pair.Key, Pair.Value.Consumed);
+		}
+
+		TArray<uint8> PlayerBlock;
+		TArray<uint8> WorldBlock;
+		FMemoryWriter PlayerWriter(PlayerBlock);
+		Saved->SerializeSaveData(PlayerWriter);
+		FMemoryWriter WorldWriter(WorldBlock);
+		WorldState->SerializeWorldState(WorldWriter);
+
+		TArray<uint8> Payload;
+		FMemoryWriter PayloadWriter(Payload);
+		PayloadWriter << PlayerBlock;
+		PayloadWriter << WorldBlock;
+
+		TArray<uint8> FileData;
+		TestTrue(TEXT("The payload compresses"), USlashSaveSubsystem::CompressPayload(Payload, FileData));
+
+		TArray<uint8> LoadedPayload;
+		int32         Version = 0;
+		TestTrue(TEXT("The file decompresses"), USlashSaveSubsystem::DecompressPayload(FileData, LoadedPayload, Version));
+		TestEqual(TEXT("Files are written at the latest version"), Version, static_cast<int32>(ESlashSaveVersion::Latest));
+		TestTrue(TEXT("The payload survives compression"), LoadedPayload == Payload);
+
+		// Applied as USlashSaveSubsystem::ApplySnapshot does, to fresh attributes and a cleared world state
+		TArray<uint8> LoadedPlayerBlock;
+		TArray<uint8> LoadedWorldBlock;
+		FMemoryReader Reader(LoadedPayload);
+		Reader << LoadedPlayerBlock;
+		Reader << LoadedWorldBlock;
+		TestFalse(TEXT("Both blocks are read"), Reader.IsError());
+
+		UAttributeComponent* Loaded = MakeAttributes();
+		FMemoryReader        PlayerReader(LoadedPlayerBlock);
+		Loaded->SerializeSaveData(PlayerReader);
+		TestEqual(TEXT("Health is restored"), Loaded->GetValue(ESlashAttribute::ESA_Health), 70.f);
+		TestEqual(TEXT("Stamina is restored"), Loaded->GetStamina(), 40.f);
+		TestEqual(TEXT("Gold is restored"), Loaded->GetGold(), 12);
+		TestEqual(TEXT("Souls are restored"), Loaded->GetSouls(), 5);
+
+		WorldState->SetBenchmarkCells(0, 0);
+		TestEqual(TEXT("The world state is cleared before loading"), WorldState->GetCells().Num(), 0);
+
+		FMemoryReader WorldReader(LoadedWorldBlock);
+		WorldState->SerializeWorldState(WorldReader);
+		TestFalse(TEXT("The world block is read"), WorldReader.IsError());
+		TestEqual(TEXT("Every cell is restored"), WorldState->GetCells().Num(), ExpectedCells.Num());
+		for (const TPair<FName, TBitArray<>>& Pair : ExpectedCells)
+		{
+			const FSlashWorldStateCell* Cell = WorldState->GetCells().Find(Pair.Key);
+			TestTrue(FString::Printf(TEXT("Consumed bits of %s are restored"), *Pair.Key.ToString()), Cell && Cell->Consumed == Pair.Value);
+		}
+
+		// Header: Magic, Version, UncompressedSize
+		TArray<uint8> Rejected;
+		TestFalse(TEXT("A wrong magic is rejected"),
+			USlashSaveSubsystem::DecompressPayload(WithHeaderField(FileData, 0, 0), Rejected, Version));
+		TestFalse(TEXT("A negative size is rejected"),
+			USlashSaveSubsystem::DecompressPayload(WithHeaderField(FileData, 8, -1), Rejected, Version));
+		TestFalse(TEXT("An oversized payload is rejected"),
+			USlashSaveSubsystem::DecompressPayload(WithHeaderField(FileData, 8, MAX_int32), Rejected, Version));
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/AttributeComponent.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SlashStaminaPredictionTests
+{
+	static constexpr float MaxStamina = 100.f;
+	static constexpr float RegenRate = 8.f;
+	static constexpr float DodgeCost = 14.f;
+
+	static FSlashAttributeModifierSpec MakeAdd(ESlashAttribute Attribute, float Magnitude)
+	{
+		FSlashAttributeModifierSpec Spec;
+		Spec.Attribute = Attribute;
+		Spec.Op = EAttributeModifierOp::EAMO_Add;
+		Spec.Magnitude = Magnitude;
+		return Spec;
+	}
+
+	/** An owning client's attributes, full stamina; without an owner nothing is marked for replication */
+	static UAttributeComponent* MakeAttributes()
+	{
+		UAttributeComponent* Attributes = NewObject<UAttributeComponent>(GetTransientPackage());
+
+		// Base values come from the save path, max and regen from modifiers, as the component is not registered
+		const FSlashAttributeModifierSpec Modifiers[] = {
+			MakeAdd(ESlashAttribute::ESA_MaxHealth, 100.f),
+			MakeAdd(ESlashAttribute::ESA_MaxStamina, MaxStamina),
+			MakeAdd(ESlashAttribute::ESA_StaminaRegenRate, RegenRate),
+		};
+		Attributes->AddModifiers(Modifiers, Attributes);
+
+		float         Health = 100.f;
+		float         Stamina = MaxStamina;
+		int32         Gold = 0;
+		int32         Souls = 0;
+		TArray<uint8> Data;
+		FMemoryWriter Writer(Data);
+		Writer << Health << Stamina << Gold << Souls;
+		FMemoryReader Reader(Data);
+		Attributes->SerializeSaveData(Reader);
+		return Attributes;
+	}
+
+	/** What the client does when it predicts an action: spend now, remember the cost until the server acks it */
+	static void Predict(UAttributeComponent* Attributes, float& PendingCost, float Cost)
+	{
+		Attributes->UseStamina(Cost);
+		PendingCost += Cost;
+		Attributes->SetPredictedStaminaCost(PendingCost);
+	}
+
+	/** What the client does on an ack: the acked cost leaves the pending sum, then the server value is taken */
+	static void Ack(UAttributeComponent* Attributes, float& PendingCost, float Cost, float ServerStamina)
+	{
+		PendingCost -= Cost;
+		Attributes->SetPredictedStaminaCost(PendingCost);
+		Attributes->ReconcileStamina(ServerStamina);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashStaminaPredictionTest, "Slash.Prediction.Stamina",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashStaminaPredictionTest::RunTest(const FString& Parameters)
+{
+	using namespace SlashStaminaPredictionTests;
+
+	{
+		UAttributeComponent* Attributes = MakeAttributes();
+		float                PendingCost = 0.f;
+		TestEqual(TEXT("Starts full"), Attributes->GetStamina(), MaxStamina);
+
+		Predict(Attributes, PendingCost, DodgeCost);
+		TestEqual(TEXT("A predicted dodge spends at once"), Attributes->GetStamina(), MaxStamina - DodgeCost);
+
+		Attributes->ReconcileStamina(MaxStamina);
+		TestEqual(TEXT("A server value from before the dodge does not give the stamina back"), Attributes->GetStamina(), MaxStamina - DodgeCost);
+
+		Ack(Attributes, PendingCost, DodgeCost, MaxStamina - DodgeCost);
+		TestEqual(TEXT("An accepted dodge keeps the spent stamina"), Attributes->GetStamina(), MaxStamina - DodgeCost);
+	}
+
+	{
+		UAttributeComponent* Attributes = MakeAttributes();
+		float                PendingCost = 0.f;
+		Predict(Attributes, PendingCost, DodgeCost);
+		Ack(Attributes, PendingCost, DodgeCost, MaxStamina);
+		TestEqual(TEXT("A rejected dodge refunds its stamina"), Attributes->GetStamina(), MaxStamina);
+	}
+
+	{
+		UAttributeComponent* Attributes = MakeAttributes();
+		float                PendingCost = 0.f;
+		Predict(Attributes, PendingCost, DodgeCost);
+		Predict(Attributes, PendingCost, DodgeCost);
+		TestEqual(TEXT("Two dodges in flight"), Attributes->GetStamina(), MaxStamina - 2.f * DodgeCost);
+
+		Ack(Attributes, PendingCost, DodgeCost, MaxStamina - DodgeCost);
+		TestEqual(TEXT("The first ack keeps the second dodge predicted"), Attributes->GetStamina(), MaxStamina - 2.f * DodgeCost);
+
+		Ack(Attributes, PendingCost, DodgeCost, MaxStamina - DodgeCost);
+		TestEqual(TEXT("A rejected second dodge refunds only its own cost"), Attributes->GetStamina(), MaxStamina - DodgeCost);
+	}
+
+	{
+		UAttributeComponent* Attributes = MakeAttributes();
+		float                PendingCost = 0.f;
+		Predict(Attributes, PendingCost, DodgeCost);
+		Attributes->ReconcileStamina(DodgeCost * 0.5f);
+		TestEqual(TEXT("Reconciled stamina never goes below zero"), Attributes->GetStamina(), 0.f);
+
+		Attributes->RegenStamina(1.f);
+		TestEqual(TEXT("Regen adds its rate per second"), Attributes->GetStamina(), RegenRate);
+
+		Attributes->RegenStamina(100.f);
+		TestEqual(TEXT("Regen stops at the max"), Attributes->GetStamina(), MaxStamina);
+	}
+
+	return true;
+}
+
+#endif
@@ -0,0 +1,133 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "Components/AttributeComponent.h"
+#include "Components/StatusEffectSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Enemy/Enemy.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/AutomationTest.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SlashStatusEffectTests
+{
+	static FStatusEffectSpec MakeSpec(EStatusEffectType Type, float AmountPerSecond, float Duration)
+	{
+		FStatusEffectSpec Spec;
+		Spec.Type = Type;
+		Spec.AmountPerSecond = AmountPerSecond;
+		Spec.Duration = Duration;
+		return Spec;
+	}
+
+	/** Full health and stamina of 100; actors are not initialized in a world that has not begun play */
+	static void InitAttributes(AEnemy* Enemy)
+	{
+		UAttributeComponent* Attributes = Enemy->GetAttributes();
+
+		FSlashAttributeModifierSpec MaxHealth;
+		MaxHealth.Attribute = ESlashAttribute::ESA_MaxHealth;
+		MaxHealth.Magnitude = 100.f;
+		FSlashAttributeModifierSpec MaxStamina;
+		MaxStamina.Attribute = ESlashAttribute::ESA_MaxStamina;
+		MaxStamina.Magnitude = 100.f;
+		const FSlashAttributeModifierSpec Modifiers[] = {MaxHealth, MaxStamina};
+		Attributes->AddModifiers(Modifiers, Attributes);
+
+		float         Health = 100.f;
+		float         Stamina = 100.f;
+		int32         Gold = 0;
+		int32         Souls = 0;
+		TArray<uint8> Data;
+		FMemoryWriter Writer(Data);
+		Writer << Health << Stamina << Gold << Souls;
+		FMemoryReader Reader(Data);
+		Attributes->SerializeSaveData(Reader);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSlashStatusEffectTest, "Slash.StatusEffects.Advance",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FSlashStatusEffectTest::RunTest(const FString& Parameters)
+{
+	using namespace SlashStatusEffectTests;
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	UStatusEffectSubsystem* Effects = World->GetSubsystem<UStatusEffectSubsystem>();
+	if (TestNotNull(TEXT("Game worlds have the status effect subsystem"), Effects))
+	{
+		const float Interval = IConsoleManager::Get().FindConsoleVariable(TEXT("Slash.StatusEffects.Interval"))->GetFloat();
+		const int32 MaxStacks = IConsoleManager::Get().FindConsoleVariable(TEXT("Slash.StatusEffects.MaxStacks"))->GetInt();
+
+		FActorSpawnParameters Params;
+		Params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AEnemy* Target = World->SpawnActor<AEnemy>(AEnemy::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, Params);
+		AEnemy* Stacked = World->SpawnActor<AEnemy>(AEnemy::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, Params);
+		AEnemy* Dead = World->SpawnActor<AEnemy>(AEnemy::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, Params);
+		InitAttributes(Target);
+		InitAttributes(Stacked);
+		const UAttributeComponent* Attributes = Target->GetAttributes();
+
+		Effects->ApplyEffect(Dead, MakeSpec(EStatusEffectType::ESE_Bleed, 10.f, 1.f));
+		Effects->ApplyEffect(Target, MakeSpec(EStatusEffectType::ESE_Bleed, 0.f, 1.f));
+		Effects->ApplyEffect(Target, MakeSpec(EStatusEffectType::ESE_Bleed, 10.f, 0.f));
+		TestEqual(TEXT("Dead characters and empty specs add nothing"), Effects->GetNumEffects(), 0);
+
+		const FStatusEffectSpec Specs[] = {
+			MakeSpec(EStatusEffectType::ESE_Bleed, 10.f, 1.f),
+			MakeSpec(EStatusEffectType::ESE_Poison, 4.f, 2.f),
+			MakeSpec(EStatusEffectType::ESE_StaminaDrain, 20.f, 1.f),
+		};
+		Effects->ApplyEffects(Target, Specs);
+		TestEqual(TEXT("Every spec is a stack"), Effects->GetNumEffects(), 3);
+
+		TestEqual(TEXT("Three effects on one character are one change"), Effects->Advance(0.5f), 1);
+		TestEqual(TEXT("Bleed and poison are summed into health"), Attributes->GetValue(ESlashAttribute::ESA_Health), 100.f - 5.f - 2.f);
+		TestEqual(TEXT("Drain takes stamina"), Attributes->GetValue(ESlashAttribute::ESA_Stamina), 100.f - 10.f);
+
+		Effects->Advance(1.f);
+		TestEqual(TEXT("An effect stops at the end of its duration"), Attributes->GetValue(ESlashAttribute::ESA_Health), 93.f - 5.f - 4.f);
+		TestEqual(TEXT("Drain stops at the end of its duration"), Attributes->GetValue(ESlashAttribute::ESA_Stamina), 90.f - 10.f);
+		TestEqual(TEXT("Expired effects are removed"), Effects->GetNumEffects(), 1);
+
+		// The remaining poison only applies once an interval has passed
+		Effects->Tick(Interval * 0.5f);
+		TestEqual(TEXT("Nothing applies before the interval"), Attributes->GetValue(ESlashAttribute::ESA_Health), 84.f);
+		Effects->Tick(Interval * 0.5f);
+		TestEqual(TEXT("The whole interval applies at once"), Attributes->GetValue(ESlashAttribute::ESA_Health), 84.f - 4.f * Interval);
+		Effects->RemoveAll();
+		TestEqual(TEXT("RemoveAll clears every effect"), Effects->GetNumEffects(), 0);
+
+		for (int32 Stack = 1; Stack <= MaxStacks; ++Stack)
+		{
+			Effects->ApplyEffect(Stacked, MakeSpec(EStatusEffectType::ESE_Bleed, 1.f, static_cast<float>(Stack)));
+		}
+		Effects->ApplyEffect(Stacked, MakeSpec(EStatusEffectType::ESE_Bleed, 2.f, static_cast<float>(MaxStacks) + 2.f));
+		TestEqual(TEXT("Stacks are capped"), Effects->GetNumEffects(), MaxStacks);
+
+		// The one second stack was refreshed to the stronger, longer application
+		Effects->Advance(1.f);
+		TestEqual(TEXT("Past the cap the shortest stack is refreshed"),
+			Stacked->GetAttributes()->GetValue(ESlashAttribute::ESA_Health), 100.f - 2.f - static_cast<float>(MaxStacks - 1));
+		TestEqual(TEXT("The refreshed stack outlasts the one second"), Effects->GetNumEffects(), MaxStacks);
+
+		Effects->ApplyEffect(Target, MakeSpec(EStatusEffectType::ESE_Poison, 4.f, 2.f));
+		Effects->RemoveTarget(Stacked);
+		TestEqual(TEXT("RemoveTarget drops only that character's effects"), Effects->GetNumEffects(), 1);
+		Effects->RemoveAll();
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+	return true;
+}
+
+#endif
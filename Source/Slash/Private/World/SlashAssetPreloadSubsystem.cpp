@@ -0,0 +1,283 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "World/SlashAssetPreloadSubsystem.h"
+
+#include "NiagaraSystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Particles/ParticleSystem.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Slash/Slash.h"
+#include "Sound/SoundBase.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Preload Archetypes"), STAT_PreloadArchetypes, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Preload Pending"), STAT_PreloadPending, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Preload Misses"), STAT_PreloadMisses, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Preload Sync Loads"), STAT_PreloadSyncLoads, STATGROUP_Slash);
+
+CSV_DEFINE_CATEGORY(SlashPreload, true);
+
+namespace SlashPreload
+{
+	static int32 Enabled = 1;
+	static FAutoConsoleVariableRef CVarEnabled(TEXT("Slash.Preload.Enabled"), Enabled,
+		TEXT("0: archetype bundles are not streamed ahead, soft references resolve at their first use (for comparison)."));
+
+	/** Nothing plays sounds or effects without a renderer */
+	static bool IsCosmetic(const UClass* AssetClass)
+	{
+		return AssetClass && (AssetClass->IsChildOf<USoundBase>() || AssetClass->IsChildOf<UParticleSystem>() || AssetClass->IsChildOf<UNiagaraSystem>());
+	}
+
+	static void AddAsset(const FSoftObjectProperty* Property, const FSoftObjectPtr& Value, TArray<FSoftObjectPath>& OutAssets)
+	{
+		if (Value.IsNull() || (!FApp::CanEverRender() && IsCosmetic(Property->PropertyClass)))
+			return;
+
+		OutAssets.AddUnique(Value.ToSoftObjectPath());
+	}
+
+	/** Assets streamed in after a miss, requested once and kept resident like a bundle */
+	static TSet<FSoftObjectPath> MissRequests;
+}
+
+bool USlashAssetPreloadSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USlashAssetPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	InitializeTime = FPlatformTime::Seconds();
+	InitializeMemory = FPlatformMemory::GetStats().UsedPhysical;
+}
+
+void USlashAssetPreloadSubsystem::Deinitialize()
+{
+	for (TPair<UClass*, FArchetype>& Pair : Archetypes)
+	{
+		if (Pair.Value.Handle.IsValid())
+		{
+			Pair.Value.Handle->CancelHandle();
+		}
+	}
+	Archetypes.Empty();
+
+	Super::Deinitialize();
+}
+
+void USlashAssetPreloadSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Cells loaded with the map have registered their actors by now
+	if (NumPending == 0)
+	{
+		ReportStartup();
+	}
+}
+
+void USlashAssetPreloadSubsystem::AddUser(const AActor* Actor)
+{
+	if (SlashPreload::Enabled)
+	{
+		AddClassUser(Actor->GetClass());
+	}
+}
+
+void USlashAssetPreloadSubsystem::RemoveUser(const AActor* Actor)
+{
+	RemoveClassUser(Actor->GetClass());
+}
+
+void USlashAssetPreloadSubsystem::AddClassUser(UClass* Class)
+{
+	FArchetype& Archetype = Archetypes.FindOrAdd(Class);
+	if (Archetype.NumUsers++ > 0)
+		return;
+
+	SET_DWORD_STAT(STAT_PreloadArchetypes, Archetypes.Num());
+
+	GatherAssets(Class, Archetype.Assets);
+	if (Archetype.Assets.Num() == 0)
+	{
+		Archetype.LoadSeconds = 0.0;
+		return;
+	}
+
+	++NumPending;
+	SET_DWORD_STAT(STAT_PreloadPending, NumPending);
+	Archetype.RequestTime = FPlatformTime::Seconds();
+	Archetype.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Archetype.Assets, FStreamableDelegate::CreateWeakLambda(this, [this, Class]()
+	{
+		OnArchetypeLoaded(Class);
+	}));
+}
+
+void USlashAssetPreloadSubsystem::RemoveClassUser(UClass* Class)
+{
+	FArchetype* Archetype = Archetypes.Find(Class);
+	if (Archetype == nullptr || --Archetype->NumUsers > 0)
+		return;
+
+	if (Archetype->Handle.IsValid())
+	{
+		if (Archetype->LoadSeconds < 0.0)
+		{
+			Archetype->Handle->CancelHandle();
+			--NumPending;
+		}
+		else
+		{
+			Archetype->Handle->ReleaseHandle();
+		}
+	}
+
+	const TArray<UClass*> Dependencies = MoveTemp(Archetype->Dependencies);
+	Archetypes.Remove(Class);
+	for (UClass* Dependency : Dependencies)
+	{
+		RemoveClassUser(Dependency);
+	}
+
+	SET_DWORD_STAT(STAT_PreloadArchetypes, Archetypes.Num());
+	SET_DWORD_STAT(STAT_PreloadPending, NumPending);
+}
+
+void USlashAssetPreloadSubsystem::OnArchetypeLoaded(UClass* Class)
+{
+	FArchetype* Archetype = Archetypes.Find(Class);
+	if (Archetype == nullptr || Archetype->LoadSeconds >= 0.0)
+		return;
+
+	Archetype->LoadSeconds = FPlatformTime::Seconds() - Archetype->RequestTime;
+	--NumPending;
+	SET_DWORD_STAT(STAT_PreloadPending, NumPending);
+	CSV_CUSTOM_STAT(SlashPreload, BundleLoadMs, Archetype->LoadSeconds * 1000.0, ECsvCustomStatOp::Max);
+
+	// Classes in the bundle bring their own, e.g. the weapon's equip sound
+	for (const FSoftObjectPath& Asset : Archetype->Assets)
+	{
+		UClass* Dependency = Cast<UClass>(Asset.ResolveObject());
+		if (Dependency && Dependency->IsChildOf<AActor>())
+		{
+			Archetype->Dependencies.Add(Dependency);
+		}
+	}
+
+	// Adding users can grow the map, Archetype is not used past this point
+	const TArray<UClass*> Dependencies = Archetype->Dependencies;
+	for (UClass* Dependency : Dependencies)
+	{
+		AddClassUser(Dependency);
+	}
+
+	if (NumPending == 0 && !bStartupReported && GetWorld()->HasBegunPlay())
+	{
+		ReportStartup();
+	}
+}
+
+void USlashAssetPreloadSubsystem::GatherAssets(UClass* Class, TArray<FSoftObjectPath>& OutAssets)
+{
+	const UObject* Defaults = Class->GetDefaultObject();
+	for (TFieldIterator<FProperty> It(Class); It; ++It)
+	{
+		if (const FSoftObjectProperty* SoftProperty = CastField<FSoftObjectProperty>(*It))
+		{
+			SlashPreload::AddAsset(SoftProperty, *SoftProperty->GetPropertyValuePtr_InContainer(Defaults), OutAssets);
+		}
+		else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(*It))
+		{
+			const FSoftObjectProperty* Inner = CastField<FSoftObjectProperty>(ArrayProperty->Inner);
+			if (Inner == nullptr)
+				continue;
+
+			FScriptArrayHelper_InContainer Array(ArrayProperty, Defaults);
+			for (int32 Index = 0; Index < Array.Num(); ++Index)
+			{
+				SlashPreload::AddAsset(Inner, *Inner->GetPropertyValuePtr(Array.GetRawPtr(Index)), OutAssets);
+			}
+		}
+	}
+}
+
+void USlashAssetPreloadSubsystem::LoadClass(const TSoftClassPtr<UObject>& Class, TFunction<void(UClass*)>&& OnLoaded)
+{
+	if (UClass* Loaded = Class.Get())
+	{
+		OnLoaded(Loaded);
+		return;
+	}
+	if (Class.IsNull())
+		return;
+
+	const FSoftObjectPath Path = Class.ToSoftObjectPath();
+	RecordMiss(Path, false);
+	UAssetManager::GetStreamableManager().RequestAsyncLoad(Path, FStreamableDelegate::CreateLambda([Path, OnLoaded = MoveTemp(OnLoaded)]()
+	{
+		if (UClass* Loaded = Cast<UClass>(Path.ResolveObject()))
+		{
+			OnLoaded(Loaded);
+		}
+	}));
+}
+
+void USlashAssetPreloadSubsystem::RecordMiss(const FSoftObjectPath& Asset, bool bSynchronous)
+{
+	if (bSynchronous)
+	{
+		INC_DWORD_STAT(STAT_PreloadSyncLoads);
+		CSV_CUSTOM_STAT(SlashPreload, SyncLoads, 1, ECsvCustomStatOp::Accumulate);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_PreloadMisses);
+		CSV_CUSTOM_STAT(SlashPreload, Misses, 1, ECsvCustomStatOp::Accumulate);
+	}
+	UE_LOG(LogSlash, Verbose, TEXT("Asset preload - %s was not resident at its use (%s)"), *Asset.ToString(), bSynchronous ? TEXT("loaded synchronously") : TEXT("loading"));
+}
+
+void USlashAssetPreloadSubsystem::RequestMissing(const FSoftObjectPath& Asset)
+{
+	RecordMiss(Asset, false);
+
+	bool bAlreadyRequested = false;
+	SlashPreload::MissRequests.Add(Asset, &bAlreadyRequested);
+	if (!bAlreadyRequested)
+	{
+		UAssetManager::GetStreamableManager().RequestAsyncLoad(Asset, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority, true);
+	}
+}
+
+void USlashAssetPreloadSubsystem::ReportStartup()
+{
+	bStartupReported = true;
+
+	int32 NumAssets = 0;
+	for (const TPair<UClass*, FArchetype>& Pair : Archetypes)
+	{
+		NumAssets += Pair.Value.Assets.Num();
+	}
+
+	const double StartupMs = (FPlatformTime::Seconds() - InitializeTime) * 1000.0;
+	const int64  MemoryDelta = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - static_cast<int64>(InitializeMemory);
+	CSV_CUSTOM_STAT(SlashPreload, StartupMs, StartupMs, ECsvCustomStatOp::Set);
+	UE_LOG(LogSlash, Log, TEXT("Asset preload - %s startup settled after %.1f ms: %d archetypes, %d assets resident, physical memory %+.1f MB since world init"),
+	       *GetWorld()->GetMapName(), StartupMs, Archetypes.Num(), NumAssets, MemoryDelta / (1024.0 * 1024.0));
+}
+
+void USlashAssetPreloadSubsystem::Report() const
+{
+	for (const TPair<UClass*, FArchetype>& Pair : Archetypes)
+	{
+		const FArchetype& Archetype = Pair.Value;
+		UE_LOG(LogSlash, Log, TEXT("Asset preload - %s: %d users, %d assets, %s"), *Pair.Key->GetName(), Archetype.NumUsers, Archetype.Assets.Num(),
+		       Archetype.LoadSeconds < 0.0 ? TEXT("loading") : *FString::Printf(TEXT("loaded in %.1f ms"), Archetype.LoadSeconds * 1000.0));
+	}
+	UE_LOG(LogSlash, Log, TEXT("Asset preload - %d archetypes, %d pending"), Archetypes.Num(), NumPending);
+}
@@ -0,0 +1,239 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "World/SlashCheckpointSubsystem.h"
+
+#include "EngineUtils.h"
+#include "Breakable/BreakableActor.h"
+#include "Breakable/FractureDebrisSubsystem.h"
+#include "Characters/SlashCharacter.h"
+#include "Components/AttributeComponent.h"
+#include "Enemy/Enemy.h"
+#include "Items/Item.h"
+#include "Items/PickupSubsystem.h"
+#include "Kismet/GameplayStatics.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Slash/Slash.h"
+#include "World/SlashWorldStateSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Checkpoint Capture"), STAT_CheckpointCapture, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Checkpoint Restore"), STAT_CheckpointRestore, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Checkpoint Bytes"), STAT_CheckpointBytes, STATGROUP_Slash);
+
+namespace SlashCheckpoint
+{
+	static void Capture(const TArray<FString>& Args, UWorld* World)
+	{
+		if (USlashCheckpointSubsystem* Checkpoint = World ? World->GetSubsystem<USlashCheckpointSubsystem>() : nullptr)
+		{
+			Checkpoint->CaptureCheckpoint();
+		}
+	}
+
+	static void Restore(const TArray<FString>& Args, UWorld* World)
+	{
+		if (USlashCheckpointSubsystem* Checkpoint = World ? World->GetSubsystem<USlashCheckpointSubsystem>() : nullptr)
+		{
+			Checkpoint->RestoreCheckpoint();
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashCheckpointCaptureCommand(
+	TEXT("Slash.Checkpoint.Capture"),
+	TEXT("Slash.Checkpoint.Capture - captures the current gameplay state as the respawn checkpoint"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashCheckpoint::Capture));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashCheckpointRestoreCommand(
+	TEXT("Slash.Checkpoint.Restore"),
+	TEXT("Slash.Checkpoint.Restore - restores the last checkpoint in place"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashCheckpoint::Restore));
+
+bool USlashCheckpointSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void USlashCheckpointSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Actors and the player pawn begin play after this, take the initial checkpoint once they have
+	InWorld.GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &USlashCheckpointSubsystem::CaptureCheckpoint));
+}
+
+void USlashCheckpointSubsystem::CaptureCheckpoint()
+{
+	SCOPE_CYCLE_COUNTER(STAT_CheckpointCapture);
+
+	UWorld* World = GetWorld();
+	Checkpoint.Enemies.Reset();
+	Checkpoint.Breakables.Reset();
+	Checkpoint.Items.Reset();
+	Checkpoint.Data.Reset();
+
+	FMemoryWriter Writer(Checkpoint.Data);
+
+	// Records are length prefixed so the ones whose actor is gone at restore can be skipped
+	TArray<uint8> Record;
+	if (ASlashCharacter* Player = Cast<ASlashCharacter>(UGameplayStatics::GetPlayerPawn(World, 0)))
+	{
+		FMemoryWriter RecordWriter(Record);
+		FTransform    PlayerTransform = Player->GetActorTransform();
+		RecordWriter << PlayerTransform;
+		Player->SerializeSaveData(RecordWriter);
+	}
+	Writer << Record;
+
+	for (TActorIterator<AEnemy> It(World); It; ++It)
+	{
+		AEnemy* Enemy = *It;
+		if (Enemy->GetEnemyState() == EEnemyState::EES_Dead || Enemy->IsHidden())
+			continue;
+
+		Checkpoint.Enemies.Add(Enemy);
+		Record.Reset();
+		FMemoryWriter RecordWriter(Record);
+		FTransform    EnemyTransform = Enemy->GetActorTransform();
+		RecordWriter << EnemyTransform;
+		if (UAttributeComponent* Attributes = Enemy->GetAttributes())
+		{
+			Attributes->SerializeSaveData(RecordWriter);
+		}
+		Writer << Record;
+	}
+
+	for (TActorIterator<ABreakableActor> It(World); It; ++It)
+	{
+		if (!It->IsBroken())
+		{
+			Checkpoint.Breakables.Add(*It);
+		}
+	}
+
+	for (TActorIterator<AItem> It(World); It; ++It)
+	{
+		if (It->GetItemState() == EItemState::EIS_Hovering && It->IsItemActive() && !It->IsPickupVisual())
+		{
+			Checkpoint.Items.Add(*It);
+		}
+	}
+
+	if (USlashWorldStateSubsystem* WorldState = World->GetSubsystem<USlashWorldStateSubsystem>())
+	{
+		WorldState->SerializeWorldState(Writer);
+	}
+
+	Checkpoint.bValid = !Writer.IsError();
+	SET_DWORD_STAT(STAT_CheckpointBytes, Checkpoint.Data.Num());
+}
+
+void USlashCheckpointSubsystem::RestoreCheckpoint()
+{
+	if (!Checkpoint.bValid)
+		return;
+
+	SCOPE_CYCLE_COUNTER(STAT_CheckpointRestore);
+	const double StartTime = FPlatformTime::Seconds();
+
+	UWorld*       World = GetWorld();
+	FMemoryReader Reader(Checkpoint.Data);
+
+	TArray<uint8> Record;
+	Reader << Record;
+	ASlashCharacter* Player = Cast<ASlashCharacter>(UGameplayStatics::GetPlayerPawn(World, 0));
+	if (Player && Record.Num() > 0)
+	{
+		FMemoryReader RecordReader(Record);
+		FTransform    PlayerTransform;
+		RecordReader << PlayerTransform;
+
+		Player->SetActorTransform(PlayerTransform, false, nullptr, ETeleportType::ResetPhysics);
+		if (AController* Controller = Player->GetController())
+		{
+			Controller->SetControlRotation(PlayerTransform.Rotator());
+		}
+		Player->Revive();
+		Player->SerializeSaveData(RecordReader);
+	}
+
+	int32 NumRestoredEnemies = 0;
+	for (const TWeakObjectPtr<AEnemy>& WeakEnemy : Checkpoint.Enemies)
+	{
+		Reader << Record;
+		AEnemy* Enemy = WeakEnemy.Get();
+		if (Enemy == nullptr)
+			continue;
+
+		FMemoryReader RecordReader(Record);
+		FTransform    EnemyTransform;
+		RecordReader << EnemyTransform;
+		if (UAttributeComponent* Attributes = Enemy->GetAttributes())
+		{
+			Attributes->SerializeSaveData(RecordReader);
+		}
+
+		Enemy->SetActorTransform(EnemyTransform, false, nullptr, ETeleportType::ResetPhysics);
+		Enemy->RestoreFromCheckpoint();
+		++NumRestoredEnemies;
+	}
+
+	if (USlashWorldStateSubsystem* WorldState = World->GetSubsystem<USlashWorldStateSubsystem>())
+	{
+		WorldState->SerializeWorldState(Reader);
+	}
+
+	// Fresh debris would otherwise hang around next to the reset breakables
+	if (UFractureDebrisSubsystem* Debris = World->GetSubsystem<UFractureDebrisSubsystem>())
+	{
+		Debris->ReleaseAll();
+	}
+
+	for (const TWeakObjectPtr<ABreakableActor>& Breakable : Checkpoint.Breakables)
+	{
+		if (Breakable.IsValid())
+		{
+			Breakable->ResetBreakable();
+		}
+	}
+
+	// Placed pickups come back, dropped ones (treasure, souls) go away
+	if (UPickupSubsystem* Pickups = World->GetSubsystem<UPickupSubsystem>())
+	{
+		Pickups->RemoveAllPickups();
+	}
+
+	TArray<AItem*> SpawnedItems;
+	for (TActorIterator<AItem> It(World); It; ++It)
+	{
+		AItem* Item = *It;
+		if (Item->IsPickupVisual())
+			continue;
+
+		if (Checkpoint.Items.Contains(Item))
+		{
+			Item->SetItemActive(true);
+		}
+		else if (Item->GetItemState() == EItemState::EIS_Hovering && !USlashWorldStateSubsystem::IsTrackedActor(Item))
+		{
+			SpawnedItems.Add(Item);
+		}
+	}
+
+	for (AItem* Item : SpawnedItems)
+	{
+		Item->Destroy();
+	}
+
+	UE_LOG(LogSlash, Log, TEXT("Checkpoint restored in %.3f ms - %d/%d enemies, %d bytes"),
+	       (FPlatformTime::Seconds() - StartTime) * 1000.0, NumRestoredEnemies, Checkpoint.Enemies.Num(), Checkpoint.Data.Num());
+}
+
+bool USlashCheckpointSubsystem::CanRevive(const AEnemy* Enemy) const
+{
+	return Checkpoint.bValid && Checkpoint.Enemies.ContainsByPredicate([Enemy](const TWeakObjectPtr<AEnemy>& Entry)
+	{
+		return Entry.Get() == Enemy;
+	});
+}
@@ -0,0 +1,291 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "World/SlashFeedbackSubsystem.h"
+
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Components/AudioComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/WorldSettings.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Slash/Slash.h"
+#include "Sound/SoundBase.h"
+
+DECLARE_CYCLE_STAT(TEXT("Feedback Dispatch"), STAT_FeedbackDispatch, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Feedback Components"), STAT_FeedbackComponents, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Feedback Active"), STAT_FeedbackActive, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Feedback Requests"), STAT_FeedbackRequests, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Feedback Merged"), STAT_FeedbackMerged, STATGROUP_Slash);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Feedback Culled"), STAT_FeedbackCulled, STATGROUP_Slash);
+
+CSV_DEFINE_CATEGORY(SlashFeedback, true);
+
+namespace SlashFeedback
+{
+	static int32 MaxPerAsset = 4;
+	static FAutoConsoleVariableRef CVarMaxPerAsset(TEXT("Slash.Feedback.MaxPerAsset"), MaxPerAsset,
+		TEXT("Instances of one sound or effect playing at once."));
+
+	static int32 MaxSounds = 16;
+	static FAutoConsoleVariableRef CVarMaxSounds(TEXT("Slash.Feedback.MaxSounds"), MaxSounds,
+		TEXT("Feedback sounds playing at once."));
+
+	static int32 MaxEffects = 24;
+	static FAutoConsoleVariableRef CVarMaxEffects(TEXT("Slash.Feedback.MaxEffects"), MaxEffects,
+		TEXT("Feedback particle effects playing at once."));
+
+	static float CullDistance = 6000.f;
+	static FAutoConsoleVariableRef CVarCullDistance(TEXT("Slash.Feedback.CullDistance"), CullDistance,
+		TEXT("Requests further than this from the view are dropped."));
+
+	static float MergeDistance = 100.f;
+	static FAutoConsoleVariableRef CVarMergeDistance(TEXT("Slash.Feedback.MergeDistance"), MergeDistance,
+		TEXT("Requests for the same asset in one frame closer than this to a played one are merged into it."));
+}
+
+bool USlashFeedbackSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USlashFeedbackSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USlashFeedbackSubsystem, STATGROUP_Tickables);
+}
+
+void USlashFeedbackSubsystem::Deinitialize()
+{
+	for (UAudioComponent* Audio : FreeAudio)
+	{
+		Audio->DestroyComponent();
+	}
+	for (UAudioComponent* Audio : ActiveAudio)
+	{
+		Audio->DestroyComponent();
+	}
+	for (UFXSystemComponent* Effect : FreeEffects)
+	{
+		Effect->DestroyComponent();
+	}
+	for (UFXSystemComponent* Effect : ActiveEffects)
+	{
+		Effect->DestroyComponent();
+	}
+	FreeAudio.Empty();
+	ActiveAudio.Empty();
+	FreeEffects.Empty();
+	ActiveEffects.Empty();
+
+	Super::Deinitialize();
+}
+
+void USlashFeedbackSubsystem::PlaySound(USoundBase* Sound, const FVector& Location)
+{
+	AddRequest(Sound, Location, EFeedbackType::Sound);
+}
+
+void USlashFeedbackSubsystem::SpawnParticles(UParticleSystem* Template, const FVector& Location)
+{
+	AddRequest(Template, Location, EFeedbackType::Particles);
+}
+
+void USlashFeedbackSubsystem::SpawnNiagara(UNiagaraSystem* System, const FVector& Location)
+{
+	AddRequest(System, Location, EFeedbackType::Niagara);
+}
+
+void USlashFeedbackSubsystem::AddRequest(UObject* Asset, const FVector& Location, EFeedbackType Type)
+{
+	// Nobody to hear or see it
+	if (Asset == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+		return;
+
+	Requests.Add({ Asset, Location, Type, 0.0 });
+	INC_DWORD_STAT(STAT_FeedbackRequests);
+}
+
+void USlashFeedbackSubsystem::Tick(float DeltaTime)
+{
+	Dispatch();
+}
+
+void USlashFeedbackSubsystem::Dispatch()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FeedbackDispatch);
+
+	ReleaseFinished();
+	if (Requests.Num() == 0)
+		return;
+
+	FVector ViewLocation;
+	bool    bHasView = false;
+	if (APlayerController* PlayerController = GetWorld()->GetFirstPlayerController())
+	{
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		bHasView = true;
+	}
+
+	const double CullSquared = FMath::Square(SlashFeedback::CullDistance);
+	int32        NumCulled = 0;
+	for (int32 Index = Requests.Num() - 1; Index >= 0; --Index)
+	{
+		FFeedbackRequest& Request = Requests[Index];
+		Request.DistanceSquared = bHasView ? FVector::DistSquared(ViewLocation, Request.Location) : 0.0;
+		if (Request.DistanceSquared > CullSquared)
+		{
+			Requests.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			++NumCulled;
+		}
+	}
+
+	// Nearest first, so they win the concurrency limits
+	Requests.Sort([](const FFeedbackRequest& A, const FFeedbackRequest& B) { return A.DistanceSquared < B.DistanceSquared; });
+
+	const double                                      MergeSquared = FMath::Square(SlashFeedback::MergeDistance);
+	TArray<const FFeedbackRequest*, TInlineAllocator<32>> Played;
+	int32                                             NumMerged = 0;
+	for (const FFeedbackRequest& Request : Requests)
+	{
+		const bool bMerged = Played.ContainsByPredicate([&Request, MergeSquared](const FFeedbackRequest* Other)
+		{
+			return Other->Asset == Request.Asset && FVector::DistSquared(Other->Location, Request.Location) < MergeSquared;
+		});
+		if (bMerged)
+		{
+			++NumMerged;
+			continue;
+		}
+
+		if (CanPlay(Request.Asset, Request.Type))
+		{
+			PlayRequest(Request);
+			Played.Add(&Request);
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_FeedbackMerged, NumMerged);
+	INC_DWORD_STAT_BY(STAT_FeedbackCulled, NumCulled);
+	SET_DWORD_STAT(STAT_FeedbackActive, GetNumActive());
+	CSV_CUSTOM_STAT(SlashFeedback, Requests, Requests.Num() + NumCulled, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(SlashFeedback, Played, Played.Num(), ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(SlashFeedback, Merged, NumMerged, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(SlashFeedback, Culled, NumCulled, ECsvCustomStatOp::Accumulate);
+
+	Requests.Reset();
+}
+
+bool USlashFeedbackSubsystem::CanPlay(const UObject* Asset, EFeedbackType Type) const
+{
+	if (NumPlaying.FindRef(Asset) >= SlashFeedback::MaxPerAsset)
+		return false;
+
+	return Type == EFeedbackType::Sound ? ActiveAudio.Num() < SlashFeedback::MaxSounds : ActiveEffects.Num() < SlashFeedback::MaxEffects;
+}
+
+void USlashFeedbackSubsystem::PlayRequest(const FFeedbackRequest& Request)
+{
+	++NumPlaying.FindOrAdd(Request.Asset);
+
+	if (Request.Type == EFeedbackType::Sound)
+	{
+		UAudioComponent* Audio = AcquireAudio();
+		Audio->SetWorldLocation(Request.Location);
+		Audio->SetSound(CastChecked<USoundBase>(Request.Asset));
+		Audio->Play();
+		ActiveAudio.Add(Audio);
+		return;
+	}
+
+	UFXSystemComponent* Effect = AcquireEffect(Request.Type);
+	Effect->SetWorldLocation(Request.Location);
+	if (UParticleSystemComponent* Particles = Cast<UParticleSystemComponent>(Effect))
+	{
+		Particles->SetTemplate(CastChecked<UParticleSystem>(Request.Asset));
+	}
+	else
+	{
+		CastChecked<UNiagaraComponent>(Effect)->SetAsset(CastChecked<UNiagaraSystem>(Request.Asset));
+	}
+	Effect->Activate(true);
+	ActiveEffects.Add(Effect);
+}
+
+void USlashFeedbackSubsystem::ReleaseFinished()
+{
+	for (int32 Index = ActiveAudio.Num() - 1; Index >= 0; --Index)
+	{
+		UAudioComponent* Audio = ActiveAudio[Index];
+		if (!Audio->IsPlaying())
+		{
+			--NumPlaying.FindOrAdd(Audio->Sound);
+			ActiveAudio.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			FreeAudio.Add(Audio);
+		}
+	}
+
+	for (int32 Index = ActiveEffects.Num() - 1; Index >= 0; --Index)
+	{
+		UFXSystemComponent*       Effect = ActiveEffects[Index];
+		UParticleSystemComponent* Particles = Cast<UParticleSystemComponent>(Effect);
+		const bool                bFinished = Particles ? Particles->HasCompleted() : !Effect->IsActive();
+		if (bFinished)
+		{
+			--NumPlaying.FindOrAdd(Effect->GetFXSystemAsset());
+			ActiveEffects.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			FreeEffects.Add(Effect);
+		}
+	}
+}
+
+UAudioComponent* USlashFeedbackSubsystem::AcquireAudio()
+{
+	if (FreeAudio.Num() > 0)
+		return FreeAudio.Pop(EAllowShrinking::No);
+
+	UAudioComponent* Audio = NewObject<UAudioComponent>(GetWorld()->GetWorldSettings());
+	Audio->bAutoActivate = false;
+	Audio->bAutoDestroy = false;
+	Audio->bAllowSpatialization = true;
+	Audio->SetUsingAbsoluteLocation(true);
+	Audio->RegisterComponentWithWorld(GetWorld());
+
+	++NumComponentsCreated;
+	INC_DWORD_STAT(STAT_FeedbackComponents);
+	return Audio;
+}
+
+UFXSystemComponent* USlashFeedbackSubsystem::AcquireEffect(EFeedbackType Type)
+{
+	UClass* ComponentClass = Type == EFeedbackType::Particles ? UParticleSystemComponent::StaticClass() : UNiagaraComponent::StaticClass();
+	for (int32 Index = FreeEffects.Num() - 1; Index >= 0; --Index)
+	{
+		if (FreeEffects[Index]->IsA(ComponentClass))
+		{
+			UFXSystemComponent* Effect = FreeEffects[Index];
+			FreeEffects.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			return Effect;
+		}
+	}
+
+	UFXSystemComponent* Effect = NewObject<UFXSystemComponent>(GetWorld()->GetWorldSettings(), ComponentClass);
+	Effect->bAutoActivate = false;
+	Effect->SetUsingAbsoluteLocation(true);
+	if (UParticleSystemComponent* Particles = Cast<UParticleSystemComponent>(Effect))
+	{
+		Particles->bAutoDestroy = false;
+	}
+	else
+	{
+		CastChecked<UNiagaraComponent>(Effect)->SetAutoDestroy(false);
+	}
+	Effect->RegisterComponentWithWorld(GetWorld());
+
+	++NumComponentsCreated;
+	INC_DWORD_STAT(STAT_FeedbackComponents);
+	return Effect;
+}
@@ -0,0 +1,246 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "World/SlashSaveSubsystem.h"
+
+#include "Async/Async.h"
+#include "Characters/SlashCharacter.h"
+#include "HAL/FileManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Slash/Slash.h"
+#include "World/SlashWorldStateSubsystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Save Snapshot"), STAT_SaveSnapshot, STATGROUP_Slash);
+DECLARE_CYCLE_STAT(TEXT("Save Apply"), STAT_SaveApply, STATGROUP_Slash);
+
+namespace SlashSave
+{
+	static constexpr uint32 Magic = 0x48534C53; // "SLSH"
+
+	/** Far above any real save; a corrupt or hostile header must not size the payload buffer */
+	static constexpr int32 MaxPayloadSize = 64 * 1024 * 1024;
+
+	static double ElapsedMs(double StartTime)
+	{
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+
+	static FString GetSlotArg(const TArray<FString>& Args)
+	{
+		return Args.Num() > 0 ? Args[0] : FString(TEXT("Slot0"));
+	}
+
+	static void Save(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World && World->GetGameInstance())
+		{
+			World->GetGameInstance()->GetSubsystem<USlashSaveSubsystem>()->SaveGame(GetSlotArg(Args));
+		}
+	}
+
+	static void Load(const TArray<FString>& Args, UWorld* World)
+	{
+		if (World && World->GetGameInstance())
+		{
+			World->GetGameInstance()->GetSubsystem<USlashSaveSubsystem>()->LoadGame(GetSlotArg(Args));
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashSaveCommand(
+	TEXT("Slash.Save"),
+	TEXT("Slash.Save [Slot] - saves the player and world state to Saved/SaveGames/<Slot>.sav"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashSave::Save));
+
+static FAutoConsoleCommandWithWorldAndArgs GSlashLoadCommand(
+	TEXT("Slash.Load"),
+	TEXT("Slash.Load [Slot] - loads the player and world state from Saved/SaveGames/<Slot>.sav"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&SlashSave::Load));
+
+void USlashSaveSubsystem::Deinitialize()
+{
+	// Don't leave a half written slot behind on exit
+	FileTask.Wait();
+
+	Super::Deinitialize();
+}
+
+void USlashSaveSubsystem::SaveGame(const FString& Slot)
+{
+	const double  SnapshotStart = FPlatformTime::Seconds();
+	TArray<uint8> Payload;
+	if (!BuildSnapshot(Payload))
+	{
+		OnSaveFinished.Broadcast(Slot, false);
+		return;
+	}
+	const double SnapshotMs = SlashSave::ElapsedMs(SnapshotStart);
+
+	TWeakObjectPtr<USlashSaveSubsystem> WeakThis(this);
+	FileTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Slot, Payload = MoveTemp(Payload), SnapshotMs]()
+	{
+		const double  CompressStart = FPlatformTime::Seconds();
+		TArray<uint8> FileData;
+		bool          bSuccess = CompressPayload(Payload, FileData);
+		const double  CompressMs = SlashSave::ElapsedMs(CompressStart);
+
+		// 임시 파일에 쓴 뒤 교체해서 쓰는 도중 종료되어도 기존 세이브가 깨지지 않도록 함
+		const double  WriteStart = FPlatformTime::Seconds();
+		const FString Path = GetSlotPath(Slot);
+		const FString TempPath = Path + TEXT(".tmp");
+		bSuccess = bSuccess && FFileHelper::SaveArrayToFile(FileData, *TempPath) && IFileManager::Get().Move(*Path, *TempPath);
+		const double WriteMs = SlashSave::ElapsedMs(WriteStart);
+
+		UE_LOG(LogSlash, Log, TEXT("Save '%s' %s - snapshot %.3f ms, compress %.3f ms, write %.3f ms, %d -> %d bytes"),
+		       *Slot, bSuccess ? TEXT("succeeded") : TEXT("failed"), SnapshotMs, CompressMs, WriteMs, Payload.Num(), FileData.Num());
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Slot, bSuccess]()
+		{
+			if (USlashSaveSubsystem* This = WeakThis.Get())
+			{
+				This->OnSaveFinished.Broadcast(Slot, bSuccess);
+			}
+		});
+	}, UE::Tasks::Prerequisites(FileTask));
+}
+
+void USlashSaveSubsystem::LoadGame(const FString& Slot)
+{
+	TWeakObjectPtr<USlashSaveSubsystem> WeakThis(this);
+	FileTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [WeakThis, Slot]()
+	{
+		const double  ReadStart = FPlatformTime::Seconds();
+		TArray<uint8> FileData;
+		TArray<uint8> Payload;
+		int32         Version = 0;
+		const bool    bRead = FFileHelper::LoadFileToArray(FileData, *GetSlotPath(Slot), FILEREAD_Silent) && DecompressPayload(FileData, Payload, Version);
+		const double  ReadMs = SlashSave::ElapsedMs(ReadStart);
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Slot, bRead, Payload = MoveTemp(Payload), Version, ReadMs]()
+		{
+			USlashSaveSubsystem* This = WeakThis.Get();
+			if (This == nullptr)
+				return;
+
+			const double ApplyStart = FPlatformTime::Seconds();
+			const bool   bSuccess = bRead && This->ApplySnapshot(Payload, Version);
+			UE_LOG(LogSlash, Log, TEXT("Load '%s' %s - read and decompress %.3f ms, apply %.3f ms"),
+			       *Slot, bSuccess ? TEXT("succeeded") : TEXT("failed"), ReadMs, SlashSave::ElapsedMs(ApplyStart));
+
+			This->OnLoadFinished.Broadcast(Slot, bSuccess);
+		});
+	}, UE::Tasks::Prerequisites(FileTask));
+}
+
+bool USlashSaveSubsystem::BuildSnapshot(TArray<uint8>& OutPayload) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_SaveSnapshot);
+
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (World == nullptr)
+		return false;
+
+	// Each block is length prefixed so a load can skip what it can't apply (e.g. no player pawn yet)
+	TArray<uint8> PlayerBlock;
+	if (ASlashCharacter* Character = Cast<ASlashCharacter>(UGameplayStatics::GetPlayerPawn(World, 0)))
+	{
+		FMemoryWriter PlayerWriter(PlayerBlock);
+		Character->SerializeSaveData(PlayerWriter);
+	}
+
+	TArray<uint8> WorldBlock;
+	if (USlashWorldStateSubsystem* WorldState = World->GetSubsystem<USlashWorldStateSubsystem>())
+	{
+		FMemoryWriter WorldWriter(WorldBlock);
+		WorldState->SerializeWorldState(WorldWriter);
+	}
+
+	OutPayload.Reset(PlayerBlock.Num() + WorldBlock.Num() + 2 * sizeof(int32));
+	FMemoryWriter Writer(OutPayload);
+	Writer << PlayerBlock;
+	Writer << WorldBlock;
+	return !Writer.IsError();
+}
+
+bool USlashSaveSubsystem::ApplySnapshot(const TArray<uint8>& Payload, int32 Version) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_SaveApply);
+
+	UWorld* World = GetGameInstance()->GetWorld();
+	if (World == nullptr || Version < ESlashSaveVersion::Initial || Version > ESlashSaveVersion::Latest)
+		return false;
+
+	TArray<uint8> PlayerBlock;
+	TArray<uint8> WorldBlock;
+	FMemoryReader Reader(Payload);
+	Reader << PlayerBlock;
+	Reader << WorldBlock;
+	if (Reader.IsError())
+		return false;
+
+	bool bSuccess = true;
+	if (ASlashCharacter* Character = Cast<ASlashCharacter>(UGameplayStatics::GetPlayerPawn(World, 0)); Character && PlayerBlock.Num() > 0)
+	{
+		FMemoryReader PlayerReader(PlayerBlock);
+		Character->SerializeSaveData(PlayerReader);
+		bSuccess &= !PlayerReader.IsError();
+	}
+
+	if (USlashWorldStateSubsystem* WorldState = World->GetSubsystem<USlashWorldStateSubsystem>(); WorldState && WorldBlock.Num() > 0)
+	{
+		FMemoryReader WorldReader(WorldBlock);
+		WorldState->SerializeWorldState(WorldReader);
+		WorldState->PurgeConsumedActors();
+		bSuccess &= !WorldReader.IsError();
+	}
+
+	return bSuccess;
+}
+
+bool USlashSaveSubsystem::CompressPayload(const TArray<uint8>& Payload, TArray<uint8>& OutFileData)
+{
+	uint32 Magic = SlashSave::Magic;
+	int32  Version = ESlashSaveVersion::Latest;
+	int32  UncompressedSize = Payload.Num();
+
+	OutFileData.Reset();
+	FMemoryWriter Writer(OutFileData);
+	Writer << Magic;
+	Writer << Version;
+	Writer << UncompressedSize;
+
+	const int32 HeaderSize = OutFileData.Num();
+	int32       CompressedSize = FCompression::CompressMemoryBound(NAME_Oodle, UncompressedSize);
+	OutFileData.AddUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Oodle, OutFileData.GetData() + HeaderSize, CompressedSize, Payload.GetData(), UncompressedSize))
+		return false;
+
+	OutFileData.SetNum(HeaderSize + CompressedSize);
+	return true;
+}
+
+bool USlashSaveSubsystem::DecompressPayload(const TArray<uint8>& FileData, TArray<uint8>& OutPayload, int32& OutVersion)
+{
+	uint32 Magic = 0;
+	int32  UncompressedSize = 0;
+
+	FMemoryReader Reader(FileData);
+	Reader << Magic;
+	Reader << OutVersion;
+	Reader << UncompressedSize;
+	if (Reader.IsError() || Magic != SlashSave::Magic || UncompressedSize < 0 || UncompressedSize > SlashSave::MaxPayloadSize)
+		return false;
+
+	const int64 HeaderSize = Reader.Tell();
+	OutPayload.SetNumUninitialized(UncompressedSize);
+	return FCompression::UncompressMemory(NAME_Oodle, OutPayload.GetData(), UncompressedSize, FileData.GetData() + HeaderSize, FileData.Num() - HeaderSize);
+}
+
+FString USlashSaveSubsystem::GetSlotPath(const FString& Slot)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / Slot + TEXT(".sav");
+}
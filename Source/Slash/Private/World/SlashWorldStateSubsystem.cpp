@@ -0,0 +1,200 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "World/SlashWorldStateSubsystem.h"
+
+#include "EngineUtils.h"
+#include "Breakable/BreakableActor.h"
+#include "Components/ActorComponent.h"
+#include "Items/Item.h"
+#include "Slash/Slash.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("World State Actors Loaded"), STAT_WorldStateActorsLoaded, STATGROUP_Slash);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("World State Actors Skipped"), STAT_WorldStateActorsSkipped, STATGROUP_Slash);
+
+bool USlashWorldStateSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+bool USlashWorldStateSubsystem::ShouldSkipOnLoad(AActor* Actor)
+{
+	if (!IsTrackedActor(Actor))
+		return false;
+
+	const bool bConsumed = IsConsumed(Actor);
+	if (bConsumed)
+	{
+		// No render or physics state for an actor that is destroyed right after it initializes
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			Component->bAutoRegister = false;
+		}
+
+		++NumActorsSkipped;
+		INC_DWORD_STAT(STAT_WorldStateActorsSkipped);
+	}
+	else
+	{
+		++NumActorsLoaded;
+		INC_DWORD_STAT(STAT_WorldStateActorsLoaded);
+	}
+	return bConsumed;
+}
+
+void USlashWorldStateSubsystem::MarkConsumed(const AActor* Actor)
+{
+	FSlashWorldStateCell* Cell = nullptr;
+	const int32 Index = GetActorIndex(Actor, Cell);
+	if (Index != INDEX_NONE)
+	{
+		Cell->Consumed[Index] = true;
+	}
+}
+
+bool USlashWorldStateSubsystem::IsConsumed(const AActor* Actor)
+{
+	FSlashWorldStateCell* Cell = nullptr;
+	const int32 Index = GetActorIndex(Actor, Cell);
+	return Index != INDEX_NONE && Cell->Consumed[Index];
+}
+
+void USlashWorldStateSubsystem::SerializeWorldState(FArchive& Ar)
+{
+	int32 NumCells = Cells.Num();
+	Ar << NumCells;
+
+	if (Ar.IsSaving())
+	{
+		for (TPair<FName, FSlashWorldStateCell>& Pair : Cells)
+		{
+			FString CellName = Pair.Key.ToString();
+			Ar << CellName;
+			Ar << Pair.Value.Consumed;
+		}
+	}
+	else
+	{
+		// Only the bits are restored; actor indices already built for loaded cells stay valid
+		for (TPair<FName, FSlashWorldStateCell>& Pair : Cells)
+		{
+			Pair.Value.Consumed.Init(false, Pair.Value.IndexByActorName.Num());
+		}
+
+		for (int32 Index = 0; Index < NumCells && !Ar.IsError(); ++Index)
+		{
+			FString     CellName;
+			TBitArray<> Consumed;
+			Ar << CellName;
+			Ar << Consumed;
+
+			FSlashWorldStateCell& Cell = Cells.FindOrAdd(FName(*CellName));
+			const int32 NumBits = FMath::Max(Consumed.Num(), Cell.IndexByActorName.Num());
+			Cell.Consumed = MoveTemp(Consumed);
+			if (Cell.Consumed.Num() < NumBits)
+			{
+				Cell.Consumed.Add(false, NumBits - Cell.Consumed.Num());
+			}
+		}
+	}
+}
+
+void USlashWorldStateSubsystem::PurgeConsumedActors()
+{
+	TArray<AActor*> ToDestroy;
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		if (IsTrackedActor(*It) && IsConsumed(*It))
+		{
+			ToDestroy.Add(*It);
+		}
+	}
+
+	for (AActor* Actor : ToDestroy)
+	{
+		Actor->Destroy();
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+void USlashWorldStateSubsystem::SetBenchmarkCells(int32 NumCells, int32 ActorsPerCell)
+{
+	for (auto It = Cells.CreateIterator(); It; ++It)
+	{
+		if (It.Key().ToString().StartsWith(TEXT("Bench_")))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	FRandomStream Random(NumCells);
+	for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+	{
+		FSlashWorldStateCell& Cell = Cells.Add(FName(*FString::Printf(TEXT("Bench_%d"), CellIndex)));
+		Cell.Consumed.Init(false, ActorsPerCell);
+		for (int32 Index = 0; Index < ActorsPerCell; ++Index)
+		{
+			Cell.Consumed[Index] = Random.FRand() < 0.3f;
+		}
+	}
+}
+#endif
+
+bool USlashWorldStateSubsystem::IsTrackedActor(const AActor* Actor)
+{
+	// Only actors placed in a level get a stable index; runtime spawned pickups are not persisted
+	return Actor && Actor->HasAnyFlags(RF_WasLoaded) && (Actor->IsA<ABreakableActor>() || Actor->IsA<AItem>());
+}
+
+FSlashWorldStateCell* USlashWorldStateSubsystem::FindOrBuildCell(const AActor* Actor)
+{
+	const ULevel* Level = Actor->GetLevel();
+	if (Level == nullptr)
+		return nullptr;
+
+	FSlashWorldStateCell& Cell = Cells.FindOrAdd(GetCellName(Level));
+	if (Cell.bIndexed)
+		return &Cell;
+	Cell.bIndexed = true;
+
+	TArray<FName> ActorNames;
+	for (const AActor* LevelActor : Level->Actors)
+	{
+		if (IsTrackedActor(LevelActor))
+		{
+			ActorNames.Add(LevelActor->GetFName());
+		}
+	}
+	ActorNames.Sort(FNameLexicalLess());
+
+	for (int32 Index = 0; Index < ActorNames.Num(); ++Index)
+	{
+		Cell.IndexByActorName.Add(ActorNames[Index], Index);
+	}
+
+	// Bits may already exist from a save game; keep them and only grow
+	if (Cell.Consumed.Num() < ActorNames.Num())
+	{
+		Cell.Consumed.Add(false, ActorNames.Num() - Cell.Consumed.Num());
+	}
+	return &Cell;
+}
+
+int32 USlashWorldStateSubsystem::GetActorIndex(const AActor* Actor, FSlashWorldStateCell*& OutCell)
+{
+	if (!IsTrackedActor(Actor))
+		return INDEX_NONE;
+
+	OutCell = FindOrBuildCell(Actor);
+	if (OutCell == nullptr)
+		return INDEX_NONE;
+
+	const int32* Index = OutCell->IndexByActorName.Find(Actor->GetFName());
+	return Index ? *Index : INDEX_NONE;
+}
+
+FName USlashWorldStateSubsystem::GetCellName(const ULevel* Level)
+{
+	// Strip the PIE prefix so cell names match between PIE sessions and saves
+	return FName(*UWorld::RemovePIEPrefix(Level->GetPackage()->GetName()));
+}
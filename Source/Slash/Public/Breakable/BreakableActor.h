@@ -4,9 +4,15 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Breakable/BreakableStandInSubsystem.h"
 #include "Interfaces/HitInterface.h"
 #include "BreakableActor.generated.h"
 
+class AFracturedBreakable;
+class UCapsuleComponent;
+class UGeometryCollection;
+class UGeometryCollectionComponent;
+
 UCLASS()
 class SLASH_API ABreakableActor : public AActor, public IHitInterface
 {
@@ -17,24 +23,69 @@ public:
 	ABreakableActor();
 
 protected:
+	virtual void PostLoad() override;
+	virtual void OnConstruction(const FTransform& Transform) override;
 	// Called when the game starts or when spawned
+	virtual void PreRegisterAllComponents() override;
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	/** Query-only collider standing in for the geometry collection until the breakable is hit */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-	UGeometryCollectionComponent* GeometryCollection;
+	UCapsuleComponent* Capsule;
+
+	/** Size of Capsule, set per breakable blueprint to fit its mesh */
+	UPROPERTY(EditDefaultsOnly, Category = "Breakable Properties")
+	float CapsuleRadius = 30.f;
 
-	// UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-	// class UCapsuleComponent* Capsule;
+	UPROPERTY(EditDefaultsOnly, Category = "Breakable Properties")
+	float CapsuleHalfHeight = 40.f;
 
 public:	
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
 	virtual void GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Puts a broken breakable back into its unbroken state (checkpoint restore). */
+	void ResetBreakable();
+
+	FORCEINLINE bool IsBroken() const { return bBroken; }
 
 private:
+	void ShowUnbroken();
+	void ShowBroken();
+
+	UFUNCTION()
+	void OnRep_Broken();
+
+	UPROPERTY(EditAnywhere, Category = "Breakable Properties")
+	TArray<TSoftClassPtr<class ATreasure>> TreasureClasses;
+
+	/** Drawn through a shared instanced static mesh while unbroken */
+	UPROPERTY(EditAnywhere, Category = "Breakable Properties")
+	UStaticMesh* StandInMesh;
+
+	/** Spawned (from a pool) when the breakable is hit */
 	UPROPERTY(EditAnywhere, Category = "Breakable Properties")
-	TArray<TSubclassOf<class ATreasure>> TreasureClasses;
+	UGeometryCollection* GeometryCollectionAsset;
+
+#if WITH_EDITORONLY_DATA
+	/** Root component of breakables saved before the stand-in, its rest collection moves to GeometryCollectionAsset */
+	UPROPERTY()
+	UGeometryCollectionComponent* GeometryCollection_DEPRECATED;
+#endif
 
+	FBreakableStandInHandle StandInHandle;
+
+	UPROPERTY()
+	AFracturedBreakable* FracturedActor;
+
+	/** Breakables stay dormant until this changes */
+	UPROPERTY(ReplicatedUsing=OnRep_Broken)
 	bool bBroken = false;
+
+	bool bSkippedOnLoad = false;
 };
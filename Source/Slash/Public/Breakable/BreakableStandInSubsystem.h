@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BreakableStandInSubsystem.generated.h"
+
+class AFracturedBreakable;
+class UGeometryCollection;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
+
+/** Slot of a breakable in the shared instanced static mesh of its stand-in mesh. */
+struct FBreakableStandInHandle
+{
+	TWeakObjectPtr<UInstancedStaticMeshComponent> Component;
+	int32                                         InstanceIndex = INDEX_NONE;
+
+	bool IsValid() const { return Component.IsValid() && InstanceIndex != INDEX_NONE; }
+};
+
+/**
+ * Renders unbroken breakables as instances of one UInstancedStaticMeshComponent per stand-in mesh,
+ * and hands out pooled AFracturedBreakable actors when a breakable is hit.
+ */
+UCLASS()
+class SLASH_API UBreakableStandInSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	FBreakableStandInHandle AddStandIn(UStaticMesh* Mesh, const FTransform& Transform);
+	void                    RemoveStandIn(FBreakableStandInHandle& Handle);
+
+	AFracturedBreakable* AcquireFracturedActor(const UGeometryCollection* Collection, const FTransform& Transform);
+	void                 ReleaseFracturedActor(AFracturedBreakable* FracturedActor);
+
+private:
+	UInstancedStaticMeshComponent* GetOrCreateStandInComponent(UStaticMesh* Mesh);
+
+	/** Transient actor owning the instanced stand-in components */
+	UPROPERTY(Transient)
+	AActor* StandInHost;
+
+	UPROPERTY(Transient)
+	TMap<UStaticMesh*, UInstancedStaticMeshComponent*> StandInComponents;
+
+	/** Removed instances are collapsed to zero scale and reused, so instance indices stay stable */
+	TMap<TWeakObjectPtr<UInstancedStaticMeshComponent>, TArray<int32>> FreeInstances;
+
+	UPROPERTY(Transient)
+	TArray<AFracturedBreakable*> FracturedPool;
+
+	int32 NumStandIns = 0;
+	int32 NumActiveFractured = 0;
+};
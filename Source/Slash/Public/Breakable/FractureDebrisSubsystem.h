@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Chaos/ChaosGameplayEventDispatcher.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FractureDebrisSubsystem.generated.h"
+
+class AFracturedBreakable;
+class UGeometryCollectionComponent;
+class UPhysicalMaterial;
+
+/**
+ * Bounds the Chaos cost of broken breakables: counts the rigid pieces released by every fractured
+ * actor, makes them sleep early, and returns fractured actors to the pool once every piece sleeps and
+ * they are out of view, or when the global piece budget is exceeded (oldest first). Tuned by Slash.Debris.* cvars.
+ */
+UCLASS()
+class SLASH_API UFractureDebrisSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	/** Applies the debris material and removal settings; the physics proxy only reads them when the component registers. */
+	void ConfigureFracture(UGeometryCollectionComponent* GeometryCollection);
+
+	/** Takes ownership of a fractured actor that was just activated for a hit breakable. */
+	void TrackFracture(AFracturedBreakable* FracturedActor);
+
+	/** Returns every tracked fractured actor to the pool at once, e.g. when a checkpoint is restored. */
+	void ReleaseAll();
+
+	FORCEINLINE int32 GetNumActivePieces() const { return NumActivePieces; }
+	FORCEINLINE int32 GetNumTrackedFractures() const { return Fractures.Num(); }
+
+private:
+	struct FTrackedFracture
+	{
+		TWeakObjectPtr<AFracturedBreakable> Actor;
+		double                              StartTime = 0.0;
+		int32                               NumPieces = 0;
+	};
+
+	UFUNCTION()
+	void OnPiecesBroken(const FChaosBreakEvent& BreakEvent);
+
+	UFUNCTION()
+	void OnPiecesRemoved(const FChaosRemovalEvent& RemovalEvent);
+
+	FTrackedFracture*  FindFracture(const UPrimitiveComponent* Component);
+	void               ReleaseFracture(int32 Index);
+	void               UpdateFractures();
+	UPhysicalMaterial* GetDebrisMaterial();
+
+	/** True once no piece of the collection is simulating, i.e. every piece sleeps or was removed */
+	static bool IsAtRest(const UGeometryCollectionComponent* GeometryCollection);
+
+	/** Oldest first */
+	TArray<FTrackedFracture> Fractures;
+
+	/**
+	 * Physical material override with high sleep thresholds, so settled pieces leave the solver quickly. Owned by this
+	 * subsystem and never edited once in use: changed thresholds get a new material, fractures keep the one they had.
+	 */
+	UPROPERTY(Transient)
+	UPhysicalMaterial* DebrisMaterial;
+
+	int32 NumActivePieces = 0;
+	float TimeSinceUpdate = 0.f;
+};
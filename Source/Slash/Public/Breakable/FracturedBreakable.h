@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "FracturedBreakable.generated.h"
+
+class UGeometryCollection;
+class UGeometryCollectionComponent;
+
+/**
+ * Pooled geometry collection actor that replaces a breakable's stand-in instance once it is hit.
+ * While pooled the component is unregistered, so it holds no physics proxy.
+ */
+UCLASS(NotBlueprintable)
+class SLASH_API AFracturedBreakable : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AFracturedBreakable();
+
+	void Activate(const UGeometryCollection* Collection, const FTransform& Transform);
+	void Deactivate();
+
+protected:
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	UGeometryCollectionComponent* GeometryCollection;
+
+public:
+	FORCEINLINE UGeometryCollectionComponent* GetGeometryCollection() const { return GeometryCollection; }
+};
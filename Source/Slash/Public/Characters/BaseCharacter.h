@@ -17,11 +17,20 @@ class SLASH_API ABaseCharacter : public ACharacter, public IHitInterface
 	GENERATED_BODY()
 
 public:
-	ABaseCharacter();
+	ABaseCharacter(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 	virtual void Tick(float DeltaTime) override;
 
+	/** Undoes Die(): clears the dead tag, stops montages and restores the default collision. */
+	virtual void Revive();
+
+	/** Damage from status effects: no hit reaction, but it still kills */
+	void ApplyEffectDamage(float DamageAmount);
+
+	FORCEINLINE UAttributeComponent* GetAttributes() const { return Attributes; }
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Combat
 	virtual void GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter) override;
@@ -40,9 +49,11 @@ protected:
 	void         DisableMeshCollision();
 
 	// Montages
-	void          PlayHitReactMontage(const FName& SectionName);
+	virtual void  PlayHitReactMontage(const FName& SectionName);
 	virtual int32 PlayAttackMontage();
+	void          PlayAttackMontageSection(int32 Selection);
 	virtual int32 PlayDeathMontage();
+	void          PlayDeathMontageSection(int32 Selection);
 	virtual void  PlayDodgeMontage();
 	void          StopAttackMontage();
 
@@ -79,26 +90,26 @@ private:
 	int32 PlayRandomMontageSection(UAnimMontage* Montage, const TArray<FName>& SectionNames);
 
 	UPROPERTY(EditAnywhere, Category = Combat)
-	USoundBase* HitSound;
+	TSoftObjectPtr<USoundBase> HitSound;
 
 	UPROPERTY(EditAnywhere, Category = Combat)
-	UParticleSystem* HitParticles;
+	TSoftObjectPtr<UParticleSystem> HitParticles;
 
 protected:
 	/**
-	* Animation montages
+	* Animation montages, streamed by USlashAssetPreloadSubsystem
 	*/
 	UPROPERTY(EditDefaultsOnly, Category = Combat)
-	UAnimMontage* AttackMontage;
+	TSoftObjectPtr<UAnimMontage> AttackMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = Combat)
-	UAnimMontage* HitReactMontage;
+	TSoftObjectPtr<UAnimMontage> HitReactMontage;
 
 	UPROPERTY(EditDefaultsOnly, Category = Combat)
-	UAnimMontage* DeathMontage;
+	TSoftObjectPtr<UAnimMontage> DeathMontage;
 
 	UPROPERTY(EditAnywhere, Category = Combat)
-	UAnimMontage* DodgeMontage;
+	TSoftObjectPtr<UAnimMontage> DodgeMontage;
 
 	UPROPERTY(EditAnywhere, Category= Combat)
 	TArray<FName> AttackMontageSections;
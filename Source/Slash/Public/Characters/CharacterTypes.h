@@ -20,6 +20,24 @@ enum class EActionState : uint8
 
 };
 
+/** Owner input that plays locally at once and is confirmed or rolled back by the server */
+UENUM()
+enum class EPredictedAction : uint8
+{
+	EPA_Attack,
+	EPA_Dodge,
+	EPA_Interact
+};
+
+/** Enemy montages the server picks and multicasts, clients run no AI to pick them */
+UENUM()
+enum class EEnemyMontage : uint8
+{
+	EEM_Attack,
+	EEM_HitReact,
+	EEM_Death
+};
+
 UENUM(BlueprintType)
 enum EDeathPose
 {
@@ -42,6 +60,7 @@ enum class EEnemyState : uint8
 	EES_Dead UMETA(DisplayName = "Dead"),
 	EES_Patrolling UMETA(DisplayName = "Patrolling"),
 	EES_Chasing UMETA(DisplayName = "Chasing"),
+	EES_Holding UMETA(DisplayName = "Holding"),
 	EES_Attacking UMETA(DisplayName = "Attacking"),
 	EES_Engaged UMETA(DisplayName = "Engaged"),
 
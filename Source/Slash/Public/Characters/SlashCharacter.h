@@ -12,6 +12,7 @@ class USlashOverlay;
 class AWeapon;
 class AItem;
 class UGroomComponent;
+class ULockOnComponent;
 class UCameraComponent;
 class USpringArmComponent;
 struct FInputActionValue;
@@ -35,8 +36,21 @@ public:
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 	virtual void  GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter) override;
 	virtual void  SetOverlappingItem(AItem* Item) override;
-	virtual void  AddSouls(ASoul* Soul) override;
-	virtual void  AddGold(ATreasure* Treasure) override;
+	virtual void  AddSouls(int32 NumberOfSouls) override;
+	virtual void  AddGold(int32 AmountOfGold) override;
+
+	virtual void  Revive() override;
+	virtual void  GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Sends a hit traced by this (remote) client's weapon to the server for lag compensated validation. */
+	void ClaimHit(AActor* HitActor, const FVector& TraceStart, const FVector& TraceEnd, const FVector& ImpactPoint);
+
+	/** Asks the server for a dropped pickup this client touched, see UPickupSubsystem. */
+	UFUNCTION(Server, Reliable)
+	void ServerCollectPickup(uint32 PickupId);
+
+	/** Attributes, equipped weapon and character state, in the save game layout. */
+	void SerializeSaveData(FArchive& Ar);
 
 protected:
 	// Called when the game starts or when spawned
@@ -64,17 +78,22 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Input")
 	UInputAction* DodgeAction;
 
+	UPROPERTY(EditAnywhere, Category="Input")
+	UInputAction* LockOnAction;
+
 	/**
 	*  Callbacks for input actions
 	*/
 	void         Move(const FInputActionValue& Value);
 	void         Look(const FInputActionValue& Value);
 	void         EKeyPressed();
+	void         Interact();
 	virtual void Attack() override;
 	void         Dodge();
+	void         ToggleLockOn();
 
 	// Combat
-	void         EquipWeapon(AWeapon* Weapon);
+	void         EquipWeapon(AWeapon* Weapon, bool bConsume = true);
 	virtual void AttackEnd() override;
 	virtual void DodgeEnd() override;
 	virtual bool CanAttack() override;
@@ -102,7 +121,60 @@ protected:
 private:
 	bool IsUnoccupied();
 	void InitializeSlashOverlay();
+	void RefreshSlashOverlay();
+	void OnAttributesChanged(uint32 ChangedMask);
+	void OnLockOnTargetChanged(AActor* NewTarget);
 	void SetHUDHealth();
+	void RestoreEquippedWeapon(const FSoftClassPath& WeaponClassPath, ECharacterState SavedCharacterState);
+	void RespawnAtCheckpoint();
+	void SetCharacterState(ECharacterState NewState);
+	void AttachWeaponForState();
+
+	/** Hides a weapon put aside by a predicted pickup and takes its modifiers off, or brings it back */
+	void SetWeaponSuspended(AWeapon* Weapon, bool bSuspended);
+
+	UFUNCTION(BlueprintSetter)
+	void SetActionState(EActionState NewState);
+
+	/**
+	*  Prediction: the owning client performs attack, dodge and E key actions at once and sends them to the
+	*  server with an id; the server replays them against its own state and acks, a rejected action is rolled back
+	*/
+	struct FPendingAction
+	{
+		uint16           Id = 0;
+		EPredictedAction Action = EPredictedAction::EPA_Attack;
+		float            StaminaCost = 0.f;
+		double           SentTime = 0.0;
+
+		/** Interact: the weapon held before and the pickup taken, restored if the server rejects it */
+		TWeakObjectPtr<AWeapon> PreviousWeapon;
+		TWeakObjectPtr<AWeapon> PickedUpWeapon;
+	};
+
+	/** What the E key does now, sent as the section of an interact multicast */
+	int8 GetInteractSection();
+
+	void ConfirmInteract(const FPendingAction& Acked);
+	void RollBackInteract(const FPendingAction& Acked);
+
+	void RunAction(EPredictedAction Action, int32 Section, float Yaw);
+	bool CanPerformAction(EPredictedAction Action);
+	void PerformAction(EPredictedAction Action, int32 Section, float Yaw);
+	void FinishEndingAction();
+	float GetPendingStaminaCost() const;
+
+	UFUNCTION(Server, Reliable)
+	void ServerRunAction(EPredictedAction Action, uint16 PredictionId, int8 Section, float Yaw);
+
+	UFUNCTION(Client, Reliable)
+	void ClientAckAction(uint16 PredictionId, bool bAccepted, EActionState ServerActionState, ECharacterState ServerCharacterState, float ServerStamina);
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastPlayAction(EPredictedAction Action, int8 Section);
+
+	UFUNCTION(Server, Reliable)
+	void ServerClaimHit(AActor* HitActor, FVector_NetQuantize TraceStart, FVector_NetQuantize TraceEnd, FVector_NetQuantize ImpactPoint, double ClientTime);
 
 	// Character Components
 	UPROPERTY(VisibleAnywhere)
@@ -117,21 +189,50 @@ private:
 	UPROPERTY(VisibleAnywhere, Category="Hair")
 	UGroomComponent* Eyebrows;
 
+	UPROPERTY(VisibleAnywhere)
+	ULockOnComponent* LockOn;
+
 	UPROPERTY(VisibleInstanceOnly)
 	AItem* OverlappingItem;
 
 	UPROPERTY(EditDefaultsOnly, Category = Montages)
-	UAnimMontage* EquipMontage;
+	TSoftObjectPtr<UAnimMontage> EquipMontage;
 
+	/** Seconds between death and the restore of the last checkpoint */
+	UPROPERTY(EditAnywhere, Category = Combat)
+	float RespawnDelay = 3.f;
+
+	FTimerHandle RespawnTimer;
+
+	TArray<FPendingAction> PendingActions;
+	uint16                 LastPredictionId = 0;
+
+	/** Replicated to everyone but the owner, which drives its own state from input */
+	UPROPERTY(Replicated)
 	ECharacterState CharacterState = ECharacterState::ECS_Unequipped;
 
-	UPROPERTY(BlueprintReadWrite, meta =(AllowPrivateAccess = "true"))
+	/** Weapons don't replicate, other machines spawn their own instance of this class */
+	UPROPERTY(ReplicatedUsing=OnRep_EquippedWeaponClass)
+	TSubclassOf<AWeapon> EquippedWeaponClass;
+
+	UFUNCTION()
+	void OnRep_EquippedWeaponClass();
+
+	void SetEquippedWeaponClass(TSubclassOf<AWeapon> NewClass);
+
+	UPROPERTY(Replicated, BlueprintReadWrite, BlueprintSetter=SetActionState, meta =(AllowPrivateAccess = "true"))
 	EActionState ActionState = EActionState::EAS_Unoccupied;
 
 	UPROPERTY()
 	USlashOverlay* SlashOverlay;
 
 public:
-	FORCEINLINE ECharacterState GetCharacterState() const { return CharacterState; }
-	FORCEINLINE EActionState    GetActionState() const { return ActionState; }
+	FORCEINLINE ECharacterState   GetCharacterState() const { return CharacterState; }
+	FORCEINLINE EActionState      GetActionState() const { return ActionState; }
+	FORCEINLINE UInputAction*     GetMoveAction() const { return MoveAction; }
+	FORCEINLINE UInputAction*     GetLookAction() const { return LookAction; }
+	FORCEINLINE UInputAction*     GetEKeyAction() const { return EKeyAction; }
+	FORCEINLINE UInputAction*     GetAttackAction() const { return AttackAction; }
+	FORCEINLINE UInputAction*     GetDodgeAction() const { return DodgeAction; }
+	FORCEINLINE ULockOnComponent* GetLockOn() const { return LockOn; }
 };
\ No newline at end of file
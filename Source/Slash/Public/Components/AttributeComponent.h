@@ -4,8 +4,51 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Components/SlashAttributeSet.h"
 #include "AttributeComponent.generated.h"
 
+DECLARE_MULTICAST_DELEGATE(FOnAttributesReplicated);
+
+/** ChangedMask holds FSlashAttributeSet::Bit() of every attribute changed since the last broadcast */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnAttributesChanged, uint32 /* ChangedMask */);
+
+/** Current attribute values as sent to clients: Health and Stamina quantized to 0.1, Gold and Souls packed. */
+USTRUCT()
+struct FReplicatedAttributes
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	float Health = 0.f;
+
+	UPROPERTY()
+	float Stamina = 0.f;
+
+	UPROPERTY()
+	int32 Gold = 0;
+
+	UPROPERTY()
+	int32 Souls = 0;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FReplicatedAttributes& Other) const
+	{
+		return Health == Other.Health && Stamina == Other.Stamina && Gold == Other.Gold && Souls == Other.Souls;
+	}
+
+	static float Quantize(float Value) { return FMath::RoundToFloat(Value * 10.f) / 10.f; }
+};
+
+template <>
+struct TStructOpsTypeTraits<FReplicatedAttributes> : TStructOpsTypeTraitsBase2<FReplicatedAttributes>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
 
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class SLASH_API UAttributeComponent : public UActorComponent
@@ -17,12 +60,39 @@ public:
 	UAttributeComponent();
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	void RegenStamina(float DeltaTime);
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	virtual void InitializeComponent() override;
+
+	/** Client side, after new values arrived from the server. */
+	FOnAttributesReplicated OnAttributesReplicated;
+
+	/** At most once per frame, with every attribute changed during it */
+	FOnAttributesChanged OnAttributesChanged;
 
 protected:
 	virtual void BeginPlay() override;
 
 private:
-	// Current Health
+	/** Server side: pushes the current values into ReplicatedAttributes, marking it dirty only if the quantized values changed */
+	void MarkAttributesDirty();
+
+	UFUNCTION()
+	void OnRep_ReplicatedAttributes();
+
+	/** Keeps Health and Stamina within their max after either changed, and queues the change broadcast */
+	void OnValuesChanged();
+	void BroadcastChanges();
+
+	UPROPERTY(ReplicatedUsing=OnRep_ReplicatedAttributes)
+	FReplicatedAttributes ReplicatedAttributes;
+
+	/** Live values; the properties below are only the starting base values */
+	FSlashAttributeSet AttributeSet;
+
+	bool bBroadcastPending = false;
+
+	// Starting Health
 	UPROPERTY(EditAnywhere, Category="Actor Attributes")
 	float Health;
 
@@ -46,6 +116,13 @@ private:
 
 	UPROPERTY(EditAnywhere, Category="Actor Attributes")
 	float StaminaRegenRate = 8.f;
+
+	/** Base value 1, scales the damage of equipped weapons */
+	UPROPERTY(EditAnywhere, Category="Actor Attributes")
+	float DamageScale = 1.f;
+
+	/** Owning client: stamina spent by actions the server has not confirmed yet, kept off replicated values */
+	float PredictedStaminaCost = 0.f;
 	
 public:
 	void              ReceiveDamage(float Damage);
@@ -55,8 +132,14 @@ public:
 	bool              IsAlive();
 	void              AddSouls(int32 NumberOfSouls);
 	void              AddGold(int32 AmountOfGold);
-	FORCEINLINE int32 GetGold() const { return Gold; }
-	FORCEINLINE int32 GetSouls() const { return Souls; }
-	FORCEINLINE float GetDodgeCost() const { return DodgeCost; }
-	FORCEINLINE float GetStamina() const { return Stamina; }
+	void              SerializeSaveData(FArchive& Ar);
+	void              SetPredictedStaminaCost(float Cost);
+	void              ReconcileStamina(float ServerStamina);
+	void              AddModifiers(TConstArrayView<FSlashAttributeModifierSpec> Modifiers, const UObject* Source);
+	void              RemoveModifiers(const UObject* Source);
+	FORCEINLINE float GetValue(ESlashAttribute Attribute) const { return AttributeSet.Get(Attribute); }
+	FORCEINLINE int32 GetGold() const { return FMath::RoundToInt(AttributeSet.Get(ESlashAttribute::ESA_Gold)); }
+	FORCEINLINE int32 GetSouls() const { return FMath::RoundToInt(AttributeSet.Get(ESlashAttribute::ESA_Souls)); }
+	FORCEINLINE float GetDodgeCost() const { return AttributeSet.Get(ESlashAttribute::ESA_DodgeCost); }
+	FORCEINLINE float GetStamina() const { return AttributeSet.Get(ESlashAttribute::ESA_Stamina); }
 };
\ No newline at end of file
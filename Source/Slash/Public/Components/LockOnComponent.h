@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "LockOnComponent.generated.h"
+
+class AEnemy;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLockOnTargetChanged, AActor* /*NewTarget*/);
+
+/**
+ * Lock-on for the player. Candidates come from UEnemySpatialIndexSubsystem, filtered to a view cone around the
+ * camera and scored by angle and distance. The scored list is cached and only rebuilt every
+ * Slash.LockOn.RefreshInterval; the locked target gets a Slash.LockOn.Stickiness bonus so it does not flip between
+ * two enemies with close scores. The owner uses the target as its CombatTarget, the motion warp target of attacks.
+ */
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class SLASH_API ULockOnComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	ULockOnComponent();
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Locks on to the best candidate, or releases the current target */
+	void ToggleLockOn();
+	void ClearTarget();
+
+	/** Rebuilds the cached candidates, best first; returns how many enemies the index tested */
+	int32 RefreshCandidates();
+
+	/** Higher is better, 0 outside the cone or range */
+	float ScoreCandidate(const FVector& ViewLocation, const FVector& ViewDirection, const FVector& TargetLocation) const;
+
+	/** Location of the owner, horizontal direction of its camera */
+	void GetViewPoint(FVector& OutLocation, FVector& OutDirection) const;
+
+	FORCEINLINE AActor*                GetTarget() const { return Target; }
+	FORCEINLINE const TArray<AEnemy*>& GetCandidates() const { return Candidates; }
+
+	FOnLockOnTargetChanged OnTargetChanged;
+
+private:
+	void SetTarget(AActor* NewTarget);
+	bool IsValidTarget(const AActor* Candidate) const;
+	void RotateViewTowardsTarget(float DeltaTime);
+
+	UFUNCTION(Server, Reliable)
+	void ServerSetTarget(AActor* NewTarget);
+
+	UPROPERTY(EditAnywhere, Category = "Lock On")
+	float MaxDistance = 1500.f;
+
+	UPROPERTY(EditAnywhere, Category = "Lock On")
+	float ConeHalfAngle = 60.f;
+
+	/** 0 scores by distance only, 1 by angle only */
+	UPROPERTY(EditAnywhere, Category = "Lock On", meta = (ClampMin = "0", ClampMax = "1"))
+	float AngleWeight = 0.6f;
+
+	/** Locked targets are dropped past MaxDistance times this, so walking around the edge does not drop them */
+	UPROPERTY(EditAnywhere, Category = "Lock On")
+	float BreakDistanceScale = 1.2f;
+
+	UPROPERTY(EditAnywhere, Category = "Lock On")
+	float CameraInterpSpeed = 8.f;
+
+	UPROPERTY()
+	AActor* Target;
+
+	UPROPERTY()
+	TArray<AEnemy*> Candidates;
+
+	/** Reused by every refresh */
+	TArray<AEnemy*>               Gathered;
+	TArray<TPair<float, AEnemy*>> Scored;
+
+	float TimeSinceRefresh = 0.f;
+};
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "SlashAttributeSet.generated.h"
+
+UENUM(BlueprintType)
+enum class ESlashAttribute : uint8
+{
+	ESA_Health UMETA(DisplayName = "Health"),
+	ESA_MaxHealth UMETA(DisplayName = "Max Health"),
+	ESA_Stamina UMETA(DisplayName = "Stamina"),
+	ESA_MaxStamina UMETA(DisplayName = "Max Stamina"),
+	ESA_StaminaRegenRate UMETA(DisplayName = "Stamina Regen Rate"),
+	ESA_DodgeCost UMETA(DisplayName = "Dodge Cost"),
+	ESA_DamageScale UMETA(DisplayName = "Damage Scale"),
+	ESA_Gold UMETA(DisplayName = "Gold"),
+	ESA_Souls UMETA(DisplayName = "Souls"),
+
+	ESA_MAX UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class EAttributeModifierOp : uint8
+{
+	EAMO_Add UMETA(DisplayName = "Add"),
+	EAMO_Multiply UMETA(DisplayName = "Multiply")
+};
+
+/** A modifier as authored on weapons and effects */
+USTRUCT(BlueprintType)
+struct FSlashAttributeModifierSpec
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	ESlashAttribute Attribute = ESlashAttribute::ESA_MaxHealth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EAttributeModifierOp Op = EAttributeModifierOp::EAMO_Add;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Magnitude = 0.f;
+};
+
+/**
+ * Attribute values in a flat array indexed by ESlashAttribute. Final value = (Base + sum of Add) * product of Multiply.
+ * Final values are cached and only recomputed after a base value or a modifier of that attribute changed, so a read
+ * is a bit test and an array lookup. Changed attributes accumulate in a mask until ConsumeChanges, for batched events.
+ */
+struct SLASH_API FSlashAttributeSet
+{
+	static constexpr int32 Num = static_cast<int32>(ESlashAttribute::ESA_MAX);
+	static_assert(Num <= 32, "Dirty and changed masks are 32 bits");
+
+	static FORCEINLINE uint32 Bit(ESlashAttribute Attribute) { return 1u << static_cast<uint32>(Attribute); }
+
+	FORCEINLINE float Get(ESlashAttribute Attribute) const
+	{
+		const int32 Index = static_cast<int32>(Attribute);
+		if (DirtyMask & (1u << Index))
+		{
+			Recompute(Index);
+		}
+		return Final[Index];
+	}
+
+	FORCEINLINE float GetBase(ESlashAttribute Attribute) const { return Base[static_cast<int32>(Attribute)]; }
+
+	void SetBase(ESlashAttribute Attribute, float Value);
+
+	void AddModifier(ESlashAttribute Attribute, EAttributeModifierOp Op, float Magnitude, const UObject* Source);
+	void AddModifiers(TConstArrayView<FSlashAttributeModifierSpec> Specs, const UObject* Source);
+
+	/** Removes every modifier Source added, returns how many */
+	int32 RemoveModifiers(const UObject* Source);
+
+	FORCEINLINE int32 GetNumModifiers() const { return Modifiers.Num(); }
+
+	/** Attributes whose final value may have changed since the last call, as Bit() flags */
+	uint32 ConsumeChanges();
+
+	FORCEINLINE bool HasChanges() const { return ChangedMask != 0; }
+
+private:
+	struct FModifier
+	{
+		FObjectKey           Source;
+		float                Magnitude;
+		ESlashAttribute      Attribute;
+		EAttributeModifierOp Op;
+	};
+
+	void MarkDirty(uint32 Mask);
+	void Recompute(int32 Index) const;
+
+	float          Base[Num] = {};
+	mutable float  Final[Num] = {};
+	mutable uint32 DirtyMask = 0;
+	uint32         ChangedMask = 0;
+
+	TArray<FModifier> Modifiers;
+};
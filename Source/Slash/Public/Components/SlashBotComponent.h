@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "SlashBotComponent.generated.h"
+
+class ASlashCharacter;
+class UEnhancedInputLocalPlayerSubsystem;
+
+/**
+ * Headless load test client: plays a locally controlled ASlashCharacter by injecting its own input actions
+ * (move, look, attack, dodge, E key) in random bursts. Added at BeginPlay when the game runs with -SlashBot,
+ * -SlashBotSeed=N makes a run repeatable.
+ */
+UCLASS(ClassGroup=(Custom))
+class SLASH_API USlashBotComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	USlashBotComponent();
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	static bool IsBotClient();
+
+protected:
+	virtual void BeginPlay() override;
+
+private:
+	void                                PickNextAction();
+	UEnhancedInputLocalPlayerSubsystem* GetInputSubsystem() const;
+
+	UPROPERTY(EditAnywhere, Category = Bot)
+	float MinActionTime = 1.f;
+
+	UPROPERTY(EditAnywhere, Category = Bot)
+	float MaxActionTime = 4.f;
+
+	UPROPERTY(EditAnywhere, Category = Bot)
+	float AttackChance = 0.4f;
+
+	UPROPERTY(EditAnywhere, Category = Bot)
+	float DodgeChance = 0.15f;
+
+	UPROPERTY(EditAnywhere, Category = Bot)
+	float InteractChance = 0.1f;
+
+	UPROPERTY()
+	ASlashCharacter* Character;
+
+	FRandomStream Stream;
+	FVector2D     MoveInput = FVector2D::ZeroVector;
+	FVector2D     LookInput = FVector2D::ZeroVector;
+	float         ActionTimeLeft = 0.f;
+};
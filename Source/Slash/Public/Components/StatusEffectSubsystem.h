@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StatusEffectSubsystem.generated.h"
+
+class ABaseCharacter;
+
+UENUM(BlueprintType)
+enum class EStatusEffectType : uint8
+{
+	ESE_Bleed UMETA(DisplayName = "Bleed"),
+	ESE_Poison UMETA(DisplayName = "Poison"),
+	ESE_StaminaDrain UMETA(DisplayName = "Stamina Drain"),
+
+	ESE_MAX UMETA(Hidden)
+};
+
+/** An effect as authored on weapons */
+USTRUCT(BlueprintType)
+struct FStatusEffectSpec
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	EStatusEffectType Type = EStatusEffectType::ESE_Bleed;
+
+	/** Health, or stamina for a drain, taken per second */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float AmountPerSecond = 5.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Duration = 4.f;
+};
+
+/**
+ * Bleed, poison and stamina drain on every character, without a timer or tick per effect. Active effects are kept in
+ * packed arrays per effect type and advanced together every Slash.StatusEffects.Interval in one pass over the rates
+ * and remaining times. The amounts are then summed per character, so a character takes one health and one stamina
+ * change per interval however many effects it has. Each application is a stack, up to Slash.StatusEffects.MaxStacks
+ * per character and type; past that the shortest stack is refreshed instead. Server only, health replicates as usual.
+ */
+UCLASS()
+class SLASH_API UStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	void ApplyEffect(ABaseCharacter* Target, const FStatusEffectSpec& Spec);
+	void ApplyEffects(ABaseCharacter* Target, TConstArrayView<FStatusEffectSpec> Specs);
+
+	/** Drops every effect on Target, e.g. when it dies or leaves the world */
+	void RemoveTarget(const ABaseCharacter* Target);
+
+	void RemoveAll();
+
+	/** Advances every effect by DeltaSeconds and applies the summed amounts; returns the number of characters changed */
+	int32 Advance(float DeltaSeconds);
+
+	int32 GetNumEffects() const;
+
+private:
+	/** Structure of arrays, one entry per stack */
+	struct FEffectList
+	{
+		TArray<ABaseCharacter*> Targets;
+		TArray<float>           Rates;
+		TArray<float>           Remaining;
+		TArray<float>           Amounts;
+
+		/** Stacks per character, so capping and removal skip characters without any */
+		TMap<const ABaseCharacter*, int32> NumStacks;
+
+		void RemoveAtSwap(int32 Index);
+	};
+
+	/** Health and stamina taken from one character in one pass */
+	struct FEffectTotals
+	{
+		float Health = 0.f;
+		float Stamina = 0.f;
+	};
+
+	FEffectList Lists[static_cast<int32>(EStatusEffectType::ESE_MAX)];
+
+	/** Reused by every pass */
+	TMap<ABaseCharacter*, FEffectTotals> Totals;
+
+	float TimeSinceAdvance = 0.f;
+};
@@ -5,11 +5,11 @@
 #include "CoreMinimal.h"
 #include "Characters/BaseCharacter.h"
 #include "Characters/CharacterTypes.h"
+#include "Enemy/EnemyNetMovement.h"
 #include "Enemy.generated.h"
 
 class ASoul;
 class UPawnSensingComponent;
-class UHealthBarComponent;
 
 UCLASS()
 class SLASH_API AEnemy : public ABaseCharacter
@@ -17,18 +17,40 @@ class SLASH_API AEnemy : public ABaseCharacter
 	GENERATED_BODY()
 
 public:
-	AEnemy();
+	AEnemy(const FObjectInitializer& ObjectInitializer);
 
 	/** <AActor> */
 	virtual void  Tick(float DeltaTime) override;
+	virtual void  GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
 	virtual void  Destroyed() override;
+	virtual void  EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void  PreReplication(IRepChangedPropertyTracker& ChangedPropertyTracker) override;
 	/** <AActor> */
 
 	/** <IHitInterface> */
 	virtual void GetHit_Implementation(const FVector& ImpactPoint, AActor* Hitter) override;
 	/** <IHitInterface> */
 
+	/** Brings the enemy back to life and patrolling, at its current transform and attributes. */
+	void RestoreFromCheckpoint();
+
+	/** Server: 0 near a player, 1 mid range, 2 far; scales the replication rate, see USlashEnemyNetSubsystem */
+	void SetNetTier(uint8 Tier);
+
+	/**
+	 * UEnemyActivationSubsystem: near a player the enemy registers pawn sensing (server) and spawns its weapon once it
+	 * aggroes; idle enemies away from every player drop both.
+	 */
+	void UpdateActivation(bool bPlayerNearby);
+	bool IsActivated() const { return bActivated; }
+
+	/**
+	 * Client: server time of the pose on screen, i.e. of the last NetMovement sample extrapolated like SmoothNetMovement
+	 * does, less the smoothing lag. Hit claims against this enemy rewind to it. The current server time without updates.
+	 */
+	double GetDisplayedServerTime() const;
+
 
 protected:
 	// <AActor>
@@ -40,6 +62,8 @@ protected:
 	virtual void  Attack() override;
 	virtual bool  CanAttack() override;
 	virtual void  HandleDamage(float DamageAmount) override;
+	virtual void  PlayHitReactMontage(const FName& SectionName) override;
+	virtual int32 PlayAttackMontage() override;
 	virtual int32 PlayDeathMontage() override;
 	virtual void  AttackEnd() override;
 	// </ABaseCharacter>
@@ -48,10 +72,13 @@ protected:
 	void SpawnSoul();
 
 
-	UPROPERTY(BlueprintReadOnly)
+	/** Marks EnemyState dirty for replication; always go through this instead of assigning */
+	void SetEnemyState(EEnemyState NewState);
+
+	UPROPERTY(BlueprintReadOnly, Replicated)
 	TEnumAsByte<EDeathPose> DeathPose;
 
-	UPROPERTY(BlueprintReadOnly, VisibleAnywhere)
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, ReplicatedUsing=OnRep_EnemyState)
 	EEnemyState EnemyState = EEnemyState::EES_Patrolling;
 
 
@@ -65,6 +92,7 @@ private:
 
 	void HideHealthBar();
 	void ShowHealthBar();
+	void UpdateHealthBar();
 	void LoseInterest();
 	void StartPatrolling();
 	void ChaseTarget();
@@ -73,31 +101,65 @@ private:
 	bool IsOutsideAttackRadius();
 	bool IsInsideAttackRadius();
 	bool IsChasing();
+	bool IsHolding();
 	bool IsAttacking();
 	bool IsDead();
 	bool IsEngaged();
 
+	void DeathTimerFinished();
 	void ClearPatrolTimer();
 	void StartAttackTimer();
 	void ClearAttackTimer();
 
+	/** Attack tokens, see UEnemyAttackDirectorSubsystem */
+	bool TryAcquireAttackToken();
+	void ReleaseAttackToken();
+	void StartHolding();
+	void CircleTarget();
+
+	void EnterAnimSharing();
+	void LeaveAnimSharing();
+
 	void    MoveToTarget(AActor* Target);
 	AActor* ChoosePatrolTarget();
 	void    SpawnDefaultWeapon();
+	void    EquipDefaultWeapon();
+	void    ReleaseWeapon();
+
+	void EnableSensing();
+	void DisableSensing();
 
 
 	UFUNCTION()
 	void PawnSeen(APawn* Pawn); // Callback for OnPawnSeen in UPawnSensingComponent
 
+	UFUNCTION()
+	void OnRep_EnemyState();
 
-	UPROPERTY(VisibleAnywhere)
-	UHealthBarComponent* HealthBarWidget;
+	/** Section is the attack or death section index, or the hit react direction */
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastPlayMontage(EEnemyMontage Montage, int8 Section);
+
+	UFUNCTION()
+	void OnRep_NetMovement();
 
+	/** Client: eases toward the last replicated movement, extrapolated along its velocity */
+	void SmoothNetMovement(float DeltaTime);
+
+	void OnAttributesReplicated();
+
+
+	/** Registered while a player is near, see UpdateActivation */
 	UPROPERTY(VisibleAnywhere)
 	UPawnSensingComponent* PawnSensing;
 
+	bool bActivated = false;
+
 	UPROPERTY(EditAnywhere, Category= "Combat")
-	TSubclassOf<class AWeapon> WeaponClass;
+	TSoftClassPtr<class AWeapon> WeaponClass;
+
+	/** WeaponClass was not resident yet, the weapon is spawned when it is */
+	bool bLoadingWeapon = false;
 
 	UPROPERTY(EditAnywhere, Category= "Combat")
 	double CombatRange = 500.f;
@@ -142,13 +204,65 @@ private:
 	UPROPERTY(EditAnywhere, Category="Combat")
 	float ChasingSpeed = 300.f;
 
+	/** Attack tokens of the target this archetype needs to attack */
+	UPROPERTY(EditAnywhere, Category="Combat|Attack Tokens", meta = (ClampMin = "1"))
+	int32 AttackTokenCost = 1;
+
+	/** Seconds before asking again after giving the tokens back while other enemies waited */
+	UPROPERTY(EditAnywhere, Category="Combat|Attack Tokens")
+	float AttackTokenCooldown = 1.5f;
+
+	/** Distance to the target while waiting for tokens, between AttackRange and CombatRange */
+	UPROPERTY(EditAnywhere, Category="Combat|Attack Tokens")
+	double HoldingRange = 350.f;
+
+	/** Degrees around the target per holding move */
+	UPROPERTY(EditAnywhere, Category="Combat|Attack Tokens")
+	float HoldingOrbitAngle = 40.f;
+
+	UPROPERTY(EditAnywhere, Category="Combat|Attack Tokens")
+	float HoldingTickInterval = 0.25f;
+
+	double NextAttackTokenTime = 0.0;
+	bool   bCircleClockwise = false;
+
 	UPROPERTY(EditAnywhere, Category=Combat)
 	float DeathLifeSpan = 8.f;
 
 	UPROPERTY(EditAnywhere, Category=Combat)
-	TSubclassOf<ASoul> SoulClass;
+	TSoftClassPtr<ASoul> SoulClass;
+
 
+	FTimerHandle DeathTimer;
 
 	FTimerHandle BeginPatrolTimer;
 	void         BeginPatrolling();
+
+	/** Replaces the default movement replication, quantized per grid cell */
+	UPROPERTY(ReplicatedUsing=OnRep_NetMovement)
+	FEnemyNetMovement NetMovement;
+
+	/** Client smoothing of NetMovement */
+	UPROPERTY(EditAnywhere, Category = "Replication")
+	float NetSmoothingSpeed = 10.f;
+
+	UPROPERTY(EditAnywhere, Category = "Replication")
+	float NetSnapDistance = 400.f;
+
+	UPROPERTY(EditAnywhere, Category = "Replication")
+	float MaxNetExtrapolation = 0.5f;
+
+	double NetMovementReceiveTime = 0.0;
+	double NetMovementServerTime = 0.0;
+	bool   bHasNetMovement = false;
+	uint8  NetTier = 0;
+
+public:
+	FORCEINLINE EEnemyState             GetEnemyState() const { return EnemyState; }
+	FORCEINLINE TEnumAsByte<EDeathPose> GetDeathPose() const { return DeathPose; }
+	FORCEINLINE uint8                   GetNetTier() const { return NetTier; }
+	FORCEINLINE int32                   GetAttackTokenCost() const { return AttackTokenCost; }
+
+	/** How far the smoothed pose trails a target moving at constant velocity */
+	FORCEINLINE float GetNetSmoothingDelay() const { return 1.f / FMath::Max(NetSmoothingSpeed, UE_KINDA_SMALL_NUMBER); }
 };
\ No newline at end of file
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyActivationSubsystem.generated.h"
+
+class AEnemy;
+
+/**
+ * Coarse player proximity for enemies, every Slash.Enemy.ActivationInterval: enemies within
+ * Slash.Enemy.ActivationRadius of a player create their optional parts (pawn sensing, the weapon once they
+ * aggro), idle enemies outside it drop them again. See AEnemy::UpdateActivation.
+ */
+UCLASS()
+class SLASH_API UEnemyActivationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	void RegisterEnemy(AEnemy* Enemy);
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	/** False with Slash.Enemy.LazyComponents 0: enemies create everything at BeginPlay, as before */
+	static bool AreComponentsLazy();
+
+private:
+	void UpdateActivation();
+
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+
+	float TimeSinceUpdate = 0.f;
+};
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyAnimBudgetSubsystem.generated.h"
+
+class AEnemy;
+class USkeletalMeshComponentBudgeted;
+
+/**
+ * Registers enemy meshes with the animation budget allocator and feeds it a significance
+ * based on distance to the local view and EnemyState. Budget settings are Slash.AnimBudget.* cvars.
+ */
+UCLASS()
+class SLASH_API UEnemyAnimBudgetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	void RegisterEnemy(AEnemy* Enemy);
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	/** Pushes the current Slash.AnimBudget.* values to the allocator. */
+	void ApplyBudgetSettings();
+
+private:
+	static float CalculateSignificance(USkeletalMeshComponentBudgeted* Component);
+
+	/** Location the significance falloff is measured from, cached once per frame. */
+	FVector GetViewLocation();
+
+	FVector ViewLocation = FVector::ZeroVector;
+	uint64  ViewLocationFrame = MAX_uint64;
+};
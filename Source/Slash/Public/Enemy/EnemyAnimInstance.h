@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "Characters/CharacterTypes.h"
+#include "EnemyAnimInstance.generated.h"
+
+class AEnemy;
+
+/**
+ * Copies the few values the enemy anim graphs need from AEnemy on the game thread (PreUpdate),
+ * so that everything derived from them can be computed on the worker thread.
+ */
+USTRUCT()
+struct SLASH_API FEnemyAnimInstanceProxy : public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FEnemyAnimInstanceProxy() = default;
+
+	FEnemyAnimInstanceProxy(UAnimInstance* InAnimInstance)
+		: FAnimInstanceProxy(InAnimInstance)
+	{
+	}
+
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+
+	FVector                 Velocity = FVector::ZeroVector;
+	bool                    bIsFalling = false;
+	EEnemyState             EnemyState = EEnemyState::EES_NoState;
+	TEnumAsByte<EDeathPose> DeathPose = EDeathPose::EDP_Death1;
+};
+
+/**
+ * Native base for ABP_Enemy / ABP_Paladin / ABP_Raptor / ABP_Insect.
+ * All variables are written from NativeThreadSafeUpdateAnimation, so the derived ABPs need no event graph.
+ */
+UCLASS()
+class SLASH_API UEnemyAnimInstance : public UAnimInstance
+{
+	GENERATED_BODY()
+
+public:
+	virtual void NativeInitializeAnimation() override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Enemy")
+	AEnemy* Enemy;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Movement")
+	float GroundSpeed;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Movement")
+	bool IsFalling;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	EEnemyState EnemyState;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Combat")
+	TEnumAsByte<EDeathPose> DeathPose;
+
+protected:
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &EnemyProxy; }
+	virtual void                DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
+
+private:
+	UPROPERTY(Transient)
+	FEnemyAnimInstanceProxy EnemyProxy;
+
+	friend struct FEnemyAnimInstanceProxy;
+};
@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AnimationSharingTypes.h"
+#include "EnemyAnimSharingStateProcessor.generated.h"
+
+/** Locomotion states a shared enemy can be bucketed into (speed bands). */
+UENUM(BlueprintType)
+enum class EEnemySharedAnimState : uint8
+{
+	ESAS_Idle UMETA(DisplayName = "Idle"),
+	ESAS_Walk UMETA(DisplayName = "Walk"),
+	ESAS_Jog UMETA(DisplayName = "Jog"),
+};
+
+/**
+ * Picks the shared animation state of a patrolling enemy from its ground speed.
+ * Used as the StateProcessorClass of each enemy skeleton in the animation sharing setup.
+ */
+UCLASS(Blueprintable)
+class SLASH_API UEnemyAnimSharingStateProcessor : public UAnimationSharingStateProcessor
+{
+	GENERATED_BODY()
+
+public:
+	virtual void   ProcessActorState_Implementation(int32& OutState, AActor* InActor, uint8 CurrentState, uint8 OnDemandState, bool& bShouldProcess) override;
+	virtual UEnum* GetAnimationStateEnum_Implementation() override;
+
+protected:
+	/** Below this ground speed the enemy shares the idle pose */
+	UPROPERTY(EditAnywhere, Category = AnimationSharing)
+	float WalkSpeedThreshold = 10.f;
+
+	/** At or above this ground speed the enemy shares the jog pose */
+	UPROPERTY(EditAnywhere, Category = AnimationSharing)
+	float JogSpeedThreshold = 200.f;
+};
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyAnimSharingSubsystem.generated.h"
+
+class AEnemy;
+class UAnimationSharingManager;
+class UAnimationSharingSetup;
+
+/**
+ * Moves patrolling enemies in and out of animation sharing. While shared, an enemy copies its pose from
+ * one of the leader meshes of its skeleton/state bucket instead of evaluating its own anim graph.
+ */
+UCLASS(Config = Game)
+class SLASH_API UEnemyAnimSharingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	void AddEnemy(AEnemy* Enemy);
+	void RemoveEnemy(AEnemy* Enemy);
+
+	/** Starts sharing if the enemy is in a simple locomotion state. */
+	void EnterSharing(AEnemy* Enemy);
+	void LeaveSharing(AEnemy* Enemy);
+
+	FORCEINLINE int32 GetNumSharedEnemies() const { return SharedEnemies.Num(); }
+	FORCEINLINE int32 GetNumUniqueEnemies() const { return UniqueEnemies.Num(); }
+
+	/** Poses actually evaluated: one per unshared enemy, one per leader or blend mesh that shared enemies copy */
+	FORCEINLINE int32 GetNumEvaluatedPoses() const { return UniqueEnemies.Num() + GetNumLeaderPoses(); }
+	int32             GetNumLeaderPoses() const;
+
+private:
+	UPROPERTY(Config)
+	TSoftObjectPtr<UAnimationSharingSetup> AnimationSharingSetup;
+
+	UPROPERTY(Transient)
+	UAnimationSharingManager* SharingManager;
+
+	TSet<TWeakObjectPtr<AEnemy>> SharedEnemies;
+	TSet<TWeakObjectPtr<AEnemy>> UniqueEnemies;
+};
@@ -0,0 +1,58 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyAttackDirectorSubsystem.generated.h"
+
+class AEnemy;
+
+/**
+ * Limits how many enemies attack the same target at once. Each target has Slash.AttackTokens.PerTarget tokens, an
+ * enemy needs its archetype's AttackTokenCost of them to start an attack and hands them back when the attack ends.
+ * Enemies without tokens hold at a distance (EES_Holding) and ask again later; an enemy that gives tokens back while
+ * others still wait for it waits its archetype's cooldown, so they get a turn. Server only, 0 tokens disables it.
+ */
+UCLASS()
+class SLASH_API UEnemyAttackDirectorSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	static bool IsEnabled();
+
+	/** True if Enemy holds or was just given Cost tokens for Target */
+	bool RequestToken(AEnemy* Enemy, AActor* Target, int32 Cost);
+
+	/** Returns the tokens Enemy holds, if any, and stops it waiting; true if other enemies still wait for its target */
+	bool ReleaseToken(AEnemy* Enemy);
+
+	bool  HasToken(const AEnemy* Enemy) const { return TokensByHolder.Contains(Enemy); }
+	int32 GetNumTokensUsed(const AActor* Target) const;
+	int32 GetNumHolders() const { return TokensByHolder.Num(); }
+
+private:
+	struct FTargetTokens
+	{
+		int32               Used = 0;
+		TSet<const AEnemy*> Waiting;
+	};
+
+	struct FHeldTokens
+	{
+		const AActor* Target = nullptr;
+		int32         Cost = 0;
+	};
+
+	void StopWaiting(const AEnemy* Enemy);
+	void RemoveIfUnused(const AActor* Target);
+
+	TMap<const AActor*, FTargetTokens> TokensByTarget;
+	TMap<const AEnemy*, FHeldTokens>   TokensByHolder;
+	TMap<const AEnemy*, const AActor*> TargetByWaiter;
+};
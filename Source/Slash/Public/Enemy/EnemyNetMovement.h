@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EnemyNetMovement.generated.h"
+
+/**
+ * Enemy movement as sent to clients, in place of FRepMovement: the grid cell (packed), the position inside
+ * the cell at 1/16 cm, Z at 0.5 cm, yaw in a byte and the planar velocity in whole cm/s (packed), usually
+ * 10-12 bytes. Values are quantized by Make() on the server so unchanged enemies are never marked dirty.
+ */
+USTRUCT()
+struct FEnemyNetMovement
+{
+	GENERATED_BODY()
+
+	static constexpr float CellSize = 4096.f;
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	float Yaw = 0.f;
+
+	UPROPERTY()
+	FVector2D Velocity = FVector2D::ZeroVector;
+
+	static FEnemyNetMovement Make(const FVector& InLocation, float InYaw, const FVector& InVelocity);
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	/** Bytes NetSerialize writes for this value, computed without serializing */
+	int32 GetNetSize() const;
+
+	bool operator==(const FEnemyNetMovement& Other) const
+	{
+		return Location == Other.Location && Yaw == Other.Yaw && Velocity == Other.Velocity;
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FEnemyNetMovement> : TStructOpsTypeTraitsBase2<FEnemyNetMovement>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemySpatialIndexSubsystem.generated.h"
+
+class AEnemy;
+
+/**
+ * Live enemies in a 2D grid (Slash.Enemy.IndexCellSize) for "which enemies are around here" queries, e.g. lock-on,
+ * instead of iterating every actor. Enemies move, so cells are brought up to date every Slash.Enemy.IndexInterval;
+ * queries test the current location, an enemy that left its cell since is found as long as the query reaches it.
+ */
+UCLASS()
+class SLASH_API UEnemySpatialIndexSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	void RegisterEnemy(AEnemy* Enemy);
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	/** Moves enemies that changed cell; returns how many did */
+	int32 Refresh();
+
+	/** Enemies within Radius of Origin on the horizontal plane, dead ones excluded; returns the number tested */
+	int32 GatherInRadius(const FVector& Origin, float Radius, TArray<AEnemy*>& OutEnemies) const;
+
+	FORCEINLINE int32 GetNumEnemies() const { return CellByEnemy.Num(); }
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+
+	TMap<FIntPoint, TArray<AEnemy*>> Cells;
+	TMap<AEnemy*, FIntPoint>         CellByEnemy;
+
+	float TimeSinceRefresh = 0.f;
+};
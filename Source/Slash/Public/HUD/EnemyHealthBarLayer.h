@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "EnemyHealthBarLayer.generated.h"
+
+class UCanvasPanel;
+class UCanvasPanelSlot;
+class UHealthBar;
+class UProgressBar;
+
+/**
+ * Health bars of the damaged enemies, drawn in screen space by one widget of ASlashHUD. A fixed pool of bars
+ * (Slash.HealthBars.PoolSize) is bound every frame to the closest shown enemies on screen, after projecting
+ * all of them with a single view projection matrix.
+ */
+UCLASS()
+class SLASH_API UEnemyHealthBarLayer : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** The local player's layer, null on dedicated servers and headless clients */
+	static UEnemyHealthBarLayer* Get(const UObject* WorldContextObject);
+
+	void ShowEnemy(AActor* Enemy, float Percent);
+	void HideEnemy(AActor* Enemy);
+
+	/** Only kept while the enemy is shown */
+	void SetEnemyPercent(AActor* Enemy, float Percent);
+
+	/** Widget the bars are made from, a plain progress bar when not set */
+	void SetBarClass(TSubclassOf<UHealthBar> InBarClass);
+
+	FORCEINLINE int32 GetNumShown() const { return Shown.Num(); }
+	FORCEINLINE int32 GetNumBound() const { return NumBound; }
+	FORCEINLINE int32 GetPoolSize() const { return Bars.Num(); }
+
+protected:
+	virtual void NativeOnInitialized() override;
+	virtual void NativeConstruct() override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+
+private:
+	struct FBar
+	{
+		UWidget*               Widget = nullptr;
+		UProgressBar*          Progress = nullptr;
+		UCanvasPanelSlot*      Slot = nullptr;
+		TWeakObjectPtr<AActor> Enemy;
+		float                  Percent = -1.f;
+	};
+
+	void BuildPool();
+	void BindBars();
+
+	UPROPERTY()
+	UCanvasPanel* Canvas;
+
+	UPROPERTY()
+	TSubclassOf<UHealthBar> BarClass;
+
+	TArray<FBar>                        Bars;
+	TMap<TWeakObjectPtr<AActor>, float> Shown;
+	int32                               NumBound = 0;
+};
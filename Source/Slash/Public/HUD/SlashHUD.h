@@ -6,6 +6,8 @@
 #include "GameFramework/HUD.h"
 #include "SlashHUD.generated.h"
 
+class UEnemyHealthBarLayer;
+class UHealthBar;
 class USlashOverlay;
 
 UCLASS()
@@ -23,6 +25,14 @@ private:
 	UPROPERTY()
 	USlashOverlay* SlashOverlay;
 
+	/** Bar widget of UEnemyHealthBarLayer */
+	UPROPERTY(EditDefaultsOnly, Category = Slash)
+	TSubclassOf<UHealthBar> EnemyHealthBarClass;
+
+	UPROPERTY()
+	UEnemyHealthBarLayer* EnemyHealthBars;
+
 public:
-	FORCEINLINE USlashOverlay* GetSlashOverlay() const { return SlashOverlay; }
+	FORCEINLINE USlashOverlay*        GetSlashOverlay() const { return SlashOverlay; }
+	FORCEINLINE UEnemyHealthBarLayer* GetEnemyHealthBars() const { return EnemyHealthBars; }
 };
\ No newline at end of file
@@ -23,6 +23,6 @@ class SLASH_API IPickupInterface
 	// Add interface functions to this class. This is the class that will be inherited to implement this interface.
 public:
 	virtual void SetOverlappingItem(class AItem* Item);
-	virtual void AddSouls(class ASoul* Soul);
-	virtual void AddGold(class ATreasure* AmountOfGold);
+	virtual void AddSouls(int32 NumberOfSouls);
+	virtual void AddGold(int32 AmountOfGold);
 };
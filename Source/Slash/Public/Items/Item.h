@@ -22,9 +22,36 @@ class SLASH_API AItem : public AActor
 public:
 	AItem();
 	virtual void Tick(float DeltaTime) override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Hides a placed pickup that was collected, or shows it again when a checkpoint is restored. */
+	void SetItemActive(bool bActive);
+
+	/** Client: drops a predicted SetItemActive, back to what the server last replicated */
+	void RevertItemActive() { SetItemActive(bItemActive); }
+
+	/** UPickupSubsystem: makes this actor the (pooled) visual of dropped pickup Id, 0 when returned to the pool */
+	virtual void InitPickup(uint32 Id, int32 Value);
+	virtual void PlayPickupEffects();
+
+	/** UPickupProximitySubsystem: Player's capsule came within the sphere */
+	void NotifyPlayerTouch(AActor* Player);
+
+	/** Collected on touch, instead of becoming the player's overlapping item */
+	virtual bool IsAutoCollected() const { return false; }
+
+	float GetContactRadius() const;
+
+	FORCEINLINE bool       IsItemActive() const { return !IsHidden(); }
+	FORCEINLINE EItemState GetItemState() const { return ItemState; }
+	FORCEINLINE uint32     GetPickupId() const { return PickupId; }
+	FORCEINLINE bool       IsPickupVisual() const { return bPickupVisual; }
 
 protected:
+	virtual void PreRegisterAllComponents() override;
+	virtual void PostInitializeComponents() override;
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Sine Parameters")
 	float Amplitude = 0.25f;
@@ -44,17 +71,24 @@ protected:
 	UFUNCTION()
 	virtual void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
-	UFUNCTION()
-	virtual void OnSphereEndOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-
 	virtual void SpawnPickupSystem();
 	virtual void SpawnPickupSound();
 
+	/** Records a placed pickup as collected, so it stays gone when its cell streams back in */
+	void MarkConsumed();
+
+	/** Marks the pickup consumed, then deactivates it if it was placed in the level, destroys it otherwise */
+	void Consume();
+
+	/** For the visual of a dropped pickup, hands the overlap to UPickupSubsystem and returns true */
+	bool TryCollectAsPickup(AActor* Collector);
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	UStaticMeshComponent* ItemMesh;
 
 	EItemState ItemState = EItemState::EIS_Hovering;
 	
+	/** Contact radius for UPickupProximitySubsystem, does not generate overlaps */
 	UPROPERTY(VisibleAnywhere)
 	USphereComponent* Sphere;
 
@@ -70,6 +104,17 @@ private:
 
 	UPROPERTY(EditAnywhere)
 	class UNiagaraSystem* PickupEffect;
+
+	UFUNCTION()
+	void OnRep_ItemActive();
+
+	/** Server: collected placed pickups, so other clients and late joiners hide them too */
+	UPROPERTY(ReplicatedUsing=OnRep_ItemActive)
+	bool bItemActive = true;
+
+	uint32 PickupId = 0;
+	bool   bPickupVisual = false;
+	bool   bSkippedOnLoad = false;
 };
 
 template <typename T>
@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "PickupCell.generated.h"
+
+class AItem;
+class APickupCell;
+
+/** One dropped soul or treasure. Rendered on clients by a pooled AItem, see UPickupSubsystem. */
+USTRUCT()
+struct FPickupEntry : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint32 Id = 0;
+
+	/** Index into the owning cell's class table */
+	UPROPERTY()
+	uint8 ClassIndex = 0;
+
+	UPROPERTY()
+	FVector_NetQuantize Location = FVector::ZeroVector;
+
+	/** Souls or gold granted on collection */
+	UPROPERTY()
+	int32 Value = 0;
+
+	void PostReplicatedAdd(const struct FPickupArray& InArraySerializer);
+	void PreReplicatedRemove(const struct FPickupArray& InArraySerializer);
+};
+
+USTRUCT()
+struct FPickupArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FPickupEntry> Entries;
+
+	UPROPERTY(NotReplicated)
+	APickupCell* Cell = nullptr;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FPickupEntry, FPickupArray>(Entries, DeltaParms, *this);
+	}
+};
+
+template <>
+struct TStructOpsTypeTraits<FPickupArray> : TStructOpsTypeTraitsBase2<FPickupArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+ * Replicates every dropped pickup inside one square of the world as a delta serialized list, so a fight
+ * that drops dozens of souls costs one actor channel per cell instead of one per soul.
+ * Spawned and filled by UPickupSubsystem on the server.
+ */
+UCLASS(NotPlaceable)
+class SLASH_API APickupCell : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	APickupCell();
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	/** Server */
+	void AddEntry(uint32 Id, TSubclassOf<AItem> Class, const FVector& Location, int32 Value);
+	bool RemoveEntry(uint32 Id, FPickupEntry& OutEntry);
+	void RemoveAllEntries();
+
+	const FPickupEntry* FindEntry(uint32 Id) const;
+	UClass*             GetEntryClass(const FPickupEntry& Entry) const;
+
+	FORCEINLINE const TArray<FPickupEntry>& GetEntries() const { return Pickups.Entries; }
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UFUNCTION()
+	void OnRep_Classes();
+
+	/** Pickup classes seen in this cell, entries refer to them by index */
+	UPROPERTY(ReplicatedUsing=OnRep_Classes)
+	TArray<TSubclassOf<AItem>> Classes;
+
+	UPROPERTY(Replicated)
+	FPickupArray Pickups;
+};
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PickupProximitySubsystem.generated.h"
+
+class AItem;
+class APawn;
+
+/**
+ * Replaces the per item sphere overlaps: items are indexed in a 2D grid (Slash.Pickups.ProximityCellSize) and
+ * every frame each player runs one small query around its capsule. Auto collected items (souls, treasure) are
+ * touched once on contact, and the nearest interactable in reach becomes the player's overlapping item, kept
+ * until another one is closer by Slash.Pickups.FocusHysteresis or it goes out of reach.
+ * The server runs it for every player, clients for their local player only.
+ */
+UCLASS()
+class SLASH_API UPickupProximitySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	void RegisterItem(AItem* Item);
+	void UnregisterItem(AItem* Item);
+
+	/** The item was moved, e.g. a pooled pickup visual reused at another location */
+	void UpdateItem(AItem* Item);
+
+	/** Runs the query for every player; returns the number of items tested */
+	int32 UpdatePlayers();
+
+	/** Runs the query for these players, forgetting any other; returns the number of items tested */
+	int32 UpdatePlayers(TConstArrayView<APawn*> Pawns);
+
+	/** The interactable Player last got as its overlapping item, null when none is in reach */
+	AItem* GetFocus(const APawn* Player) const;
+
+	FORCEINLINE int32 GetNumItems() const { return CellByItem.Num(); }
+
+private:
+	struct FPlayerProximity
+	{
+		TWeakObjectPtr<APawn>        Player;
+		TArray<TWeakObjectPtr<AItem>> Touching;
+		TWeakObjectPtr<AItem>        Focus;
+	};
+
+	int32   UpdatePlayer(APawn* Player, FPlayerProximity& State);
+	FIntPoint GetCell(const FVector& Location) const;
+
+	TMap<FIntPoint, TArray<AItem*>> Cells;
+	TMap<AItem*, FIntPoint>         CellByItem;
+	TArray<FPlayerProximity>        Players;
+
+	/** Largest sphere radius registered, widens the query so no item in reach is missed */
+	float MaxItemRadius = 0.f;
+};
@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PickupSubsystem.generated.h"
+
+class AItem;
+class APickupCell;
+struct FPickupEntry;
+
+/**
+ * Dropped souls and treasure. The server keeps them as entries of APickupCell (one replicated actor per
+ * Slash.Pickups.CellSize square), every machine that renders shows them with pooled, non replicated AItem
+ * actors, and collection goes to the server as the entry id (ASlashCharacter::ServerCollectPickup).
+ * Items placed in the level stay regular actors.
+ */
+UCLASS()
+class SLASH_API UPickupSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	/** </UWorldSubsystem> */
+
+	/** Server: drops a pickup worth Value (souls or gold, by Class) at Location. */
+	void SpawnPickup(TSubclassOf<AItem> Class, const FVector& Location, int32 Value);
+
+	/** A visual was touched by Collector; only the locally controlled player's touch counts. */
+	void RequestCollect(AItem* Visual, AActor* Collector);
+
+	/** Server: grants pickup Id to Collector and removes it, if Collector is close enough to it. */
+	bool Collect(uint32 Id, AActor* Collector);
+
+	/** Server: removes every dropped pickup, e.g. when a checkpoint is restored. */
+	void RemoveAllPickups();
+
+	/** APickupCell, locally on the server and through replication on clients */
+	void OnEntryAdded(APickupCell* Cell, const FPickupEntry& Entry);
+	void OnEntryRemoved(const FPickupEntry& Entry, bool bCollected);
+
+	/** Center to corner distance of a pickup cell */
+	static float GetCellRadius();
+
+	int32             GetNumPickups() const;
+	FORCEINLINE int32 GetNumCells() const { return Cells.Num(); }
+	FORCEINLINE int32 GetNumVisuals() const { return Visuals.Num(); }
+
+private:
+	APickupCell* FindOrAddCell(const FVector& Location);
+	AItem*       AcquireVisual(UClass* Class, const FVector& Location);
+	void         ReleaseVisual(AItem* Visual);
+	bool         ShouldShowVisuals() const;
+
+	/** Server cells by grid coordinate */
+	UPROPERTY()
+	TMap<FIntPoint, APickupCell*> Cells;
+
+	/** Server: cell holding each live entry */
+	TMap<uint32, FIntPoint> CellById;
+
+	UPROPERTY()
+	TMap<uint32, AItem*> Visuals;
+
+	/** Hidden visuals by class, reused by the next entry of the same class */
+	TMap<UClass*, TArray<AItem*>> FreeVisuals;
+
+	UPROPERTY()
+	TArray<AItem*> PooledVisuals;
+
+	/** Client: ids already sent to the server */
+	TSet<uint32> PendingCollects;
+
+	uint32 LastPickupId = 0;
+};
@@ -17,6 +17,8 @@ class SLASH_API ASoul : public AItem
 
 public:
 	virtual void Tick(float DeltaTime) override;
+	virtual void InitPickup(uint32 Id, int32 Value) override;
+	virtual bool IsAutoCollected() const override { return true; }
 
 protected:
 	virtual void BeginPlay() override;
@@ -24,6 +26,8 @@ protected:
 	
 
 private:
+	void UpdateDesiredZ();
+
 	UPROPERTY(EditAnywhere, Category = "Soul Properties")
 	int32 Souls;
 
@@ -14,6 +14,11 @@ class SLASH_API ATreasure : public AItem
 {
 	GENERATED_BODY()
 
+public:
+	virtual void InitPickup(uint32 Id, int32 Value) override;
+	virtual void PlayPickupEffects() override;
+	virtual bool IsAutoCollected() const override { return true; }
+
 protected:
 	virtual void OnSphereOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Items/Item.h"
+#include "Components/SlashAttributeSet.h"
+#include "Components/StatusEffectSubsystem.h"
 #include "Weapon.generated.h"
 
 class UBoxComponent;
@@ -22,14 +24,22 @@ public:
 	void PlayEquipSound();
 	void DisableSphereCollision();
 	void DeactivateEmbers();
-	AWeapon* Equip(USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator);
-	void ExecuteGetHit(FHitResult& BoxHit);
+	/** Spawns the equipped instance; bConsume = false leaves retiring this pickup to the caller */
+	AWeapon* Equip(USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator, bool bConsume = true);
+	/** Spawns a local, non-replicated instance of WeaponClass attached to InSocketName and applies its modifiers to NewOwner */
+	static AWeapon* SpawnEquipped(UClass* WeaponClass, USceneComponent* InParent, FName InSocketName, AActor* NewOwner, APawn* NewInstigator);
+	/** Damage, hit reaction and fields for a hit that was traced locally or validated by the server */
+	void ApplyHit(AActor* HitActor, const FVector& ImpactPoint);
 	bool ActorIsSameType(AActor* OtherActor);
 
+	/** Box traces run by all weapons so far, for benchmarks */
+	static uint32 GetNumBoxTraces();
+
 	TArray<AActor*> IgnoreActors;
 	
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	UFUNCTION()
 	void OnBoxOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
@@ -44,11 +54,8 @@ private:
 	UPROPERTY(EditAnywhere, Category="Weapon Properties")
 	FVector BoxTraceExtent = FVector(5.f);
 
-	UPROPERTY(EditAnywhere, Category="Weapon Properties")
-	bool bShowBoxDebug = false;
-	
 	UPROPERTY(EditAnywhere, Category="weapon properties")
-	USoundBase* EquipSound;
+	TSoftObjectPtr<USoundBase> EquipSound;
 
 	UPROPERTY(EditAnywhere, Category="weapon properties")
 	UBoxComponent* WeaponBox;
@@ -63,6 +70,17 @@ private:
 	UPROPERTY(EditAnywhere, Category="weapon properties")
 	float Damage = 20.f;
 
+	/** Applied to the owner's attributes while the weapon is equipped */
+	UPROPERTY(EditAnywhere, Category="weapon properties")
+	TArray<FSlashAttributeModifierSpec> AttributeModifiers;
+
+	/** Applied to characters this weapon hits, e.g. bleed */
+	UPROPERTY(EditAnywhere, Category="weapon properties")
+	TArray<FStatusEffectSpec> HitEffects;
+
 public:
 	FORCEINLINE UBoxComponent* GetWeaponBox() const { return WeaponBox; }
+	FORCEINLINE float          GetTraceRadius() const { return BoxTraceExtent.GetMax(); }
+
+	FORCEINLINE const TArray<FSlashAttributeModifierSpec>& GetAttributeModifiers() const { return AttributeModifiers; }
 };
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SlashEnemyNetSubsystem.generated.h"
+
+class AEnemy;
+struct FEnemyNetMovement;
+
+/**
+ * Server side distance tiers for enemy replication: every Slash.EnemyNet.TierInterval each enemy gets a tier
+ * from its distance to the closest player (near / mid / far), which scales the update rate picked from its
+ * EEnemyState (USlashReplicationGraph::UpdateEnemyFrequency). Also counts the FEnemyNetMovement bytes sent.
+ */
+UCLASS()
+class SLASH_API USlashEnemyNetSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual bool    IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	void RegisterEnemy(AEnemy* Enemy);
+	void UnregisterEnemy(AEnemy* Enemy);
+
+	/** An enemy marked its movement dirty; counted once at its serialized size, not per connection */
+	void NotifyMovementSent(const FEnemyNetMovement& Movement);
+
+	/** 0 near, 1 mid, 2 far, from the distance to the closest player; far when there are no players */
+	static uint8 SelectTier(const FVector& Location, TConstArrayView<FVector> PlayerLocations);
+
+private:
+	void UpdateTiers();
+	void Report();
+
+	UPROPERTY()
+	TArray<AEnemy*> Enemies;
+
+	int32  NumPerTier[3] = {};
+	int64  MovementBytes = 0;
+	int32  NumMovementUpdates = 0;
+	double TierSeconds = 0.0;
+	float  TimeSinceTiers = 0.f;
+	float  TimeSinceReport = 0.f;
+};
@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SlashNetStatsSubsystem.generated.h"
+
+/**
+ * Server side network load: bandwidth, connected clients and game thread busy time per frame, as CSV
+ * stats (category SlashNet) and as a periodic log line (Slash.Net.ReportInterval) for headless runs.
+ * With -SlashLoadReport every interval is also kept and written to Saved/LoadTest as CSV when the world
+ * ends, or after -SlashLoadTestSeconds=N when the server then exits (see Scripts/RunLoadTest.ps1).
+ */
+UCLASS()
+class SLASH_API USlashNetStatsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual bool    IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	/** Averages since the last report */
+	FORCEINLINE double GetAverageBusyMs() const { return NumFrames > 0 ? TotalBusyMs / NumFrames : 0.0; }
+	FORCEINLINE double GetMaxBusyMs() const { return MaxBusyMs; }
+
+private:
+	void Report();
+	void WriteLoadReport();
+
+	double TotalBusyMs = 0.0;
+	double MaxBusyMs = 0.0;
+	int32  NumFrames = 0;
+	float  TimeSinceReport = 0.f;
+
+	// Load test run, one CSV row per report
+	TArray<FString> LoadReportRows;
+	bool            bRecordLoadReport = false;
+	double          LoadTestSeconds = 0.0;
+	double          RunSeconds = 0.0;
+	double          PeakBusyMs = 0.0;
+	double          PeakMemoryMB = 0.0;
+	int32           PeakClients = 0;
+};
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ReplicationGraph.h"
+#include "Characters/CharacterTypes.h"
+#include "SlashReplicationGraph.generated.h"
+
+class AEnemy;
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_GridSpatialization2D;
+
+enum class ESlashClassRepNodeMapping : uint8
+{
+	NotRouted,              // Owner-only actors, gathered by the per connection node
+	RelevantAllConnections, // Game state, player states, world settings
+	Spatialize_Static,      // Replicated, never moves
+	Spatialize_Dynamic,     // Enemies and player pawns
+	Spatialize_Dormancy,    // Breakables and pickups, dynamic only while awake
+};
+
+/**
+ * Replication graph for the open world: enemies, pawns, breakables, pickups and pickup cells go through a
+ * 2D spatial grid (breakables and placed pickups as dormant actors), game and player states are relevant to everyone,
+ * and each connection always gets its own controller and view target.
+ *
+ * Enemies are replicated at a rate picked from their EEnemyState and distance tier, see UpdateEnemyFrequency.
+ */
+UCLASS(Transient, Config=Engine)
+class SLASH_API USlashReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+
+public:
+	/** <UReplicationGraph> */
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* ConnectionManager) override;
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+	/** </UReplicationGraph> */
+
+	/** Applies the update frequency of Enemy's current state and tier, with or without a replication graph. */
+	static void UpdateEnemyFrequency(AEnemy* Enemy);
+
+	UPROPERTY(Config)
+	float GridCellSize = 10000.f;
+
+	/** Most negative world coordinates expected, so grid cells start at zero */
+	UPROPERTY(Config)
+	FVector2D SpatialBias = FVector2D(-200000.f, -200000.f);
+
+	UPROPERTY(Config)
+	float EnemyCullDistance = 15000.f;
+
+	UPROPERTY(Config)
+	float PickupCullDistance = 8000.f;
+
+	/** Updates per second by enemy state */
+	UPROPERTY(Config)
+	float EnemyPatrolFrequency = 5.f;
+
+	UPROPERTY(Config)
+	float EnemyCombatFrequency = 30.f;
+
+	UPROPERTY(Config)
+	float EnemyDeadFrequency = 1.f;
+
+	/** Rate multipliers of enemies in the mid and far distance tiers, see USlashEnemyNetSubsystem */
+	UPROPERTY(Config)
+	float EnemyMidTierScale = 0.5f;
+
+	UPROPERTY(Config)
+	float EnemyFarTierScale = 0.2f;
+
+	/** Updates per second of awake breakables and pickups (they are dormant most of the time) */
+	UPROPERTY(Config)
+	float PickupFrequency = 2.f;
+
+	/** Updates per second of the cells holding dropped pickups, see APickupCell */
+	UPROPERTY(Config)
+	float PickupCellFrequency = 10.f;
+
+private:
+	ESlashClassRepNodeMapping GetMappingPolicy(const UClass* Class) const;
+	float                     GetEnemyFrequency(EEnemyState State) const;
+
+	UPROPERTY()
+	UReplicationGraphNode_GridSpatialization2D* GridNode;
+
+	UPROPERTY()
+	UReplicationGraphNode_ActorList* AlwaysRelevantNode;
+
+	TClassMap<ESlashClassRepNodeMapping> ClassRepNodePolicies;
+};
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SlashRewindSubsystem.generated.h"
+
+class ABaseCharacter;
+
+/**
+ * Server side lag compensation for melee hits claimed by clients. Every tick the capsule of each
+ * registered character is recorded into a fixed-size ring (struct of arrays, one row of NumFrames
+ * entries per character). A claimed hit is checked against the capsule interpolated at the client's
+ * timestamp with an analytic segment vs capsule test, so validating costs O(NumFrames) at worst and
+ * never touches the physics scene. Claims are rate limited per attacker.
+ */
+UCLASS()
+class SLASH_API USlashRewindSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 NumFrames = 64;
+
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	void RegisterCharacter(ABaseCharacter* Character);
+	void UnregisterCharacter(ABaseCharacter* Character);
+
+	/**
+	 * True if a trace of TraceRadius from TraceStart to TraceEnd, done by Attacker at server time ClientTime,
+	 * touches Target where it was at that time. Targets that are not registered are checked where they are now.
+	 */
+	bool ValidateHit(const AActor* Attacker, const AActor* Target, const FVector& TraceStart, const FVector& TraceEnd, float TraceRadius, double ClientTime);
+
+	/** Capsule center of a registered character at Time, interpolated between the two recorded frames around it. */
+	bool GetHistoricalLocation(const AActor* Target, double Time, FVector& OutCenter) const;
+
+	static bool SegmentHitsCapsule(const FVector& Start, const FVector& End, float SegmentRadius, const FVector& CapsuleCenter, float CapsuleRadius, float CapsuleHalfHeight);
+
+	FORCEINLINE int32 GetNumRegistered() const { return SlotByCharacter.Num(); }
+
+private:
+	void RecordFrame();
+
+	FORCEINLINE int32 GetIndex(int32 Slot, int32 Frame) const { return Slot * NumFrames + Frame; }
+
+	/** Per frame */
+	double FrameTimes[NumFrames] = {};
+	int32  NewestFrame = INDEX_NONE;
+	int32  NumRecordedFrames = 0;
+
+	/** Per slot */
+	TArray<TWeakObjectPtr<ABaseCharacter>> Characters;
+	TArray<float>                          Radii;
+	TArray<float>                          HalfHeights;
+	TArray<int32>                          FreeSlots;
+	TMap<TObjectKey<AActor>, int32>        SlotByCharacter;
+
+	/** Per slot and frame, row major by slot */
+	TArray<FVector> Centers;
+
+	TMap<TObjectKey<AActor>, int32> ClaimsThisSecond;
+	float                           TimeSinceClaimReset = 0.f;
+};
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SlashAssetPreloadSubsystem.generated.h"
+
+struct FStreamableHandle;
+
+/**
+ * Streams the soft referenced assets of actor archetypes (enemy, breakable, weapon and pickup classes).
+ * The bundle of a class is every soft reference on its CDO, plus the bundles of the classes it references.
+ * Actors add themselves as users when their World Partition cell loads, which is well before the player
+ * reaches them, and the bundle is released when the last actor of the class is gone.
+ * Assets that are not resident yet fall back per use: cosmetics are skipped once while they stream in,
+ * montages load synchronously and classes are spawned when their load completes. Both count as misses in stat Slash.
+ */
+UCLASS()
+class SLASH_API USlashAssetPreloadSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	/** </UWorldSubsystem> */
+
+	/** Actor's class bundle stays resident while it has users */
+	void AddUser(const AActor* Actor);
+	void RemoveUser(const AActor* Actor);
+
+	/** Logs every archetype with its users, assets and load time */
+	void Report() const;
+
+	/** Resident asset, or null after requesting it; for cosmetics that can be skipped once */
+	template <typename T>
+	static T* GetIfResident(const TSoftObjectPtr<T>& Asset);
+
+	/** Resident asset, or a synchronous load; for assets gameplay waits on, e.g. montages ending in notifies */
+	template <typename T>
+	static T* GetOrLoad(const TSoftObjectPtr<T>& Asset);
+
+	/** Calls OnLoaded with the class once it is resident, right away if it already is */
+	static void LoadClass(const TSoftClassPtr<UObject>& Class, TFunction<void(UClass*)>&& OnLoaded);
+
+private:
+	struct FArchetype
+	{
+		TArray<FSoftObjectPath>        Assets;
+		TArray<UClass*>                Dependencies;
+		TSharedPtr<FStreamableHandle>  Handle;
+		int32                          NumUsers = 0;
+		double                         RequestTime = 0.0;
+		double                         LoadSeconds = -1.0;
+	};
+
+	void AddClassUser(UClass* Class);
+	void RemoveClassUser(UClass* Class);
+	void OnArchetypeLoaded(UClass* Class);
+	void ReportStartup();
+
+	static void GatherAssets(UClass* Class, TArray<FSoftObjectPath>& OutAssets);
+	static void RecordMiss(const FSoftObjectPath& Asset, bool bSynchronous);
+	static void RequestMissing(const FSoftObjectPath& Asset);
+
+	TMap<UClass*, FArchetype> Archetypes;
+
+	int32  NumPending = 0;
+	bool   bStartupReported = false;
+	double InitializeTime = 0.0;
+	uint64 InitializeMemory = 0;
+};
+
+template <typename T>
+T* USlashAssetPreloadSubsystem::GetIfResident(const TSoftObjectPtr<T>& Asset)
+{
+	T* Loaded = Asset.Get();
+	if (Loaded == nullptr && !Asset.IsNull())
+	{
+		RequestMissing(Asset.ToSoftObjectPath());
+	}
+	return Loaded;
+}
+
+template <typename T>
+T* USlashAssetPreloadSubsystem::GetOrLoad(const TSoftObjectPtr<T>& Asset)
+{
+	T* Loaded = Asset.Get();
+	if (Loaded == nullptr && !Asset.IsNull())
+	{
+		RecordMiss(Asset.ToSoftObjectPath(), true);
+		Loaded = Asset.LoadSynchronous();
+	}
+	return Loaded;
+}
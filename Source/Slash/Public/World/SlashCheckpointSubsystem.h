@@ -0,0 +1,65 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SlashCheckpointSubsystem.generated.h"
+
+class ABreakableActor;
+class AEnemy;
+class AItem;
+
+/**
+ * Compact in-memory copy of the mutable gameplay state. Data holds the player record, one record per
+ * entry of Enemies (transform, attributes) and the world state bits, in that order.
+ */
+struct FSlashCheckpoint
+{
+	/** Alive at capture */
+	TArray<TWeakObjectPtr<AEnemy>> Enemies;
+
+	/** Unbroken at capture */
+	TArray<TWeakObjectPtr<ABreakableActor>> Breakables;
+
+	/** Active, not equipped, at capture */
+	TSet<TWeakObjectPtr<AItem>> Items;
+
+	TArray<uint8> Data;
+	bool          bValid = false;
+};
+
+/**
+ * Respawns the player at the last checkpoint without reloading the level: actors alive at capture are
+ * reset in place (dead enemies are parked instead of destroyed, collected pickups and broken breakables
+ * are hidden/pooled) and everything spawned since is removed.
+ *
+ * Actors of cells that streamed out since the capture are skipped; their cell restores them on load.
+ * Combat states are not resumed, enemies come back patrolling.
+ */
+UCLASS()
+class SLASH_API USlashCheckpointSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	/** </UWorldSubsystem> */
+
+	UFUNCTION(BlueprintCallable, Category="Checkpoint")
+	void CaptureCheckpoint();
+
+	UFUNCTION(BlueprintCallable, Category="Checkpoint")
+	void RestoreCheckpoint();
+
+	/** True if Enemy was alive at capture, so it has to be kept around after dying. */
+	bool CanRevive(const AEnemy* Enemy) const;
+
+	FORCEINLINE bool                    HasCheckpoint() const { return Checkpoint.bValid; }
+	FORCEINLINE const FSlashCheckpoint& GetCheckpoint() const { return Checkpoint; }
+
+private:
+	FSlashCheckpoint Checkpoint;
+};
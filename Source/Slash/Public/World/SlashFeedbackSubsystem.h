@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SlashFeedbackSubsystem.generated.h"
+
+class UAudioComponent;
+class UFXSystemComponent;
+class UNiagaraSystem;
+class UParticleSystem;
+class USoundBase;
+
+/**
+ * Hit, equip and pickup sounds and effects. Requests are queued and dispatched once per frame: requests for the
+ * same asset close to each other are merged, the ones beyond Slash.Feedback.CullDistance from the view are
+ * dropped, and the rest play, nearest first, on pooled components within the per asset and global
+ * concurrency limits. Dedicated servers drop everything.
+ */
+UCLASS()
+class SLASH_API USlashFeedbackSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+	/** </UWorldSubsystem> */
+
+	/** <FTickableGameObject> */
+	virtual void    Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	/** </FTickableGameObject> */
+
+	void PlaySound(USoundBase* Sound, const FVector& Location);
+	void SpawnParticles(UParticleSystem* Template, const FVector& Location);
+	void SpawnNiagara(UNiagaraSystem* System, const FVector& Location);
+
+	/** Plays the queued requests now instead of at the end of the frame */
+	void Dispatch();
+
+	FORCEINLINE int32 GetNumComponents() const { return NumComponentsCreated; }
+	FORCEINLINE int32 GetNumActive() const { return ActiveAudio.Num() + ActiveEffects.Num(); }
+
+private:
+	enum class EFeedbackType : uint8
+	{
+		Sound,
+		Particles,
+		Niagara
+	};
+
+	struct FFeedbackRequest
+	{
+		UObject*      Asset;
+		FVector       Location;
+		EFeedbackType Type;
+		double        DistanceSquared;
+	};
+
+	void AddRequest(UObject* Asset, const FVector& Location, EFeedbackType Type);
+	bool CanPlay(const UObject* Asset, EFeedbackType Type) const;
+	void PlayRequest(const FFeedbackRequest& Request);
+	void ReleaseFinished();
+
+	UAudioComponent*    AcquireAudio();
+	UFXSystemComponent* AcquireEffect(EFeedbackType Type);
+
+	TArray<FFeedbackRequest> Requests;
+
+	UPROPERTY()
+	TArray<UAudioComponent*> FreeAudio;
+
+	UPROPERTY()
+	TArray<UAudioComponent*> ActiveAudio;
+
+	/** Cascade and Niagara components, both kinds in each list */
+	UPROPERTY()
+	TArray<UFXSystemComponent*> FreeEffects;
+
+	UPROPERTY()
+	TArray<UFXSystemComponent*> ActiveEffects;
+
+	/** Playing instances per asset, for the per asset limit */
+	TMap<const UObject*, int32> NumPlaying;
+
+	int32 NumComponentsCreated = 0;
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "SlashSaveSubsystem.generated.h"
+
+namespace ESlashSaveVersion
+{
+	enum Type : int32
+	{
+		Initial = 1,
+
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+}
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSlashSaveFinished, const FString& /*Slot*/, bool /*bSuccess*/);
+
+/**
+ * Binary save game of the player (attributes, equipped weapon, character state) and the world state bitsets.
+ * The snapshot is taken on the game thread; compression and file I/O run on a background task, and loads
+ * are read and decompressed off the game thread before being applied in one go.
+ *
+ * File layout: Magic, Version, UncompressedSize, then the Oodle compressed payload.
+ */
+UCLASS()
+class SLASH_API USlashSaveSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <USubsystem> */
+	virtual void Deinitialize() override;
+	/** </USubsystem> */
+
+	UFUNCTION(BlueprintCallable, Category="Save")
+	void SaveGame(const FString& Slot);
+
+	UFUNCTION(BlueprintCallable, Category="Save")
+	void LoadGame(const FString& Slot);
+
+	/** Uncompressed payload of the current player and world state. */
+	bool BuildSnapshot(TArray<uint8>& OutPayload) const;
+	bool ApplySnapshot(const TArray<uint8>& Payload, int32 Version) const;
+
+	/** Thread safe. */
+	static bool    CompressPayload(const TArray<uint8>& Payload, TArray<uint8>& OutFileData);
+	static bool    DecompressPayload(const TArray<uint8>& FileData, TArray<uint8>& OutPayload, int32& OutVersion);
+	static FString GetSlotPath(const FString& Slot);
+
+	FOnSlashSaveFinished OnSaveFinished;
+	FOnSlashSaveFinished OnLoadFinished;
+
+private:
+	/** Last queued file task; every new save/load waits on it so a slot is never read while being written. */
+	UE::Tasks::FTask FileTask;
+};
@@ -0,0 +1,73 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SlashWorldStateSubsystem.generated.h"
+
+/**
+ * Consumed state of the placed breakables and pickups of one streaming cell (level).
+ * Bit i belongs to the i-th tracked actor of the cell in name order, which is stable across streaming.
+ */
+struct FSlashWorldStateCell
+{
+	TMap<FName, int32> IndexByActorName;
+	TBitArray<>        Consumed;
+	bool               bIndexed = false;
+};
+
+/**
+ * Remembers which placed breakables were broken and which placed pickups were collected, per cell, so
+ * those actors are dropped as soon as their cell streams back in instead of coming back in their original state.
+ */
+UCLASS()
+class SLASH_API USlashWorldStateSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/** <UWorldSubsystem> */
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	/** </UWorldSubsystem> */
+
+	/**
+	 * Called by tracked actors from PreRegisterAllComponents while their cell loads. True if the actor was consumed:
+	 * its components are then kept from registering and the actor should destroy itself once initialized.
+	 */
+	bool ShouldSkipOnLoad(AActor* Actor);
+
+	void MarkConsumed(const AActor* Actor);
+	bool IsConsumed(const AActor* Actor);
+
+	/** Binary form of the per-cell bitsets, for the save game. */
+	void SerializeWorldState(FArchive& Ar);
+
+	/** Destroys loaded actors that are consumed according to the current bits (e.g. after loading a save). */
+	void PurgeConsumedActors();
+
+	FORCEINLINE const TMap<FName, FSlashWorldStateCell>& GetCells() const { return Cells; }
+
+	/** Tracked actors initialized or dropped as their cell loaded, since the world started */
+	FORCEINLINE int32 GetNumActorsLoaded() const { return NumActorsLoaded; }
+	FORCEINLINE int32 GetNumActorsSkipped() const { return NumActorsSkipped; }
+
+	static bool IsTrackedActor(const AActor* Actor);
+
+#if !UE_BUILD_SHIPPING
+	/** Replaces the synthetic "Bench_" cells with NumCells random cells, to time save games of a large world. */
+	void SetBenchmarkCells(int32 NumCells, int32 ActorsPerCell);
+#endif
+
+private:
+	/** Returns the cell of Actor's level, building the actor index of that level on first use. */
+	FSlashWorldStateCell* FindOrBuildCell(const AActor* Actor);
+	int32                 GetActorIndex(const AActor* Actor, FSlashWorldStateCell*& OutCell);
+
+	static FName GetCellName(const ULevel* Level);
+
+	TMap<FName, FSlashWorldStateCell> Cells;
+
+	int32 NumActorsLoaded = 0;
+	int32 NumActorsSkipped = 0;
+};
@@ -4,3 +4,5 @@
 
 #include "CoreMinimal.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogSlash, Log, All);
+DECLARE_STATS_GROUP(TEXT("Slash"), STATGROUP_Slash, STATCAT_Advanced);
@@ -0,0 +1,285 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlashDebugDraw.h"
+
+#if SLASH_DEBUG_DRAW
+
+#include "DrawDebugHelpers.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DelayedAutoRegister.h"
+#include "Misc/FileHelper.h"
+#include "Slash.h"
+#include <atomic>
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Debug Primitives Recorded"), STAT_DebugPrimitivesRecorded, STATGROUP_Slash);
+
+namespace SlashDebugDraw
+{
+	static constexpr uint64 Capacity = 16384;
+	static_assert((Capacity & (Capacity - 1)) == 0, "The ring buffer wraps with a mask");
+
+	static const TCHAR* CategoryNames[] = { TEXT("General"), TEXT("Combat"), TEXT("AI"), TEXT("Pickups") };
+	static const TCHAR* ShapeNames[] = { TEXT("Sphere"), TEXT("Line"), TEXT("Point"), TEXT("Box"), TEXT("Arrow") };
+
+	static ESlashDebugCategory EnabledCategories = ESlashDebugCategory::All;
+
+	static void OnCategoriesChanged(IConsoleVariable* Variable)
+	{
+		const FString Value = Variable->GetString();
+		if (Value.Equals(TEXT("All"), ESearchCase::IgnoreCase))
+		{
+			EnabledCategories = ESlashDebugCategory::All;
+			return;
+		}
+
+		TArray<FString> Names;
+		Value.ParseIntoArray(Names, TEXT(","));
+		EnabledCategories = ESlashDebugCategory::None;
+		for (const FString& Name : Names)
+		{
+			for (int32 Index = 0; Index < UE_ARRAY_COUNT(CategoryNames); ++Index)
+			{
+				if (Name.TrimStartAndEnd().Equals(CategoryNames[Index], ESearchCase::IgnoreCase))
+				{
+					EnabledCategories |= static_cast<ESlashDebugCategory>(1 << Index);
+				}
+			}
+		}
+	}
+
+	static int32 Record = 1;
+	static FAutoConsoleVariableRef CVarRecord(TEXT("Slash.Debug.Record"), Record,
+		TEXT("Records debug primitives into the ring buffer for Slash.Debug.Dump."));
+
+	static int32 Draw = 0;
+	static FAutoConsoleVariableRef CVarDraw(TEXT("Slash.Debug.Draw"), Draw,
+		TEXT("Also draws the debug primitives in the viewport."));
+
+	static float DrawDuration = 2.f;
+	static FAutoConsoleVariableRef CVarDrawDuration(TEXT("Slash.Debug.DrawDuration"), DrawDuration,
+		TEXT("Seconds a drawn debug primitive stays on screen."));
+
+	static FString Categories = TEXT("All");
+	static FAutoConsoleVariableRef CVarCategories(TEXT("Slash.Debug.Categories"), Categories,
+		TEXT("Comma separated categories to record and draw: General, Combat, AI, Pickups, or All."),
+		FConsoleVariableDelegate::CreateStatic(&OnCategoriesChanged));
+
+	static int32 DumpOnExit = 0;
+	static FAutoConsoleVariableRef CVarDumpOnExit(TEXT("Slash.Debug.DumpOnExit"), DumpOnExit,
+		TEXT("Dumps the recorded primitives to Saved/DebugDraw when the engine exits, for headless runs."));
+
+	/** Sequence is 0 while the slot is written, then its write index + 1 */
+	struct FSlot
+	{
+		std::atomic<uint64>  Sequence{ 0 };
+		FSlashDebugPrimitive Primitive;
+	};
+
+	static FSlot               Slots[Capacity];
+	static std::atomic<uint64> WriteIndex{ 0 };
+	static std::atomic<uint64> ClearedIndex{ 0 };
+
+	static FString GetDumpPath(const FString& FileName)
+	{
+		const FString DumpDir = FPaths::ProjectSavedDir() / TEXT("DebugDraw");
+		IFileManager::Get().MakeDirectory(*DumpDir, true);
+		return DumpDir / (FileName.IsEmpty() ? FString::Printf(TEXT("SlashDebugDraw_%s.csv"), *FDateTime::Now().ToString()) : FileName);
+	}
+
+	static void DumpCommand(const TArray<FString>& Args)
+	{
+		const FString Path = GetDumpPath(Args.Num() > 0 ? Args[0] : FString());
+		const int32   NumPrimitives = FSlashDebugDraw::Dump(Path);
+		UE_LOG(LogSlash, Log, TEXT("Debug draw - %d primitives written to %s"), NumPrimitives, *Path);
+	}
+
+	static void ClearCommand()
+	{
+		FSlashDebugDraw::Clear();
+	}
+
+	static FDelayedAutoRegisterHelper GDumpOnExitRegistration(EDelayedRegisterRunPhase::EndOfEngineInit, []()
+	{
+		FCoreDelegates::OnEnginePreExit.AddLambda([]()
+		{
+			if (DumpOnExit)
+			{
+				DumpCommand(TArray<FString>());
+			}
+		});
+	});
+}
+
+static FAutoConsoleCommand GSlashDebugDumpCommand(
+	TEXT("Slash.Debug.Dump"),
+	TEXT("Slash.Debug.Dump [File] - writes the recorded debug primitives to Saved/DebugDraw/<File> as CSV"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&SlashDebugDraw::DumpCommand));
+
+static FAutoConsoleCommand GSlashDebugClearCommand(
+	TEXT("Slash.Debug.Clear"),
+	TEXT("Slash.Debug.Clear - forgets the recorded debug primitives"),
+	FConsoleCommandDelegate::CreateStatic(&SlashDebugDraw::ClearCommand));
+
+bool FSlashDebugDraw::IsEnabled(ESlashDebugCategory Category)
+{
+	return (SlashDebugDraw::Record || SlashDebugDraw::Draw) && EnumHasAnyFlags(SlashDebugDraw::EnabledCategories, Category);
+}
+
+void FSlashDebugDraw::Sphere(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Center, float Radius, const FColor& Color)
+{
+	FSlashDebugPrimitive Primitive;
+	Primitive.Shape = ESlashDebugShape::Sphere;
+	Primitive.Category = Category;
+	Primitive.A = Center;
+	Primitive.Size = Radius;
+	Primitive.Color = Color;
+	Record(WorldContext, Primitive);
+}
+
+void FSlashDebugDraw::Line(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Start, const FVector& End, const FColor& Color)
+{
+	FSlashDebugPrimitive Primitive;
+	Primitive.Shape = ESlashDebugShape::Line;
+	Primitive.Category = Category;
+	Primitive.A = Start;
+	Primitive.B = End;
+	Primitive.Color = Color;
+	Record(WorldContext, Primitive);
+}
+
+void FSlashDebugDraw::Point(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Location, float Size, const FColor& Color)
+{
+	FSlashDebugPrimitive Primitive;
+	Primitive.Shape = ESlashDebugShape::Point;
+	Primitive.Category = Category;
+	Primitive.A = Location;
+	Primitive.Size = Size;
+	Primitive.Color = Color;
+	Record(WorldContext, Primitive);
+}
+
+void FSlashDebugDraw::Box(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Center, const FVector& Extent, const FQuat& Rotation, const FColor& Color)
+{
+	FSlashDebugPrimitive Primitive;
+	Primitive.Shape = ESlashDebugShape::Box;
+	Primitive.Category = Category;
+	Primitive.A = Center;
+	Primitive.B = Extent;
+	Primitive.Rotation = Rotation;
+	Primitive.Color = Color;
+	Record(WorldContext, Primitive);
+}
+
+void FSlashDebugDraw::Arrow(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Start, const FVector& End, const FColor& Color)
+{
+	FSlashDebugPrimitive Primitive;
+	Primitive.Shape = ESlashDebugShape::Arrow;
+	Primitive.Category = Category;
+	Primitive.A = Start;
+	Primitive.B = End;
+	Primitive.Color = Color;
+	Record(WorldContext, Primitive);
+}
+
+void FSlashDebugDraw::Record(const UObject* WorldContext, FSlashDebugPrimitive& Primitive)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::ReturnNull) : nullptr;
+	Primitive.Frame = GFrameCounter;
+	Primitive.Time = World ? World->GetTimeSeconds() : 0.0;
+
+	if (SlashDebugDraw::Record)
+	{
+		const uint64           Index = SlashDebugDraw::WriteIndex.fetch_add(1, std::memory_order_relaxed);
+		SlashDebugDraw::FSlot& Slot = SlashDebugDraw::Slots[Index & (SlashDebugDraw::Capacity - 1)];
+		Slot.Sequence.store(0, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		Slot.Primitive = Primitive;
+		Slot.Sequence.store(Index + 1, std::memory_order_release);
+		INC_DWORD_STAT(STAT_DebugPrimitivesRecorded);
+	}
+
+#if ENABLE_DRAW_DEBUG
+	// DrawDebug only works on the game thread and with a renderer
+	if (!SlashDebugDraw::Draw || World == nullptr || !IsInGameThread())
+		return;
+
+	const float Duration = SlashDebugDraw::DrawDuration;
+	switch (Primitive.Shape)
+	{
+	case ESlashDebugShape::Sphere:
+		DrawDebugSphere(World, Primitive.A, Primitive.Size, 12, Primitive.Color, false, Duration);
+		break;
+	case ESlashDebugShape::Line:
+		DrawDebugLine(World, Primitive.A, Primitive.B, Primitive.Color, false, Duration, 0, 1.f);
+		break;
+	case ESlashDebugShape::Point:
+		DrawDebugPoint(World, Primitive.A, Primitive.Size, Primitive.Color, false, Duration);
+		break;
+	case ESlashDebugShape::Box:
+		DrawDebugBox(World, Primitive.A, Primitive.B, Primitive.Rotation, Primitive.Color, false, Duration);
+		break;
+	case ESlashDebugShape::Arrow:
+		DrawDebugDirectionalArrow(World, Primitive.A, Primitive.B, 20.f, Primitive.Color, false, Duration, 0, 1.f);
+		break;
+	}
+#endif
+}
+
+void FSlashDebugDraw::GetRecorded(TArray<FSlashDebugPrimitive>& OutPrimitives)
+{
+	const uint64 End = SlashDebugDraw::WriteIndex.load(std::memory_order_acquire);
+	const uint64 Begin = FMath::Max(End > SlashDebugDraw::Capacity ? End - SlashDebugDraw::Capacity : 0, SlashDebugDraw::ClearedIndex.load());
+
+	OutPrimitives.Reset();
+	OutPrimitives.Reserve(static_cast<int32>(End - Begin));
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		const SlashDebugDraw::FSlot& Slot = SlashDebugDraw::Slots[Index & (SlashDebugDraw::Capacity - 1)];
+		if (Slot.Sequence.load(std::memory_order_acquire) != Index + 1)
+			continue;
+
+		const FSlashDebugPrimitive Primitive = Slot.Primitive;
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		// Skip slots a writer started on while they were copied
+		if (Slot.Sequence.load(std::memory_order_relaxed) == Index + 1)
+		{
+			OutPrimitives.Add(Primitive);
+		}
+	}
+}
+
+int32 FSlashDebugDraw::Dump(const FString& Path)
+{
+	TArray<FSlashDebugPrimitive> Primitives;
+	GetRecorded(Primitives);
+
+	TArray<FString> Rows;
+	Rows.Reserve(Primitives.Num() + 1);
+	Rows.Add(TEXT("Frame,Time,Category,Shape,AX,AY,AZ,BX,BY,BZ,QX,QY,QZ,QW,Size,Color"));
+	for (const FSlashDebugPrimitive& Primitive : Primitives)
+	{
+		const int32 CategoryIndex = FMath::FloorLog2(static_cast<uint32>(Primitive.Category));
+		Rows.Add(FString::Printf(TEXT("%llu,%.3f,%s,%s,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.4f,%.4f,%.4f,%.4f,%.1f,%s"),
+		                         Primitive.Frame, Primitive.Time, SlashDebugDraw::CategoryNames[CategoryIndex], SlashDebugDraw::ShapeNames[static_cast<int32>(Primitive.Shape)],
+		                         Primitive.A.X, Primitive.A.Y, Primitive.A.Z, Primitive.B.X, Primitive.B.Y, Primitive.B.Z,
+		                         Primitive.Rotation.X, Primitive.Rotation.Y, Primitive.Rotation.Z, Primitive.Rotation.W, Primitive.Size, *Primitive.Color.ToHex()));
+	}
+
+	if (!FFileHelper::SaveStringArrayToFile(Rows, *Path))
+	{
+		UE_LOG(LogSlash, Warning, TEXT("Debug draw - failed to write %s"), *Path);
+		return 0;
+	}
+	return Primitives.Num();
+}
+
+void FSlashDebugDraw::Clear()
+{
+	SlashDebugDraw::ClearedIndex.store(SlashDebugDraw::WriteIndex.load());
+}
+
+#endif
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Debug drawing is compiled out of Shipping, the SLASH_DEBUG_ macros expand to nothing there */
+#ifndef SLASH_DEBUG_DRAW
+#define SLASH_DEBUG_DRAW !UE_BUILD_SHIPPING
+#endif
+
+enum class ESlashDebugCategory : uint8
+{
+	None    = 0,
+	General = 1 << 0,
+	Combat  = 1 << 1,
+	AI      = 1 << 2,
+	Pickups = 1 << 3,
+	All     = General | Combat | AI | Pickups
+};
+ENUM_CLASS_FLAGS(ESlashDebugCategory);
+
+#if SLASH_DEBUG_DRAW
+
+enum class ESlashDebugShape : uint8
+{
+	Sphere,
+	Line,
+	Point,
+	Box,
+	Arrow
+};
+
+struct FSlashDebugPrimitive
+{
+	/** Center or start */
+	FVector A = FVector::ZeroVector;
+
+	/** End, or the box's extent */
+	FVector B = FVector::ZeroVector;
+
+	FQuat   Rotation = FQuat::Identity;
+	float   Size = 0.f;
+	double  Time = 0.0;
+	uint64  Frame = 0;
+	FColor  Color = FColor::Red;
+
+	ESlashDebugShape    Shape = ESlashDebugShape::Point;
+	ESlashDebugCategory Category = ESlashDebugCategory::General;
+};
+
+/**
+ * Debug primitives are recorded into a fixed size ring buffer that any thread can write without locking, so headless
+ * runs keep the last few seconds of traces and AI decisions without drawing anything. Slash.Debug.Draw also draws
+ * them in the viewport, Slash.Debug.Categories filters both, and Slash.Debug.Dump writes the buffer to a CSV file.
+ * Use the SLASH_DEBUG_ macros rather than the functions, they skip evaluating their arguments for filtered categories.
+ */
+class SLASH_API FSlashDebugDraw
+{
+public:
+	static bool IsEnabled(ESlashDebugCategory Category);
+
+	static void Sphere(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Center, float Radius, const FColor& Color);
+	static void Line(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Start, const FVector& End, const FColor& Color);
+	static void Point(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Location, float Size, const FColor& Color);
+	static void Box(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Center, const FVector& Extent, const FQuat& Rotation, const FColor& Color);
+	static void Arrow(const UObject* WorldContext, ESlashDebugCategory Category, const FVector& Start, const FVector& End, const FColor& Color);
+
+	/** Copies the recorded primitives, oldest first */
+	static void GetRecorded(TArray<FSlashDebugPrimitive>& OutPrimitives);
+
+	/** Writes the recorded primitives as CSV, returns how many */
+	static int32 Dump(const FString& Path);
+
+	static void Clear();
+
+private:
+	static void Record(const UObject* WorldContext, FSlashDebugPrimitive& Primitive);
+};
+
+#define SLASH_DEBUG_CALL(Category, Call) \
+	do \
+	{ \
+		if (FSlashDebugDraw::IsEnabled(ESlashDebugCategory::Category)) \
+		{ \
+			FSlashDebugDraw::Call; \
+		} \
+	} while (0)
+
+#define SLASH_DEBUG_SPHERE(WorldContext, Category, Center, Radius, Color)        SLASH_DEBUG_CALL(Category, Sphere(WorldContext, ESlashDebugCategory::Category, Center, Radius, Color))
+#define SLASH_DEBUG_LINE(WorldContext, Category, Start, End, Color)              SLASH_DEBUG_CALL(Category, Line(WorldContext, ESlashDebugCategory::Category, Start, End, Color))
+#define SLASH_DEBUG_POINT(WorldContext, Category, Location, Size, Color)         SLASH_DEBUG_CALL(Category, Point(WorldContext, ESlashDebugCategory::Category, Location, Size, Color))
+#define SLASH_DEBUG_BOX(WorldContext, Category, Center, Extent, Rotation, Color) SLASH_DEBUG_CALL(Category, Box(WorldContext, ESlashDebugCategory::Category, Center, Extent, Rotation, Color))
+#define SLASH_DEBUG_ARROW(WorldContext, Category, Start, End, Color)             SLASH_DEBUG_CALL(Category, Arrow(WorldContext, ESlashDebugCategory::Category, Start, End, Color))
+
+#else
+
+#define SLASH_DEBUG_SPHERE(WorldContext, Category, Center, Radius, Color)
+#define SLASH_DEBUG_LINE(WorldContext, Category, Start, End, Color)
+#define SLASH_DEBUG_POINT(WorldContext, Category, Location, Size, Color)
+#define SLASH_DEBUG_BOX(WorldContext, Category, Center, Extent, Rotation, Color)
+#define SLASH_DEBUG_ARROW(WorldContext, Category, Start, End, Color)
+
+#endif
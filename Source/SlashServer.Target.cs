@@ -0,0 +1,21 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+using UnrealBuildTool;
+using System.Collections.Generic;
+
+public class SlashServerTarget : TargetRules
+{
+	public SlashServerTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Server;
+		DefaultBuildSettings = BuildSettingsVersion.V5;
+
+		ExtraModuleNames.AddRange( new string[] { "Slash" } );
+
+		// Gameplay replication is push based (see MARK_PROPERTY_DIRTY_FROM_NAME)
+		bWithPushModel = true;
+
+		// Load test reports are read from the server log
+		bUseLoggingInShipping = true;
+	}
+}